@@ -10,6 +10,7 @@
 #include <fstream>
 
 #include "../graph_algorithms/prim.h"
+#include "../graph_algorithms/boruvka.h"
 #include "../graph_algorithms/kruskal.h"
 #include "../undirected_graph.h"
 
@@ -88,6 +89,30 @@ void runPrimAssignment() {
             << " ms" << std::endl;
   assert(mst.first == -3612829);
 
+  std::cout << "Compare with the Filter-Kruskal's algorithm!" << std::endl;
+  t0 = clock();
+
+  mst = filterKruskal(graph);
+  std::cout << "Run time: " << 1000.0*(clock() - t0)/CLOCKS_PER_SEC
+            << " ms" << std::endl;
+  assert(mst.first == -3612829);
+
+  std::cout << "Compare with the dense Prim's algorithm!" << std::endl;
+  t0 = clock();
+
+  mst = prim_dense(graph, 0);
+  std::cout << "Run time: " << 1000.0*(clock() - t0)/CLOCKS_PER_SEC
+            << " ms" << std::endl;
+  assert(mst.first == -3612829);
+
+  std::cout << "Compare with the Boruvka's algorithm!" << std::endl;
+  t0 = clock();
+
+  mst = boruvka(graph);
+  std::cout << "Run time: " << 1000.0*(clock() - t0)/CLOCKS_PER_SEC
+            << " ms" << std::endl;
+  assert(mst.first == -3612829);
+
 }
 
 #endif //GRAPH_ASSIGNMENT_MST_H
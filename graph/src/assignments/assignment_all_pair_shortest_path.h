@@ -5,6 +5,9 @@
 #ifndef GRAPH_ASSIGNMENT_ALL_PAIR_SHORTEST_PATH_H
 #define GRAPH_ASSIGNMENT_ALL_PAIR_SHORTEST_PATH_H
 
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -14,6 +17,47 @@
 #include "../graph_algorithms/johnson.h"
 
 
+//
+// Read a graph of the all-pair-shortest-path assignment
+//
+// @param file_name: data file
+// @return: a directed graph
+//
+DirectedGraph<long> readAllPairShortestPathGraph(const std::string& file_name) {
+  std::ifstream ifs(file_name, std::ifstream::in);
+  std::string line;
+  std::string number;
+
+  // read the first line
+  std::getline(ifs, line);
+  std::istringstream iss0(line);
+
+  iss0 >> number;
+  size_t vertices = std::stoull(number);
+  DirectedGraph<long> graph(vertices);
+  iss0 >> number;
+  size_t edges = std::stoull(number);
+  while (std::getline(ifs, line)) {
+    std::istringstream iss(line);
+
+    iss >> number;
+    size_t src = std::stoull(number) - 1;
+    iss >> number;
+    size_t dst = std::stoull(number) - 1;
+    iss >> number;
+    long weight = std::stol(number);
+
+    graph.connect(src, dst, weight);
+  }
+
+  ifs.close();
+  std::cout << "Finished reading data! \n";
+  std::cout << "The graph has " << vertices << " vertices and "
+            << edges << " edges." << std::endl;
+
+  return graph;
+}
+
 /**
  * In this assignment you will implement one or more algorithms for the
  * all-pairs shortest-path problem. Here are data files describing three
@@ -45,67 +89,64 @@ void runAllPairShortestPathAssignment() {
             << "\n" << std::string(80, '-')
             << std::endl;
 
-  std::ifstream ifs("../data/APSP_g3.txt", std::ifstream::in);
-  std::string line;
-  std::string number;
-
-  // read the first line
-  std::getline(ifs, line);
-  std::istringstream iss0(line);
-
-  iss0 >> number;
-  size_t vertices = std::stoull(number);
-  DirectedGraph<long> graph(vertices);
-  iss0 >> number;
-  size_t edges = std::stoull(number);
-  while (std::getline(ifs, line)) {
-    std::istringstream iss(line);
-
-    iss >> number;
-    size_t src = std::stoull(number) - 1;
-    iss >> number;
-    size_t dst = std::stoull(number) - 1;
-    iss >> number;
-    long weight = std::stol(number);
-
-    graph.connect(src, dst, weight);
+  // The first two graphs have negative cycles. The queue-based
+  // Bellman-Ford's algorithm rejects them without running V - 1 rounds.
+  for (const std::string g : {"../data/APSP_g1.txt", "../data/APSP_g2.txt"}) {
+    DirectedGraph<long> graph_nc = readAllPairShortestPathGraph(g);
+
+    clock_t t0 = clock();
+    std::deque<size_t> cycle = findNegativeCycle(graph_nc);
+    std::cout << "Found a negative cycle with " << cycle.size()
+              << " vertices using the queue-based Bellman-Ford's algorithm. "
+              << "Run time: " << 1000.0*(clock() - t0)/CLOCKS_PER_SEC
+              << " ms" << std::endl;
+    assert(!cycle.empty());
   }
 
-  ifs.close();
-  std::cout << "Finished reading data! \n";
-  std::cout << "The graph has " << vertices << " vertices and "
-            << edges << " edges." << std::endl;
+  DirectedGraph<long> graph = readAllPairShortestPathGraph("../data/APSP_g3.txt");
+  assert(findNegativeCycle(graph).empty());
 
   clock_t t0;
 
-  // Floyd-Warshall's algorithm takes more than 10 minutes
-//  std::cout << "Using Floyd-Warshall's algorithm: \n";
-//  t0 = clock();
-//  auto result_fw = floydWarshall(graph);
-//  long min_length_fw = 100000;
-//  for (const auto& v : result_fw.first) {
-//    for (const auto&vv : v) {
-//      if (vv < min_length_fw) { min_length_fw = vv; }
-//    }
-//  }
-//  std::cout << "Run time: " << 1000.0*(clock() - t0)/CLOCKS_PER_SEC
-//            << " ms" << std::endl;
-//  assert(min_length_fw == -19);
-//  std::cout << "Passed" << std::endl;
+  std::cout << "Using the blocked Floyd-Warshall's algorithm: \n";
+  auto t_fw = std::chrono::steady_clock::now();
+  ApspMatrix<long> result_fw = floydWarshallMatrix(graph);
+  long min_length_fw = result_fw.min();
+  std::cout << "Run time: " << std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - t_fw).count() << " ms" << std::endl;
+  assert(min_length_fw == -19);
+  std::cout << "Passed" << std::endl;
 
   std::cout << "Using Johnson's algorithm: \n";
   t0 = clock();
-  auto result_js = johnson(graph);
-  long min_length_js = 100000;
-  for (const auto& v : result_js.first) {
-    for (const auto&vv : v) {
-      if (vv < min_length_js) { min_length_js = vv; }
-    }
-  }
+  ApspMatrix<long> result_js = johnsonMatrix(graph, 1);
+  long min_length_js = result_js.min();
   std::cout << "Run time: " << 1000.0*(clock() - t0)/CLOCKS_PER_SEC
             << " ms" << std::endl;
   assert(min_length_js == -19);
   std::cout << "Passed" << std::endl;
+
+  // clock() measures the CPU time of all the threads, so the wall time
+  // is used to compare the multithreaded runs
+  size_t n_threads = graph_parallel::defaultThreadCount();
+  std::cout << "Using Johnson's algorithm with 1 and " << n_threads
+            << " threads (streamed rows): \n";
+  double wall_time_1 = 0;
+  for (size_t threads : {(size_t)1, n_threads}) {
+    std::vector<long> min_length_rows(graph.size());
+    auto t1 = std::chrono::steady_clock::now();
+    johnson(graph, [&min_length_rows](size_t src, const std::vector<long>& costs) {
+      min_length_rows[src] = *std::min_element(costs.begin(), costs.end());
+    }, threads);
+    double wall_time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t1).count();
+    if (threads == 1) { wall_time_1 = wall_time; }
+
+    std::cout << "Run time (" << threads << " threads): " << wall_time
+              << " ms, speedup " << wall_time_1/wall_time << std::endl;
+    assert(*std::min_element(min_length_rows.begin(), min_length_rows.end()) == -19);
+  }
+  std::cout << "Passed" << std::endl;
 }
 
 
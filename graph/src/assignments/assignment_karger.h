@@ -8,8 +8,46 @@
 #include <cassert>
 #include <sstream>
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include "../graph_algorithms/karger.h"
+#include "../graph_algorithms/stoer_wagner.h"
+
+
+//
+// Read the graph of the minimum cut assignment
+//
+// @param file_name: data file with a row of adjacent vertices for each
+//                   vertex
+// @return: an undirected graph whose edges have weight 1
+//
+inline UndirectedGraph<long> readKargerMinCutGraph(const std::string& file_name) {
+  std::ifstream ifs(file_name, std::ifstream::in);
+  std::vector<std::string> lines;
+  std::string line;
+  while ( std::getline(ifs, line) ) {
+    if (!line.empty()) { lines.push_back(line); }
+  }
+  ifs.close();
+
+  UndirectedGraph<long> graph(lines.size());
+  for (const auto& row : lines) {
+    std::istringstream iss(row);
+    std::string number;
+
+    // read the first entry in a line
+    iss >> number;
+    size_t src = std::stoull(number) - 1;
+    // read the rest entries, where each edge is listed at both ends
+    while ( iss >> number ) {
+      size_t dst = std::stoull(number) - 1;
+      graph.connect(src, dst);
+    }
+  }
+
+  return graph;
+}
 
 
 //
@@ -26,7 +64,6 @@
 //
 // @param repeated_times: how many times the random contraction will be performed
 //
-// TODO:: check the answer
 inline void runKargerAssignment(unsigned int repeated_times=1000) {
 
   std::cout << "\n" << std::string(80, '-') << "\n"
@@ -34,36 +71,29 @@ inline void runKargerAssignment(unsigned int repeated_times=1000) {
             << "\n" << std::string(80, '-')
             << std::endl;
 
-  typedef long weight_t;
-  UndirectedGraph<weight_t> graph;
+  UndirectedGraph<long> graph = readKargerMinCutGraph("../data/kargerMinCut.txt");
+  std::cout << "Finished reading data!" << std::endl;
 
-  std::string line;
-  // create an input file stream
-  std::ifstream ifs("../data/kargerMinCut.txt", std::ifstream::in);
+  assert( graph.size() == 200 );
+  assert( graph.countEdge() == 2517 );
 
   std::cout << "Run the random contract for " << repeated_times
             << " times..." << std::endl;
-  // read the file line by line and put the line into a string
-  while ( std::getline(ifs, line) ) {
-    std::istringstream iss(line);
-    std::string number;
-
-    // read the first entry in a line
-    iss >> number;
-    size_t src = std::stoull(number) - 1;
-    std::cout << src << std::endl;
-    // read the rest entries
-    while ( iss >> number ) {
-      size_t dst = std::stoull(number) - 1;
-      std::cout << dst << std::endl;
-      graph.connect(src, dst);
-    }
-  }
-  ifs.close();
-  std::cout << "Finished reading data!" << std::endl;
 
   clock_t t0 = clock();
-  assert(karger(graph, repeated_times) == 20);
+  assert(karger(graph, repeated_times, 0, 0) == 17);
+  std::cout << "Run time: "
+            << 1000.0*(clock() - t0)/CLOCKS_PER_SEC << " ms" << std::endl;
+
+  std::cout << "Compare with the Karger-Stein's algorithm!" << std::endl;
+  t0 = clock();
+  assert(kargerStein(graph, 10, 0, 0) == 17);
+  std::cout << "Run time: "
+            << 1000.0*(clock() - t0)/CLOCKS_PER_SEC << " ms" << std::endl;
+
+  std::cout << "Compare with the Stoer-Wagner's algorithm!" << std::endl;
+  t0 = clock();
+  assert(stoerWagner(graph).first == 17);
   std::cout << "Run time: "
             << 1000.0*(clock() - t0)/CLOCKS_PER_SEC << " ms" << std::endl;
   std::cout << "Passed!" << std::endl;
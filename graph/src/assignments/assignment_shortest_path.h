@@ -13,7 +13,9 @@
 #include "../directed_graph.h"
 #include "../undirected_graph.h"
 #include "../graph_algorithms/dijkstra.h"
+#include "../graph_algorithms/batch_shortest_path.h"
 #include "../graph_algorithms/bellman_ford.h"
+#include "../graph_stats.h"
 
 
 //
@@ -82,31 +84,48 @@ void runShortestPathAssignment() {
   // compare speeds of different implementations
   std::deque<unsigned long> solutions;
 
+  // the counts of each run are printed if GRAPH_ENABLE_STATS is defined
   clock_t t0;
+  SearchStats counts;
+  decltype(shortest_path) shortest_path1, shortest_path2, shortest_path3;
 
   t0 = clock();
-  auto shortest_path1 = dijkstraOriginal(graph, 0, 0);
+  counts = graph_stats::collect([&]() { shortest_path1 = dijkstraOriginal(graph, 0, 0); });
   solutions.clear();
   for (auto v : destinations) { solutions.push_back(shortest_path1.first[v]); }
   assert(solutions == expected_answer);
   std::cout << "Run time using the original implementation: "
             << 1000.0*(clock() - t0)/CLOCKS_PER_SEC << " ms" << std::endl;
+  graph_stats::report(std::cout, counts);
 
   t0 = clock();
-  auto shortest_path2 = dijkstraPriorityQueueBase(graph, 0, 0);
+  counts = graph_stats::collect([&]() { shortest_path2 = dijkstraPriorityQueueBase(graph, 0, 0); });
   solutions.clear();
   for (auto v : destinations) { solutions.push_back(shortest_path2.first[v]); }
   assert(solutions == expected_answer);
   std::cout << "Run time using the priority-queue-based implementation: "
             << 1000.0*(clock() - t0)/CLOCKS_PER_SEC << " ms" << std::endl;
+  graph_stats::report(std::cout, counts);
 
   t0 = clock();
-  auto shortest_path3 = dijkstraTreeBase(graph, 0, 0);
+  counts = graph_stats::collect([&]() { shortest_path3 = dijkstraTreeBase(graph, 0, 0); });
   solutions.clear();
   for (auto v : destinations) { solutions.push_back(shortest_path3.first[v]); }
   assert(solutions == expected_answer);
   std::cout << "Run time using the tree-based implementation: "
             << 1000.0*(clock() - t0)/CLOCKS_PER_SEC << " ms" << std::endl;
+  graph_stats::report(std::cout, counts);
+
+  // one search which stops at the farthest destination
+  std::vector<std::pair<size_t, size_t>> queries;
+  for (auto v : destinations) { queries.push_back(std::make_pair(0, v)); }
+  BatchQueryStats stats;
+  std::vector<unsigned long> shortest_path4 = dijkstraBatch(graph, queries, 1, &stats);
+  solutions.assign(shortest_path4.begin(), shortest_path4.end());
+  assert(solutions == expected_answer);
+  std::cout << "Run time using the batched implementation: "
+            << stats.search_time << " ms (" << stats.n_settled
+            << " vertices settled)" << std::endl;
 
   std::cout << "Passed!" << std::endl;
 }
@@ -0,0 +1,125 @@
+//
+// Compare the all-pair shortest path algorithms on the inputs of the
+// assignment and on generated dense graphs.
+//
+
+#ifndef GRAPH_BENCHMARK_APSP_H
+#define GRAPH_BENCHMARK_APSP_H
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark_utilities.h"
+#include "../graph_algorithms/floyd_warshall.h"
+#include "../graph_algorithms/johnson.h"
+#include "../graph_algorithms/min_plus.h"
+#include "../assignments/assignment_all_pair_shortest_path.h"
+
+
+namespace graph_benchmark {
+
+  //
+  // Generate a dense directed graph with negative weights but no
+  // negative cycle, where each ordered pair of vertices is connected
+  // with probability "density"
+  //
+  DirectedGraph<long> denseNegativeWeightedGraph(size_t n, double density,
+                                                 unsigned seed=0) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<long> weight(0, 1000);
+    std::bernoulli_distribution connected(density);
+    std::vector<long> potentials(n);
+    for (auto& p : potentials) { p = weight(generator); }
+
+    DirectedGraph<long> graph(n);
+    for (size_t src = 0; src < n; ++src) {
+      for (size_t dst = 0; dst < n; ++dst) {
+        if (src != dst && connected(generator)) {
+          graph.connect(src, dst, weight(generator) + potentials[dst] - potentials[src]);
+        }
+      }
+    }
+
+    return graph;
+  }
+
+  //
+  // Time one algorithm and print the wall time and the smallest cost
+  //
+  template <class F>
+  void reportApsp(const std::string& name, F run_apsp) {
+    long min_cost = 0;
+    bool negative_cycle = false;
+    double time = wallTime([&]() {
+      try {
+        min_cost = run_apsp();
+      } catch (const std::invalid_argument&) {
+        negative_cycle = true;
+      }
+    });
+
+    std::cout << "  " << std::left << std::setw(28) << name << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1) << time
+              << " ms    ";
+    if (negative_cycle) {
+      std::cout << "negative cycle" << std::endl;
+    } else {
+      std::cout << "min cost " << min_cost << std::endl;
+    }
+  }
+
+  void benchmarkApsp(const std::string& name, const DirectedGraph<long>& graph,
+                     size_t n_threads) {
+    std::cout << name << " (" << graph.size() << " vertices, "
+              << graph.countEdge() << " edges)" << std::endl;
+
+    reportApsp("blocked Floyd-Warshall", [&]() {
+      return floydWarshallMatrix(graph, n_threads).min(n_threads);
+    });
+    reportApsp("min-plus repeated squaring", [&]() {
+      return ApspMatrix<long>(minPlusShortestPath(graph, n_threads)).min(n_threads);
+    });
+    reportApsp("Johnson", [&]() {
+      return johnsonMatrix(graph, n_threads).min(n_threads);
+    });
+    reportApsp("Johnson (streamed rows)", [&]() {
+      std::vector<long> min_costs(graph.size());
+      johnson(graph, [&min_costs](size_t src, const std::vector<long>& costs) {
+        min_costs[src] = *std::min_element(costs.begin(), costs.end());
+      }, n_threads);
+      return *std::min_element(min_costs.begin(), min_costs.end());
+    });
+  }
+
+  //
+  // Blocked Floyd-Warshall, min-plus repeated squaring and Johnson on
+  // the assignment graphs (sparse, 1000 vertices) and on dense graphs
+  // with half of the pairs connected
+  //
+  void runAllPairShortestPathBenchmark() {
+    std::cout << "\n" << std::string(80, '-') << "\n"
+              << "All-pair shortest path benchmark"
+              << "\n" << std::string(80, '-')
+              << std::endl;
+
+    const size_t n_threads = graph_parallel::defaultThreadCount();
+    std::cout << "Threads: " << n_threads << std::endl;
+
+    for (const std::string g : {"../data/APSP_g1.txt", "../data/APSP_g2.txt",
+                                "../data/APSP_g3.txt"}) {
+      benchmarkApsp(g, readAllPairShortestPathGraph(g), n_threads);
+    }
+
+    for (size_t n : {128, 256, 512}) {
+      benchmarkApsp("dense graph", denseNegativeWeightedGraph(n, 0.5), n_threads);
+    }
+  }
+
+}  // namespace graph_benchmark
+
+#endif //GRAPH_BENCHMARK_APSP_H
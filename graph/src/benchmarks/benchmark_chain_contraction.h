@@ -0,0 +1,77 @@
+//
+// Compare the single source shortest paths on road-like graphs (sparse
+// grids whose roads have shape points) with and without the chains and
+// trees contracted.
+//
+
+#ifndef GRAPH_BENCHMARK_CHAIN_CONTRACTION_H
+#define GRAPH_BENCHMARK_CHAIN_CONTRACTION_H
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "benchmark_utilities.h"
+#include "../graph_generators.h"
+#include "../graph_algorithms/chain_contraction.h"
+#include "../graph_algorithms/dijkstra.h"
+#include "../graph_algorithms/bellman_ford.h"
+
+
+namespace graph_benchmark {
+
+  void benchmarkChainContraction(size_t side, size_t max_inner, size_t n_sources, bool bellman_ford) {
+    std::uniform_int_distribution<long> weight(1, 100);
+    auto generated = graph_generator::grid(side, side, weight, 5, 0.6);
+    graph_generator::subdivideEdges(generated, max_inner, 5);
+    DirectedGraph<long> graph = graph_generator::toDirectedGraph(generated);
+
+    std::unique_ptr<ChainContraction<long>> contraction;
+    double contract_time = wallTime([&]() { contraction.reset(new ChainContraction<long>(graph)); });
+    std::cout << side << "x" << side << " grid, up to " << max_inner << " shape points per road: "
+              << graph.size() << " vertices, " << graph.countEdge() << " edges -> core "
+              << contraction->core().size() << " vertices, " << contraction->core().countEdge()
+              << " edges (" << contraction->countChain() << " chains, "
+              << contraction->countTreeVertex() << " tree vertices)" << std::endl;
+
+    // the sources are spread over the graph, so some are on the chains
+    // and the trees
+    const size_t step = graph.size()/n_sources;
+    double original = 0;
+    double contracted = 0;
+    double original_bf = 0;
+    double contracted_bf = 0;
+    for (size_t src = 0; src < graph.size(); src += step) {
+      original += wallTime([&]() { dijkstra(graph, src); });
+      contracted += wallTime([&]() { dijkstra(*contraction, src); });
+      if (bellman_ford) {
+        original_bf += wallTime([&]() { bellmanFord(graph, src); });
+        contracted_bf += wallTime([&]() { bellmanFord(*contraction, src); });
+      }
+    }
+    const size_t n_runs = (graph.size() + step - 1)/step;
+    std::cout << std::fixed << std::setprecision(2) << "  contraction " << contract_time
+              << " ms, Dijkstra " << original/n_runs << " ms vs " << contracted/n_runs
+              << " ms (contracted, with the costs of all the vertices)" << std::endl;
+    if (bellman_ford) {
+      std::cout << "  Bellman-Ford " << original_bf/n_runs << " ms vs " << contracted_bf/n_runs
+                << " ms (contracted)" << std::endl;
+    }
+  }
+
+  void runChainContractionBenchmark() {
+    std::cout << "\n" << std::string(80, '-') << "\n"
+              << "Chain contraction benchmark"
+              << "\n" << std::string(80, '-')
+              << std::endl;
+
+    benchmarkChainContraction(60, 4, 10, true);
+    benchmarkChainContraction(400, 0, 10, false);
+    benchmarkChainContraction(400, 8, 10, false);
+  }
+
+}  // namespace graph_benchmark
+
+#endif //GRAPH_BENCHMARK_CHAIN_CONTRACTION_H
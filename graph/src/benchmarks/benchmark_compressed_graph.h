@@ -0,0 +1,134 @@
+//
+// Compare the size of the compressed graph with the linked lists and
+// CSR, and its decode and search speed with the linked lists.
+//
+
+#ifndef GRAPH_BENCHMARK_COMPRESSED_GRAPH_H
+#define GRAPH_BENCHMARK_COMPRESSED_GRAPH_H
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark_utilities.h"
+#include "../compressed_graph.h"
+#include "../graph_generators.h"
+#include "../graph_algorithms/breath_first_search.h"
+#include "../graph_algorithms/kosaraju.h"
+
+
+namespace graph_benchmark {
+
+  //
+  // Read the edges of the SCC assignment (1-based "tail head" lines), or
+  // get an empty graph if the file is missing
+  //
+  GeneratedGraph<long> readSccEdges(const std::string& path, size_t size) {
+    GeneratedGraph<long> graph {size, true, {}};
+    std::ifstream ifs(path);
+    uint64_t src, dst;
+    while (ifs >> src >> dst) {
+      if (src != dst) { graph.edges.push_back({1, (uint32_t)(src - 1), (uint32_t)(dst - 1)}); }
+    }
+    return graph;
+  }
+
+  // decode all the lists and get the speed in million edges per second
+  double decodeThroughput(const CompressedGraph& graph, bool simd) {
+    std::vector<uint32_t> neighbors;
+    // keeps the decoding from being optimized away
+    volatile uint32_t last = 0;
+    double time = wallTime([&]() {
+      for (size_t v = 0; v < graph.size(); ++v) {
+        neighbors.resize(std::max<size_t>(neighbors.size(), graph.degree(v)));
+        size_t degree = graph.decodeNeighbors(v, neighbors.data(), simd);
+        if (degree > 0) { last = neighbors[degree - 1]; }
+      }
+    });
+    return graph.countEdge()/time/1000;
+  }
+
+  void benchmarkCompressedGraph(const std::string& name, const GeneratedGraph<long>& generated) {
+    DirectedGraph<long> graph = graph_generator::toDirectedGraph(generated);
+    std::unique_ptr<CompressedGraph> compressed;
+    double build_time = wallTime([&]() {
+      compressed.reset(new CompressedGraph(generated.size, generated.edges, generated.directed));
+    });
+    const double n_edges = std::max<double>((double)compressed->countEdge(), 1);
+
+    std::cout << name << " (" << graph.size() << " vertices, "
+              << compressed->countEdge() << " edges)" << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+              << "  bytes/edge: linked lists "
+              << (graph.size()*sizeof(void*) + n_edges*sizeof(graph::Edge<long>))/n_edges
+              << ", CSR " << (graph.size()*sizeof(uint64_t) + n_edges*sizeof(uint32_t))/n_edges
+              << ", compressed " << compressed->bytes()/n_edges
+              << " (lists only " << (compressed->bytes() - (graph.size() + 1)*sizeof(uint64_t))/n_edges
+              << ")" << std::endl;
+    std::cout << std::setprecision(1) << "  build " << build_time << " ms, decode "
+              << decodeThroughput(*compressed, false) << " M edges/s (scalar)";
+    if (graph_codec::kSimdDecode) {
+      std::cout << ", " << decodeThroughput(*compressed, true) << " M edges/s (SSSE3)";
+    }
+    std::cout << std::endl;
+
+    // the BFS starts from the vertex of the largest degree
+    size_t src = 0;
+    for (size_t v = 0; v < graph.size(); ++v) {
+      if (compressed->degree(v) > compressed->degree(src)) { src = v; }
+    }
+    std::vector<size_t> distances;
+    double list_bfs = wallTime([&]() { distances = bfsDistance(graph, src); });
+    double compressed_bfs = wallTime([&]() { distances = bfsDistance(*compressed, src); });
+    size_t n_reached = graph.size() - std::count(distances.begin(), distances.end(),
+                                                 kUnreachedDistance);
+    size_t n_scc = 0;
+    double list_scc = wallTime([&]() { n_scc = kosaraju(graph).size(); });
+    double compressed_scc = wallTime([&]() { n_scc = kosaraju(*compressed).size(); });
+    // the peak of the working memory, where the components are labels
+    // of 4 bytes per vertex
+    size_t compressed_peak = peakMemory([&]() { kosarajuComponents(*compressed); });
+    std::cout << "  BFS " << list_bfs << " ms (linked lists) vs " << compressed_bfs
+              << " ms (compressed), " << n_reached << " vertices reached" << std::endl;
+    std::cout << "  Kosaraju " << list_scc << " ms (linked lists) vs " << compressed_scc
+              << " ms (compressed), " << n_scc << " SCCs" << std::endl;
+    if (compressed_peak > 0) {
+      std::cout << std::setprecision(2) << "  Kosaraju peak bytes/edge: compressed "
+                << (compressed->bytes() + compressed_peak)/n_edges << " (graph "
+                << compressed->bytes()/n_edges << " + working memory " << compressed_peak/n_edges
+                << "), CSR graph alone "
+                << (graph.size()*sizeof(uint64_t) + n_edges*sizeof(uint32_t))/n_edges << std::endl;
+    }
+  }
+
+  //
+  // The SCC assignment graph (or an R-MAT graph of the same scale if its
+  // file is missing) and a road-like grid
+  //
+  void runCompressedGraphBenchmark() {
+    std::cout << "\n" << std::string(80, '-') << "\n"
+              << "Compressed graph benchmark"
+              << "\n" << std::string(80, '-')
+              << std::endl;
+
+    std::uniform_int_distribution<long> weight(1, 100);
+    GeneratedGraph<long> scc = readSccEdges("../data/SCC.txt", 875714);
+    if (!scc.edges.empty()) {
+      benchmarkCompressedGraph("../data/SCC.txt", scc);
+    } else {
+      benchmarkCompressedGraph("R-MAT (SCC.txt scale)",
+                               graph_generator::rmat(20, 5105043, weight, 1, true));
+    }
+    scc.edges.clear();
+    scc.edges.shrink_to_fit();
+    benchmarkCompressedGraph("grid", graph_generator::grid(1000, 1000, weight, 2));
+  }
+
+}  // namespace graph_benchmark
+
+#endif //GRAPH_BENCHMARK_COMPRESSED_GRAPH_H
@@ -0,0 +1,95 @@
+//
+// Compare the randomized (Karger, Karger-Stein) and the deterministic
+// (Stoer-Wagner) min cut algorithms.
+//
+
+#ifndef GRAPH_BENCHMARK_MIN_CUT_H
+#define GRAPH_BENCHMARK_MIN_CUT_H
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "benchmark_utilities.h"
+#include "../graph_algorithms/karger.h"
+#include "../graph_algorithms/stoer_wagner.h"
+#include "../assignments/assignment_karger.h"
+
+
+namespace graph_benchmark {
+
+  //
+  // Generate two random clusters of n/2 vertices with the given average
+  // degree, which are joined by "n_cut" edges, so the min cut is n_cut
+  // if the degree is large enough
+  //
+  UndirectedGraph<long> twoClusterGraph(size_t n, size_t degree, size_t n_cut,
+                                        unsigned seed=0) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<size_t> vertex(0, n/2 - 1);
+    UndirectedGraph<long> graph(n);
+    for (size_t v = 0; v < n/2; ++v) {
+      graph.connect(v, (v + 1)%(n/2));
+      graph.connect(v + n/2, (v + 1)%(n/2) + n/2);
+    }
+    for (size_t e = 0; e < n*degree/4; ++e) {
+      graph.connect(vertex(generator), vertex(generator));
+      graph.connect(vertex(generator) + n/2, vertex(generator) + n/2);
+    }
+    for (size_t e = 0; e < n_cut; ++e) { graph.connect(e, e + n/2); }
+
+    return graph;
+  }
+
+  template <class F>
+  void reportMinCut(const std::string& name, size_t n_trials, F run_min_cut) {
+    size_t cut = 0;
+    double time = wallTime([&]() { cut = run_min_cut(); });
+    std::cout << "  " << std::left << std::setw(28) << name << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1) << time
+              << " ms" << std::setw(10) << std::setprecision(3) << time/n_trials
+              << " ms/trial    cut " << cut << std::endl;
+  }
+
+  void benchmarkMinCut(const std::string& name, const UndirectedGraph<long>& graph,
+                       size_t n_karger_trials, size_t n_karger_stein_trials,
+                       size_t n_threads) {
+    std::cout << name << " (" << graph.size() << " vertices, "
+              << graph.countEdge() << " edges)" << std::endl;
+
+    reportMinCut("Karger x" + std::to_string(n_karger_trials), n_karger_trials,
+                 [&]() { return karger(graph, n_karger_trials, n_threads, 0); });
+    reportMinCut("Karger-Stein x" + std::to_string(n_karger_stein_trials),
+                 n_karger_stein_trials, [&]() {
+      return kargerStein(graph, n_karger_stein_trials, n_threads, 0);
+    });
+    reportMinCut("Stoer-Wagner", 1, [&]() { return (size_t)stoerWagner(graph).first; });
+  }
+
+  //
+  // The assignment graph and two random clusters joined by 5 edges of
+  // growing size. Karger's trials are cheap but only find the min cut
+  // with probability 2/V^2 each; Karger-Stein's and Stoer-Wagner's runs
+  // are slower but much more likely (or sure) to find it.
+  //
+  void runMinCutBenchmark() {
+    std::cout << "\n" << std::string(80, '-') << "\n"
+              << "Minimum cut benchmark"
+              << "\n" << std::string(80, '-')
+              << std::endl;
+
+    const size_t n_threads = graph_parallel::defaultThreadCount();
+    std::cout << "Threads: " << n_threads << std::endl;
+
+    benchmarkMinCut("../data/kargerMinCut.txt",
+                    readKargerMinCutGraph("../data/kargerMinCut.txt"), 1000, 5, n_threads);
+    for (size_t n : {400, 1000, 2000}) {
+      benchmarkMinCut("two clusters", twoClusterGraph(n, 16, 5), 1000,
+                      n <= 1000 ? 2 : 1, n_threads);
+    }
+  }
+
+}  // namespace graph_benchmark
+
+#endif //GRAPH_BENCHMARK_MIN_CUT_H
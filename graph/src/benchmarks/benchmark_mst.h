@@ -0,0 +1,83 @@
+//
+// Compare the minimum spanning tree algorithms on random graphs from
+// sparse to complete, to find where each one takes over.
+//
+
+#ifndef GRAPH_BENCHMARK_MST_H
+#define GRAPH_BENCHMARK_MST_H
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "benchmark_utilities.h"
+#include "../graph_generators.h"
+#include "../graph_algorithms/minimum_spanning_tree.h"
+
+
+namespace graph_benchmark {
+
+  //
+  // Generate a connected undirected graph, where each pair of vertices
+  // is connected with probability "density" and the components are
+  // then joined by a path
+  //
+  UndirectedGraph<long> randomConnectedGraph(size_t n, double density,
+                                             unsigned seed=0) {
+    std::uniform_int_distribution<long> weight(0, 1000000);
+    GeneratedGraph<long> generated = graph_generator::erdosRenyi(n, density, weight, seed);
+    graph_generator::connectComponents(generated, weight, seed);
+    return graph_generator::toUndirectedGraph(generated);
+  }
+
+  template <class F>
+  void reportMst(const std::string& name, F run_mst) {
+    long cost = 0;
+    double time = wallTime([&]() { cost = run_mst().first; });
+    std::cout << "  " << std::left << std::setw(24) << name << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1) << time
+              << " ms    cost " << cost << std::endl;
+  }
+
+  void benchmarkMst(const UndirectedGraph<long>& graph, size_t n_threads) {
+    const size_t n_edges = graph.countEdge();
+    std::cout << graph.size() << " vertices, " << n_edges << " edges (density "
+              << std::setprecision(4)
+              << 2.0*n_edges/graph.size()/(graph.size() - 1)
+              << "), the front end picks "
+              << mstAlgorithmName(chooseMstAlgorithm(graph.size(), n_edges, n_threads))
+              << std::endl;
+
+    // O(V^2) does not finish on large sparse graphs
+    if (graph.size() <= 10000) {
+      reportMst("dense Prim", [&]() { return prim_dense(graph, 0); });
+    }
+    reportMst("Prim", [&]() { return prim(graph, 0); });
+    reportMst("Kruskal", [&]() { return kruskal(graph); });
+    reportMst("Filter-Kruskal", [&]() { return filterKruskal(graph, n_threads); });
+    reportMst("Boruvka", [&]() { return boruvka(graph, n_threads); });
+  }
+
+  //
+  // All the minimum spanning tree algorithms on 1000 vertices with
+  // growing density, and on a large sparse graph
+  //
+  void runMinimumSpanningTreeBenchmark() {
+    std::cout << "\n" << std::string(80, '-') << "\n"
+              << "Minimum spanning tree benchmark"
+              << "\n" << std::string(80, '-')
+              << std::endl;
+
+    const size_t n_threads = graph_parallel::defaultThreadCount();
+    std::cout << "Threads: " << n_threads << std::endl;
+
+    for (double density : {0.002, 0.01, 0.05, 0.1, 0.2, 0.5, 1.0}) {
+      benchmarkMst(randomConnectedGraph(1000, density), n_threads);
+    }
+    benchmarkMst(randomConnectedGraph(200000, 0.00005), n_threads);
+  }
+
+}  // namespace graph_benchmark
+
+#endif //GRAPH_BENCHMARK_MST_H
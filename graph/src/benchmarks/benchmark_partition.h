@@ -0,0 +1,101 @@
+//
+// Compare the edge cut and the BFS communication of the label
+// propagation partition with a random balanced partition.
+//
+
+#ifndef GRAPH_BENCHMARK_PARTITION_H
+#define GRAPH_BENCHMARK_PARTITION_H
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark_utilities.h"
+#include "../graph_generators.h"
+#include "../graph_shards.h"
+#include "../graph_algorithms/partition.h"
+#include "../graph_algorithms/sharded_bfs.h"
+
+
+namespace graph_benchmark {
+
+  // each vertex in a uniformly random part of equal size
+  GraphPartition randomPartition(size_t n, size_t n_parts, unsigned seed=0) {
+    GraphPartition partition;
+    partition.parts.resize(n);
+    partition.sizes.assign(n_parts, 0);
+    for (size_t v = 0; v < n; ++v) { partition.parts[v] = (uint32_t)(v%n_parts); }
+    std::mt19937 generator(seed);
+    std::shuffle(partition.parts.begin(), partition.parts.end(), generator);
+    for (auto part : partition.parts) { ++partition.sizes[part]; }
+    return partition;
+  }
+
+  template <class T>
+  void reportPartition(const std::string& name, const Graph<T>& graph,
+                       const GraphPartition& partition, double partition_time) {
+    const std::string prefix = "benchmark_partition";
+    std::vector<std::string> paths;
+    double write_time = wallTime([&]() {
+      paths = graph_shards::writeShards(graph, partition, prefix);
+    });
+    ShardedBfsStats stats;
+    double bfs_time = wallTime([&]() { shardedBfs<T>(paths, 0, &stats); });
+    for (auto& path : paths) { std::remove(path.c_str()); }
+
+    size_t largest = *std::max_element(partition.sizes.begin(), partition.sizes.end());
+    std::cout << "  " << std::left << std::setw(22) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(9) << partition_time << " ms"
+              << std::setw(7) << std::setprecision(2)
+              << 100.0*partition.edge_cut/std::max<size_t>(graph.countEdge(), 1) << "% cut"
+              << std::setw(7) << (double)largest*partition.sizes.size()/graph.size() << " imb"
+              << std::setw(10) << stats.n_bytes/1024 << " KB sent"
+              << std::setw(8) << stats.n_levels << " levels"
+              << std::setprecision(1) << std::setw(9) << write_time << " ms write"
+              << std::setw(9) << bfs_time << " ms BFS" << std::endl;
+  }
+
+  template <class T>
+  void benchmarkPartition(const std::string& name, const Graph<T>& graph) {
+    std::cout << name << " (" << graph.size() << " vertices, "
+              << graph.countEdge() << " edges)" << std::endl;
+
+    for (size_t n_parts : {2, 4, 8}) {
+      GraphPartition partition;
+      double time = wallTime([&]() { partition = labelPropagationPartition(graph, n_parts); });
+      reportPartition("label propagation k=" + std::to_string(n_parts), graph, partition, time);
+      time = wallTime([&]() {
+        partition = randomPartition(graph.size(), n_parts);
+        partition.edge_cut = countEdgeCut(graph, partition.parts);
+      });
+      reportPartition("random k=" + std::to_string(n_parts), graph, partition, time);
+    }
+  }
+
+  //
+  // Graphs with locality (grid, geometric) are cut far less by label
+  // propagation than at random, while the cut of the skewed R-MAT
+  // graph grows quickly with k.
+  //
+  void runPartitionBenchmark() {
+    std::cout << "\n" << std::string(80, '-') << "\n"
+              << "Graph partition benchmark"
+              << "\n" << std::string(80, '-')
+              << std::endl;
+
+    std::uniform_int_distribution<long> weight(1, 100);
+    benchmarkPartition("grid", graph_generator::toUndirectedGraph(
+        graph_generator::grid(400, 400, weight, 1)));
+    benchmarkPartition("random geometric", graph_generator::toUndirectedGraph(
+        graph_generator::randomGeometric(100000, 0.006, weight, 2)));
+    benchmarkPartition("R-MAT", graph_generator::toDirectedGraph(
+        graph_generator::rmat(17, 1000000, weight, 3, true)));
+  }
+
+}  // namespace graph_benchmark
+
+#endif //GRAPH_BENCHMARK_PARTITION_H
@@ -0,0 +1,241 @@
+//
+// A load generator for the query server: closed-loop clients which each
+// keep a No. of queries in flight on their own connection, and report
+// the throughput and the latency percentiles. Also used by "graphd load"
+// against a running daemon.
+//
+
+#ifndef GRAPH_BENCHMARK_QUERY_SERVER_H
+#define GRAPH_BENCHMARK_QUERY_SERVER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "benchmark_utilities.h"
+#include "../graph_server.h"
+#include "../graph_generators.h"
+
+
+namespace graph_benchmark {
+
+  struct LoadTestResult {
+    size_t n_requests;
+    size_t n_errors;     // answers which start with "error"
+    double time;         // ms
+    double throughput;   // requests per second
+    double p50;          // latencies in ms
+    double p99;
+    double max;
+  };
+
+  //
+  // Connect to the Unix socket of a server
+  //
+  inline int connectSocket(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+      throw std::invalid_argument("Invalid argument: socket path");
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+      std::string error = std::strerror(errno);
+      if (fd >= 0) { ::close(fd); }
+      throw std::runtime_error("connect failed for " + path + ": " + error);
+    }
+    return fd;
+  }
+
+  //
+  // Read the lines of a connection
+  //
+  class LineReader {
+  public:
+    explicit LineReader(int fd) : fd_(fd) {}
+
+    // false at the end of the stream
+    bool next(std::string& line) {
+      size_t end;
+      while ((end = buffer_.find('\n')) == std::string::npos) {
+        char chunk[4096];
+        ssize_t n = ::read(fd_, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) { continue; }
+        if (n <= 0) { return false; }
+        buffer_.append(chunk, (size_t)n);
+      }
+      line.assign(buffer_, 0, end);
+      buffer_.erase(0, end + 1);
+      return true;
+    }
+
+  private:
+    int fd_;
+    std::string buffer_;
+  };
+
+  //
+  // A random query: half distances, 30% hops and 20% component queries.
+  // The sources are drawn from the first n_sources vertices (all of them
+  // if 0), e.g. a few depots which many queries start from.
+  //
+  inline std::string randomQuery(std::mt19937_64& engine, size_t n_vertices, size_t n_sources) {
+    std::uniform_int_distribution<size_t> vertex(0, n_vertices - 1);
+    std::uniform_int_distribution<size_t> source(0, (n_sources == 0 ? n_vertices : n_sources) - 1);
+    size_t kind = engine() % 10;
+    if (kind < 5) {
+      return "dist " + std::to_string(source(engine)) + " " + std::to_string(vertex(engine));
+    }
+    if (kind < 8) {
+      return "hops " + std::to_string(source(engine)) + " " + std::to_string(vertex(engine));
+    }
+    if (kind < 9) { return "component " + std::to_string(vertex(engine)); }
+    return "connected " + std::to_string(vertex(engine)) + " " + std::to_string(vertex(engine));
+  }
+
+  /**
+   * Run closed-loop clients against a server
+   *
+   * @param socket_path: the Unix socket of the server
+   * @param n_vertices: No. of vertices of the served graph
+   * @param n_clients: No. of connections, one thread each
+   * @param n_requests: No. of queries per client
+   * @param pipeline: No. of queries each client keeps in flight
+   * @param n_sources: see randomQuery()
+   * @param seed: seed of the queries
+   */
+  inline LoadTestResult runLoadTest(const std::string& socket_path, size_t n_vertices,
+                                    size_t n_clients, size_t n_requests, size_t pipeline=1,
+                                    size_t n_sources=0, uint64_t seed=0) {
+    if (n_vertices == 0 || n_clients == 0 || pipeline == 0) {
+      throw std::invalid_argument("Invalid argument: load test");
+    }
+    typedef std::chrono::steady_clock clock;
+
+    // connect first so that the clients start together
+    std::vector<int> fds;
+    try {
+      for (size_t c = 0; c < n_clients; ++c) { fds.push_back(connectSocket(socket_path)); }
+    } catch (...) {
+      for (int fd : fds) { ::close(fd); }
+      throw;
+    }
+
+    std::vector<std::vector<double>> latencies(n_clients);
+    std::vector<size_t> n_errors(n_clients, 0);
+    std::vector<std::thread> clients;
+    auto t0 = clock::now();
+    for (size_t c = 0; c < n_clients; ++c) {
+      clients.emplace_back([&, c]() {
+        std::mt19937_64 engine(seed + c);
+        LineReader reader(fds[c]);
+        std::deque<clock::time_point> in_flight;
+        std::string line;
+        size_t n_sent = 0;
+        while (latencies[c].size() < n_requests) {
+          // send a batch of queries before waiting for the oldest one
+          std::string queries;
+          while (n_sent < n_requests && in_flight.size() < pipeline) {
+            queries += randomQuery(engine, n_vertices, n_sources) + "\n";
+            in_flight.push_back(clock::now());
+            ++n_sent;
+          }
+          if (!queries.empty()) { graph_server::writeAll(fds[c], true, queries); }
+
+          if (!reader.next(line)) { break; }
+          latencies[c].push_back(std::chrono::duration<double, std::milli>(
+              clock::now() - in_flight.front()).count());
+          in_flight.pop_front();
+          if (line.compare(0, 5, "error") == 0) { ++n_errors[c]; }
+        }
+        ::close(fds[c]);
+      });
+    }
+    for (auto& client : clients) { client.join(); }
+    double time = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+
+    std::vector<double> all;
+    LoadTestResult result {0, 0, time, 0, 0, 0, 0};
+    for (size_t c = 0; c < n_clients; ++c) {
+      all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+      result.n_errors += n_errors[c] + (n_requests - latencies[c].size());
+    }
+    result.n_requests = all.size();
+    if (all.empty()) { return result; }
+
+    std::sort(all.begin(), all.end());
+    result.throughput = all.size()/std::max(time, 1e-3)*1000;
+    result.p50 = all[(all.size() - 1)/2];
+    result.p99 = all[(all.size() - 1)*99/100];
+    result.max = all.back();
+    return result;
+  }
+
+  inline void printLoadTest(std::ostream& os, const LoadTestResult& result) {
+    os << std::fixed << std::setprecision(2) << result.n_requests << " requests in "
+       << result.time << " ms: " << std::setprecision(0) << result.throughput
+       << " requests/s, latency p50 " << std::setprecision(3) << result.p50 << " ms, p99 "
+       << result.p99 << " ms, max " << result.max << " ms";
+    if (result.n_errors > 0) { os << ", " << result.n_errors << " errors"; }
+    os << std::endl;
+  }
+
+  //
+  // A server on a road-like grid with the clients in the same process.
+  // The batches grow with the No. of queries in flight, and the queries
+  // from a few sources share their searches.
+  //
+  void runQueryServerBenchmark() {
+    std::cout << "\n" << std::string(80, '-') << "\n"
+              << "Query server benchmark"
+              << "\n" << std::string(80, '-')
+              << std::endl;
+
+    std::uniform_int_distribution<long> weight(1, 100);
+    auto graph = graph_generator::toDirectedGraph(graph_generator::grid(200, 200, weight, 1));
+    const std::string path = "graph_query_benchmark.sock";
+    std::cout << "grid (" << graph.size() << " vertices, " << graph.countEdge() << " edges), "
+              << graph_parallel::defaultThreadCount() << " worker threads" << std::endl;
+
+    for (size_t n_sources : {0, 16}) {
+      std::cout << (n_sources == 0 ? "random sources" : "16 sources") << std::endl;
+      for (size_t n_clients : {1, 8}) {
+        for (size_t pipeline : {1, 16}) {
+          GraphQueryServer<long> server(graph);
+          server.listen(path);
+          auto result = runLoadTest(path, graph.size(), n_clients, 2000/n_clients, pipeline,
+                                    n_sources);
+          server.stop();
+          QueryServerStats stats = server.stats();
+
+          std::cout << "  " << n_clients << " clients x " << pipeline << " in flight: ";
+          printLoadTest(std::cout, result);
+          std::cout << std::setprecision(2) << "    "
+                    << (double)stats.n_requests/std::max<uint64_t>(stats.n_batches, 1)
+                    << " queries/batch, "
+                    << (double)stats.n_searches/std::max<uint64_t>(stats.n_requests, 1)
+                    << " searches/query" << std::endl;
+        }
+      }
+    }
+  }
+
+}  // namespace graph_benchmark
+
+#endif //GRAPH_BENCHMARK_QUERY_SERVER_H
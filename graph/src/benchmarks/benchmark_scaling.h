@@ -0,0 +1,247 @@
+//
+// Run the algorithms on generated graphs from 10^4 edges up to a given
+// No. of edges, to see how each one scales with the size and the shape
+// (skewed, road-like, geometric, uniform) of the graph.
+//
+
+#ifndef GRAPH_BENCHMARK_SCALING_H
+#define GRAPH_BENCHMARK_SCALING_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "benchmark_utilities.h"
+#include "../graph_generators.h"
+#include "../graph_algorithms/breath_first_search.h"
+#include "../graph_algorithms/depth_first_search.h"
+#include "../graph_algorithms/dijkstra.h"
+#include "../graph_algorithms/bellman_ford.h"
+#include "../graph_algorithms/kosaraju.h"
+#include "../graph_algorithms/johnson.h"
+#include "../graph_algorithms/floyd_warshall.h"
+#include "../graph_algorithms/min_plus.h"
+#include "../graph_algorithms/prim.h"
+#include "../graph_algorithms/kruskal.h"
+#include "../graph_algorithms/boruvka.h"
+#include "../graph_algorithms/minimum_spanning_tree.h"
+#include "../graph_algorithms/incremental_mst.h"
+#include "../graph_algorithms/karger.h"
+#include "../graph_algorithms/stoer_wagner.h"
+
+
+namespace graph_benchmark {
+
+  // an algorithm is skipped if its estimated No. of operations, most of
+  // which step through a linked list, is larger than this
+  const double kScalingBudget = 2e8;
+
+  // bytes per undirected edge: the edge list, and the linked lists of
+  // the undirected and the directed graph (with the allocator overhead)
+  const double kScalingBytesPerEdge = sizeof(WeightedEdge<long>) + 4*32;
+
+  struct ScalingCase {
+    std::string name;
+    // estimated No. of operations for V vertices and E edges
+    std::function<double(double, double)> cost;
+    std::function<void(UndirectedGraph<long>&, DirectedGraph<long>&)> run;
+  };
+
+  inline std::vector<ScalingCase> scalingCases(size_t n_threads) {
+    auto log2 = [](double x) { return std::log2(std::max(x, 2.0)); };
+    std::vector<ScalingCase> cases;
+    cases.push_back({"BFS", [](double v, double e) { return v + e; },
+                     [](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       breathFirstSearch(g, 0);
+                     }});
+    cases.push_back({"DFS", [](double v, double e) { return v + e; },
+                     [](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       depthFirstSearch(g, 0);
+                     }});
+    cases.push_back({"Dijkstra", [=](double v, double e) { return (v + e)*log2(v); },
+                     [](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       dijkstra(g, 0);
+                     }});
+    cases.push_back({"Bellman-Ford (queue)", [](double v, double e) { return e*std::sqrt(v); },
+                     [](UndirectedGraph<long>&, DirectedGraph<long>& g) {
+                       bellmanFordQueue(g, 0);
+                     }});
+    cases.push_back({"Bellman-Ford", [](double v, double e) { return v*e; },
+                     [](UndirectedGraph<long>&, DirectedGraph<long>& g) {
+                       bellmanFord(g, 0);
+                     }});
+    cases.push_back({"Kosaraju", [](double v, double e) { return v + e; },
+                     [](UndirectedGraph<long>&, DirectedGraph<long>& g) {
+                       kosaraju(g);
+                     }});
+    cases.push_back({"Johnson", [=](double v, double e) { return v*(v + e)*log2(v); },
+                     [=](UndirectedGraph<long>&, DirectedGraph<long>& g) {
+                       johnson(g, n_threads);
+                     }});
+    cases.push_back({"blocked Floyd-Warshall", [](double v, double) { return v*v*v; },
+                     [=](UndirectedGraph<long>&, DirectedGraph<long>& g) {
+                       floydWarshallBlocked(g, n_threads);
+                     }});
+    cases.push_back({"min-plus", [=](double v, double) { return v*v*v*log2(v); },
+                     [=](UndirectedGraph<long>&, DirectedGraph<long>& g) {
+                       minPlusShortestPath(g, n_threads);
+                     }});
+    cases.push_back({"dense Prim", [](double v, double e) { return v*v + e; },
+                     [](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       prim_dense(g, 0);
+                     }});
+    cases.push_back({"Prim", [=](double v, double e) { return e*log2(v); },
+                     [](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       prim(g, 0);
+                     }});
+    cases.push_back({"Kruskal", [=](double, double e) { return e*log2(e); },
+                     [](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       kruskal(g);
+                     }});
+    cases.push_back({"Filter-Kruskal", [=](double, double e) { return e*log2(e); },
+                     [=](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       filterKruskal(g, n_threads);
+                     }});
+    cases.push_back({"Boruvka", [=](double v, double e) { return e*log2(v); },
+                     [=](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       boruvka(g, n_threads);
+                     }});
+    cases.push_back({"incremental MSF (10 batches)", [=](double, double e) { return e*log2(e); },
+                     [=](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       std::vector<WeightedEdge<long>> edges = edgeList(g);
+                       IncrementalMinimumSpanningForest<long> forest(g.size(), n_threads);
+                       for (size_t k = 0; k < 10; ++k) {
+                         forest.insertEdges(std::vector<WeightedEdge<long>>(
+                             edges.begin() + edges.size()*k/10,
+                             edges.begin() + edges.size()*(k + 1)/10));
+                       }
+                     }});
+    cases.push_back({"Karger x10", [](double, double e) { return 10*e; },
+                     [=](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       karger(g, 10, n_threads, 0);
+                     }});
+    cases.push_back({"Karger-Stein x1", [=](double v, double) {
+                       return v*v*log2(v)*log2(v);
+                     },
+                     [=](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       kargerStein(g, 1, n_threads, 0);
+                     }});
+    cases.push_back({"Stoer-Wagner", [=](double v, double e) { return v*e*log2(v); },
+                     [](UndirectedGraph<long>& g, DirectedGraph<long>&) {
+                       stoerWagner(g);
+                     }});
+    return cases;
+  }
+
+  //
+  // Generate one of the families with about n_edges undirected edges,
+  // all connected so that every algorithm can run on it
+  //
+  inline GeneratedGraph<long> generateScalingGraph(const std::string& family,
+                                                   size_t n_edges, size_t n_threads) {
+    std::uniform_int_distribution<long> weight(1, 1000);
+    GeneratedGraph<long> graph;
+    if (family == "R-MAT") {
+      // Graph500 draws 16 edges per vertex, of which ~1/2 are duplicates
+      size_t scale = (size_t)std::max(1.0, std::round(std::log2(n_edges/8.0)));
+      graph = graph_generator::rmat(scale, n_edges, weight, 0, false, n_threads);
+    } else if (family == "grid") {
+      size_t side = (size_t)std::max(2.0, std::sqrt(n_edges/2.0));
+      graph = graph_generator::grid(side, side, weight, 0, 1.0, n_threads);
+    } else if (family == "geometric") {
+      // average degree 16
+      size_t n = std::max<size_t>(n_edges/8, 2);
+      double radius = std::sqrt(2.0*n_edges/(std::acos(-1.0)*n*(double)n));
+      graph = graph_generator::randomGeometric(n, radius, weight, 0, n_threads);
+    } else {
+      size_t n = std::max<size_t>(n_edges/8, 2);
+      double p = std::min(1.0, 2.0*n_edges/(n*(n - 1.0)));
+      graph = graph_generator::erdosRenyi(n, p, weight, 0, false, n_threads);
+    }
+    graph_generator::connectComponents(graph, weight, 0);
+    return graph;
+  }
+
+  void benchmarkScaling(const std::string& family, size_t n_edges, size_t n_threads,
+                        const std::vector<ScalingCase>& cases) {
+    GeneratedGraph<long> generated;
+    double generate_time = wallTime([&]() {
+      generated = generateScalingGraph(family, n_edges, n_threads);
+    });
+    const double v = generated.size;
+    const double e = generated.edges.size();
+    std::cout << family << " (" << generated.size << " vertices, "
+              << generated.edges.size() << " edges)" << std::endl;
+    std::cout << "  " << std::left << std::setw(32) << "generate" << std::right
+              << std::setw(12) << std::fixed << std::setprecision(1)
+              << generate_time << " ms" << std::endl;
+
+    const std::string path = "scaling_snapshot.bin";
+    double save_time = wallTime([&]() { graph_generator::saveSnapshot(generated, path); });
+    double load_time = wallTime([&]() { generated = graph_generator::loadSnapshot<long>(path); });
+    std::remove(path.c_str());
+    std::cout << "  " << std::left << std::setw(32) << "save/load snapshot" << std::right
+              << std::setw(12) << save_time << " ms" << std::setw(12) << load_time
+              << " ms" << std::endl;
+
+    const double memory = (double)sysconf(_SC_PHYS_PAGES)*sysconf(_SC_PAGE_SIZE);
+    if (e*kScalingBytesPerEdge > memory/2) {
+      std::cout << "  the graphs do not fit in memory, skipped" << std::endl;
+      return;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    UndirectedGraph<long> undirected = graph_generator::toUndirectedGraph(generated);
+    DirectedGraph<long> directed = graph_generator::toDirectedGraph(generated);
+    double build_time = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+    std::vector<WeightedEdge<long>>().swap(generated.edges);
+    std::cout << "  " << std::left << std::setw(32) << "load into the graphs" << std::right
+              << std::setw(12) << build_time << " ms" << std::endl;
+
+    for (const auto& c : cases) {
+      std::cout << "  " << std::left << std::setw(32) << c.name << std::right;
+      if (c.cost(v, e) > kScalingBudget) {
+        std::cout << std::setw(12) << "-" << std::endl;
+        continue;
+      }
+      double time = wallTime([&]() { c.run(undirected, directed); });
+      std::cout << std::setw(12) << time << " ms" << std::setw(12)
+                << std::setprecision(2) << e/time/1000 << " M edges/s"
+                << std::setprecision(1) << std::endl;
+    }
+  }
+
+  //
+  // All the algorithms on the four families of generated graphs with
+  // 10^4, 10^5, ... edges up to max_edges. An algorithm is skipped
+  // ("-") when it would take more than about kScalingBudget operations.
+  //
+  void runScalingBenchmark(size_t max_edges=1000000) {
+    std::cout << "\n" << std::string(80, '-') << "\n"
+              << "Scaling benchmark"
+              << "\n" << std::string(80, '-')
+              << std::endl;
+
+    const size_t n_threads = graph_parallel::defaultThreadCount();
+    std::cout << "Threads: " << n_threads << std::endl;
+
+    const std::vector<ScalingCase> cases = scalingCases(n_threads);
+    for (size_t n_edges = 10000; n_edges <= max_edges; n_edges *= 10) {
+      for (const char* family : {"R-MAT", "grid", "geometric", "Erdos-Renyi"}) {
+        benchmarkScaling(family, n_edges, n_threads, cases);
+      }
+    }
+  }
+
+}  // namespace graph_benchmark
+
+#endif //GRAPH_BENCHMARK_SCALING_H
@@ -0,0 +1,68 @@
+//
+// Helpers shared by the benchmarks.
+//
+
+#ifndef GRAPH_BENCHMARK_UTILITIES_H
+#define GRAPH_BENCHMARK_UTILITIES_H
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+
+namespace graph_benchmark {
+
+  //
+  // Run f() and get the wall time in ms
+  //
+  template <class F>
+  double wallTime(F f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+  }
+
+  // get a field of /proc/self/status ("VmRSS", "VmHWM") in bytes, or 0
+  // if there is none
+  inline size_t procStatusBytes(const std::string& field) {
+    std::ifstream ifs("/proc/self/status");
+    std::string name;
+    size_t kb = 0;
+    while (ifs >> name) {
+      if (name == field + ":" && ifs >> kb) { return kb*1024; }
+      ifs.ignore(256, '\n');
+    }
+    return 0;
+  }
+
+  //
+  // Run f() and get by how many bytes the peak resident memory exceeds
+  // the memory before it, or 0 where the peak cannot be reset (Linux
+  // only). The freed heap is returned to the system first, so that f()
+  // does not reuse pages which are resident already.
+  //
+  template <class F>
+  size_t peakMemory(F f) {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+    size_t before = procStatusBytes("VmRSS");
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    // "5" resets the peak to the current resident memory
+    if (before == 0 || !(clear_refs << "5" << std::flush)) {
+      f();
+      return 0;
+    }
+    f();
+    size_t peak = procStatusBytes("VmHWM");
+    return peak > before ? peak - before : 0;
+  }
+
+}  // namespace graph_benchmark
+
+#endif //GRAPH_BENCHMARK_UTILITIES_H
@@ -0,0 +1,576 @@
+//
+// A read-only graph whose adjacency lists are compressed, for graphs
+// whose edges do not fit in RAM as linked lists (24 bytes per edge) or
+// even as CSR (4 bytes per edge).
+//
+// The neighbors of a vertex are sorted, and the gaps between them are
+// stored with the stream-vbyte codec: a control byte holds the lengths
+// (1 - 4 bytes) of four gaps, and the bytes of the gaps follow all the
+// control bytes. Unlike a plain varint, the lengths of four gaps are
+// known before their bytes are read, so a group is decoded by one
+// SSSE3 shuffle when it is compiled in (e.g. with GRAPH_NATIVE_ARCH).
+//
+// The weights are dropped: the graph only serves the searches which
+// ignore them (BFS, DFS and SCC).
+//
+
+#ifndef GRAPH_COMPRESSED_GRAPH_H
+#define GRAPH_COMPRESSED_GRAPH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+#include "graph.h"
+#include "edge_list.h"
+#include "mapped_file.h"
+
+
+namespace graph_codec {
+
+#if defined(__SSSE3__)
+  const bool kSimdDecode = true;
+#else
+  const bool kSimdDecode = false;
+#endif
+
+  // No. of bytes which a decoder may read past the end of the data
+  const size_t kDecodePadding = 16;
+
+  const char kCompressedMagic[8] = {'G', 'R', 'A', 'P', 'H', 'C', 'Z', '1'};
+
+  // write a LEB128 varint and get its length in bytes
+  inline size_t encodeVarint(uint64_t value, uint8_t* out) {
+    size_t n = 0;
+    while (value >= 0x80) {
+      out[n++] = (uint8_t)(value | 0x80);
+      value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+  }
+
+  // read a LEB128 varint and get the position after it
+  inline const uint8_t* decodeVarint(const uint8_t* in, uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; ; shift += 7) {
+      uint8_t byte = *in++;
+      value |= (uint64_t)(byte & 0x7f) << shift;
+      if (byte < 0x80) { return in; }
+    }
+  }
+
+  // No. of bytes (1 - 4) to store a value
+  inline unsigned byteLength(uint32_t value) {
+    return value < (1u << 8) ? 1 : value < (1u << 16) ? 2 : value < (1u << 24) ? 3 : 4;
+  }
+
+  // max No. of bytes of n values in stream-vbyte
+  inline size_t maxStreamVByteBytes(size_t n) { return (n + 3)/4 + 4*n; }
+
+  /**
+   * Write values with stream-vbyte: (n + 3)/4 control bytes, each with
+   * the length - 1 of four values in 2 bits (the first value in the low
+   * bits), and then the little-endian bytes of the values
+   *
+   * @param values: the values
+   * @param n: No. of values
+   * @param out: room for maxStreamVByteBytes(n) bytes
+   * @return: No. of bytes written
+   */
+  inline size_t encodeStreamVByte(const uint32_t* values, size_t n, uint8_t* out) {
+    uint8_t* control = out;
+    uint8_t* data = out + (n + 3)/4;
+    std::memset(control, 0, (n + 3)/4);
+    for (size_t i = 0; i < n; ++i) {
+      unsigned length = byteLength(values[i]);
+      control[i/4] |= (uint8_t)((length - 1) << (2*(i%4)));
+      for (unsigned b = 0; b < length; ++b) { *data++ = (uint8_t)(values[i] >> (8*b)); }
+    }
+    return data - out;
+  }
+
+  /**
+   * Decode n gaps written by encodeStreamVByte() and add them up, i.e.
+   * out[i] = base + gaps[0] + ... + gaps[i], one value at a time
+   *
+   * @return: the position after the data
+   */
+  inline const uint8_t* decodeDeltaScalar(const uint8_t* in, size_t n, uint32_t base,
+                                          uint32_t* out) {
+    const uint8_t* control = in;
+    const uint8_t* data = in + (n + 3)/4;
+    uint32_t value = base;
+    for (size_t i = 0; i < n; ++i) {
+      unsigned length = ((control[i/4] >> (2*(i%4))) & 3) + 1;
+      uint32_t gap = data[0];
+      if (length > 1) { gap |= (uint32_t)data[1] << 8; }
+      if (length > 2) { gap |= (uint32_t)data[2] << 16; }
+      if (length > 3) { gap |= (uint32_t)data[3] << 24; }
+      data += length;
+      value += gap;
+      out[i] = value;
+    }
+    return data;
+  }
+
+  // No. of data bytes of the first n (up to 4) values of a group
+  inline size_t groupBytes(uint8_t control, size_t n) {
+    size_t n_bytes = 0;
+    for (size_t i = 0; i < n; ++i) { n_bytes += ((control >> (2*i)) & 3) + 1; }
+    return n_bytes;
+  }
+
+  // decode the first n (up to 4) gaps of a group, as decodeDeltaScalar()
+  inline void decodeGroup(uint8_t control, const uint8_t* data, size_t n, uint32_t base,
+                          uint32_t* out) {
+    for (size_t i = 0; i < n; ++i) {
+      unsigned length = ((control >> (2*i)) & 3) + 1;
+      uint32_t gap = 0;
+      for (unsigned b = 0; b < length; ++b) { gap |= (uint32_t)data[b] << (8*b); }
+      data += length;
+      base += gap;
+      out[i] = base;
+    }
+  }
+
+#if defined(__SSSE3__)
+  //
+  // For each control byte, the total length of its four values and the
+  // shuffle which moves their bytes into four 32-bit lanes (0x80 zeroes
+  // a byte)
+  //
+  struct StreamVByteTables {
+    uint8_t lengths[256];
+    uint8_t shuffles[256][16];
+
+    StreamVByteTables() {
+      for (unsigned control = 0; control < 256; ++control) {
+        unsigned position = 0;
+        for (unsigned lane = 0; lane < 4; ++lane) {
+          unsigned length = ((control >> (2*lane)) & 3) + 1;
+          for (unsigned b = 0; b < 4; ++b) {
+            shuffles[control][4*lane + b] = b < length ? (uint8_t)(position + b) : 0x80;
+          }
+          position += length;
+        }
+        lengths[control] = (uint8_t)position;
+      }
+    }
+  };
+
+  inline const StreamVByteTables& streamVByteTables() {
+    static const StreamVByteTables tables;
+    return tables;
+  }
+
+  /**
+   * The same as decodeDeltaScalar(), but four values at a time: a
+   * shuffle spreads the bytes of a group into 32-bit lanes, and two
+   * shifted additions give their prefix sums
+   *
+   * The input must be readable for kDecodePadding bytes past its end.
+   */
+  inline const uint8_t* decodeDeltaSimd(const uint8_t* in, size_t n, uint32_t base,
+                                        uint32_t* out) {
+    const StreamVByteTables& tables = streamVByteTables();
+    const uint8_t* control = in;
+    const uint8_t* data = in + (n + 3)/4;
+    __m128i previous = _mm_set1_epi32((int)base);
+    const size_t n_groups = n/4;
+    for (size_t g = 0; g < n_groups; ++g) {
+      const uint8_t c = control[g];
+      __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+      __m128i gaps = _mm_shuffle_epi8(
+          bytes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffles[c])));
+      data += tables.lengths[c];
+
+      gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 4));
+      gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 8));
+      __m128i values = _mm_add_epi32(gaps, previous);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4*g), values);
+      previous = _mm_shuffle_epi32(values, 0xff);
+    }
+
+    // the last partial group, whose missing values have no data bytes
+    const size_t n_rest = n - 4*n_groups;
+    if (n_rest == 0) { return data; }
+    decodeGroup(control[n_groups], data, n_rest, (uint32_t)_mm_cvtsi128_si32(previous),
+                out + 4*n_groups);
+    return data + groupBytes(control[n_groups], n_rest);
+  }
+#endif
+
+  // decode gaps with the fastest decoder which is compiled in
+  inline const uint8_t* decodeDelta(const uint8_t* in, size_t n, uint32_t base, uint32_t* out) {
+#if defined(__SSSE3__)
+    return decodeDeltaSimd(in, n, base, out);
+#else
+    return decodeDeltaScalar(in, n, base, out);
+#endif
+  }
+
+}  // namespace graph_codec
+
+class CompressedGraph {
+public:
+  /**
+   * Compress the edges of a graph
+   *
+   * @param graph: directed/undirected graph with less than 2^32 vertices,
+   *               where an undirected edge is in the lists of both
+   *               vertices
+   */
+  template <class T>
+  explicit CompressedGraph(const Graph<T>& graph) {
+    checkSize(graph.size());
+    std::vector<uint64_t> offsets(graph.size() + 1, 0);
+    for (size_t u = 0; u < graph.size(); ++u) {
+      offsets[u + 1] = offsets[u];
+      for (graph::Edge<T>* e = graph.getList(u); e != nullptr; e = e->next) { ++offsets[u + 1]; }
+    }
+    std::vector<uint32_t> targets(offsets.back());
+    for (size_t u = 0; u < graph.size(); ++u) {
+      uint64_t position = offsets[u];
+      for (graph::Edge<T>* e = graph.getList(u); e != nullptr; e = e->next) {
+        targets[position++] = (uint32_t)e->dst;
+      }
+    }
+    build(graph.size(), offsets, targets);
+  }
+
+  /**
+   * Compress a list of edges, e.g. of a GeneratedGraph, without building
+   * the linked lists
+   *
+   * @param size: No. of vertices (less than 2^32)
+   * @param edges: the edges, where the duplicates are dropped
+   * @param directed: whether the edges are directed, otherwise each edge
+   *                  is stored in both directions
+   */
+  template <class T>
+  CompressedGraph(size_t size, const std::vector<WeightedEdge<T>>& edges, bool directed) {
+    checkSize(size);
+    std::vector<uint64_t> offsets(size + 1, 0);
+    for (const auto& e : edges) {
+      if (e.src >= size || e.dst >= size) {
+        throw std::out_of_range("Out of range: vertex");
+      }
+      ++offsets[e.src + 1];
+      if (!directed) { ++offsets[e.dst + 1]; }
+    }
+    for (size_t v = 0; v < size; ++v) { offsets[v + 1] += offsets[v]; }
+
+    std::vector<uint32_t> targets(offsets.back());
+    std::vector<uint64_t> positions(offsets.begin(), offsets.end() - 1);
+    for (const auto& e : edges) {
+      targets[positions[e.src]++] = e.dst;
+      if (!directed) { targets[positions[e.dst]++] = e.src; }
+    }
+    build(size, offsets, targets);
+  }
+
+  CompressedGraph(const CompressedGraph&) = delete;
+  CompressedGraph& operator=(const CompressedGraph&) = delete;
+  CompressedGraph(CompressedGraph&&) = default;
+
+  /**
+   * Map a file written by save() for reading only, so that the graph
+   * is paged in from the file on demand
+   *
+   * @param path: file path
+   * @throw: std::invalid_argument if the file is not a compressed graph
+   */
+  static CompressedGraph open(const std::string& path) {
+    std::unique_ptr<MappedFile> file(new MappedFile(path));
+    Header header;
+    if (file->size() < sizeof(header)) {
+      throw std::invalid_argument("Invalid argument: not a compressed graph");
+    }
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, graph_codec::kCompressedMagic, sizeof(header.magic)) != 0) {
+      throw std::invalid_argument("Invalid argument: not a compressed graph");
+    }
+    if (file->size() != fileBytes(header)) {
+      throw std::invalid_argument("Invalid argument: truncated compressed graph");
+    }
+    return CompressedGraph(header, std::move(file));
+  }
+
+  /**
+   * Write the graph to a file, which open() maps
+   *
+   * @param path: file path, which is truncated if it exists
+   */
+  void save(const std::string& path) const {
+    Header header;
+    std::memcpy(header.magic, graph_codec::kCompressedMagic, sizeof(header.magic));
+    header.size = size_;
+    header.n_edges = n_edges_;
+    header.data_bytes = data_bytes_;
+
+    MappedFile file(path, fileBytes(header));
+    char* out = static_cast<char*>(file.data());
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, offsets_, (size_ + 1)*sizeof(uint64_t));
+    out += (size_ + 1)*sizeof(uint64_t);
+    std::memcpy(out, data_, data_bytes_ + graph_codec::kDecodePadding);
+    file.sync();
+  }
+
+  // get No. of vertices
+  size_t size() const { return size_; }
+
+  // get No. of (directed) edges, where an undirected edge counts twice
+  size_t countEdge() const { return n_edges_; }
+
+  // get the size of the compressed lists and of their index in bytes
+  size_t bytes() const { return data_bytes_ + (size_ + 1)*sizeof(uint64_t); }
+
+  // get No. of neighbors of a vertex
+  size_t degree(size_t v) const {
+    if ( v >= size_ ) { throw std::out_of_range("Out of range: vertex"); }
+    uint64_t degree;
+    graph_codec::decodeVarint(data_ + offsets_[v], degree);
+    return degree;
+  }
+
+  /**
+   * Decode the neighbors of a vertex in ascending order
+   *
+   * @param v: the vertex
+   * @param out: room for degree(v) values
+   * @param simd: use the SIMD decoder if it is compiled in
+   * @return: No. of neighbors
+   */
+  size_t decodeNeighbors(size_t v, uint32_t* out, bool simd=true) const {
+    if ( v >= size_ ) { throw std::out_of_range("Out of range: vertex"); }
+    uint64_t degree;
+    const uint8_t* in = graph_codec::decodeVarint(data_ + offsets_[v], degree);
+    if (simd) {
+      graph_codec::decodeDelta(in, degree, 0, out);
+    } else {
+      graph_codec::decodeDeltaScalar(in, degree, 0, out);
+    }
+    return degree;
+  }
+
+  // get the neighbors of a vertex in ascending order
+  std::vector<uint32_t> neighbors(size_t v) const {
+    std::vector<uint32_t> result(degree(v));
+    if (!result.empty()) { decodeNeighbors(v, &result[0]); }
+    return result;
+  }
+
+  /**
+   * Get the graph with all the edges reversed
+   *
+   * The reversed lists are built in passes over ranges of their vertices,
+   * each of which scans all the lists for the edges into the range, so
+   * that only the edges of one range are held uncompressed.
+   *
+   * @param max_pass_edges: No. of edges held per pass (at least the
+   *                        in-degree of a vertex), 0 for 1/16 of them
+   */
+  CompressedGraph reversed(size_t max_pass_edges=0) const {
+    if (max_pass_edges == 0) { max_pass_edges = std::max<size_t>(n_edges_/16, 1 << 16); }
+
+    CompressedGraph result;
+    result.size_ = size_;
+    result.data_buffer_.reserve(data_bytes_ + graph_codec::kDecodePadding);
+    // the in-degrees, which are replaced by the positions of the lists
+    // when they are written
+    std::vector<uint64_t>& in_degrees = result.offsets_buffer_;
+    in_degrees.assign(size_ + 1, 0);
+    std::vector<uint32_t> neighbors;
+    for (size_t u = 0; u < size_; ++u) {
+      neighbors.resize(std::max<size_t>(neighbors.size(), degree(u)));
+      size_t n = decodeNeighbors(u, neighbors.data());
+      for (size_t i = 0; i < n; ++i) { ++in_degrees[neighbors[i]]; }
+    }
+
+    std::vector<uint64_t> positions;
+    std::vector<uint32_t> sources;
+    for (size_t first = 0; first < size_;) {
+      // the vertices [first, last) and their in-lists in "sources"
+      size_t last = first;
+      uint64_t n_sources = 0;
+      while (last < size_ && last - first < max_pass_edges &&
+             (last == first || n_sources + in_degrees[last] <= max_pass_edges)) {
+        n_sources += in_degrees[last++];
+      }
+      positions.assign(1, 0);
+      for (size_t v = first; v < last; ++v) { positions.push_back(positions.back() + in_degrees[v]); }
+      sources.resize(n_sources);
+
+      // the sources are visited in ascending order, so the lists are
+      // sorted without duplicates
+      for (size_t u = 0; u < size_; ++u) {
+        size_t n = decodeNeighbors(u, neighbors.data());
+        for (size_t i = std::lower_bound(neighbors.data(), neighbors.data() + n, (uint32_t)first) -
+                        neighbors.data();
+             i < n && neighbors[i] < last; ++i) {
+          sources[positions[neighbors[i] - first]++] = (uint32_t)u;
+        }
+      }
+      // now positions[i] is the end of the list of first + i
+      for (size_t v = first; v < last; ++v) {
+        uint64_t begin = v == first ? 0 : positions[v - first - 1];
+        result.appendList(v, sources.data() + begin, positions[v - first] - begin);
+      }
+      first = last;
+    }
+    result.finishBuild();
+    return result;
+  }
+
+  //
+  // A position in the list of a vertex, from which the list is decoded
+  // one group of four neighbors at a time instead of as a whole
+  //
+  struct ListCursor {
+    uint32_t vertex;
+    uint32_t next;   // No. of neighbors before the cursor
+    uint32_t base;   // the neighbor before the group of the cursor
+    uint64_t data;   // position of the bytes of that group in the lists
+  };
+
+  ListCursor cursor(size_t v) const {
+    if ( v >= size_ ) { throw std::out_of_range("Out of range: vertex"); }
+    uint64_t degree;
+    const uint8_t* in = graph_codec::decodeVarint(data_ + offsets_[v], degree);
+    return {(uint32_t)v, 0, 0, (uint64_t)(in - data_) + (degree + 3)/4};
+  }
+
+  /**
+   * Decode the group of four neighbors (fewer at the end of the list)
+   * which holds the neighbor at a cursor
+   *
+   * @param cursor: the cursor
+   * @param out: room for 4 values
+   * @return: No. of neighbors in the group, 0 at the end of the list
+   */
+  size_t decodeGroup(const ListCursor& cursor, uint32_t* out) const {
+    uint64_t degree;
+    const uint8_t* control = graph_codec::decodeVarint(data_ + offsets_[cursor.vertex], degree);
+    if (cursor.next >= degree) { return 0; }
+    const size_t group = cursor.next/4;
+    const size_t n = std::min<size_t>(4, degree - 4*group);
+    graph_codec::decodeGroup(control[group], data_ + cursor.data, n, cursor.base, out);
+    return n;
+  }
+
+  // move a cursor to the next group, where "group" has the n neighbors
+  // decoded by decodeGroup()
+  void nextGroup(ListCursor& cursor, const uint32_t* group, size_t n) const {
+    uint64_t degree;
+    const uint8_t* control = graph_codec::decodeVarint(data_ + offsets_[cursor.vertex], degree);
+    cursor.data += graph_codec::groupBytes(control[cursor.next/4], n);
+    cursor.next = (uint32_t)(cursor.next - cursor.next%4 + n);
+    cursor.base = group[n - 1];
+  }
+
+private:
+  struct Header {
+    char magic[8];
+    uint64_t size;        // No. of vertices
+    uint64_t n_edges;
+    uint64_t data_bytes;  // without the padding
+  };
+
+  size_t size_;
+  size_t n_edges_;
+  size_t data_bytes_;
+  std::vector<uint64_t> offsets_buffer_;
+  std::vector<uint8_t> data_buffer_;
+  std::unique_ptr<MappedFile> file_;
+  // the list of vertex v starts at data_[offsets_[v]], where both point
+  // to the buffers or to the mapped file
+  const uint64_t* offsets_;
+  const uint8_t* data_;
+
+  CompressedGraph()
+      : size_(0), n_edges_(0), data_bytes_(0), offsets_(nullptr), data_(nullptr) {}
+
+  CompressedGraph(const Header& header, std::unique_ptr<MappedFile> file)
+      : size_(header.size), n_edges_(header.n_edges), data_bytes_(header.data_bytes),
+        file_(std::move(file)) {
+    const char* in = static_cast<const char*>(file_->data()) + sizeof(Header);
+    offsets_ = reinterpret_cast<const uint64_t*>(in);
+    data_ = reinterpret_cast<const uint8_t*>(in + (size_ + 1)*sizeof(uint64_t));
+  }
+
+  static size_t fileBytes(const Header& header) {
+    return sizeof(Header) + (header.size + 1)*sizeof(uint64_t) + header.data_bytes +
+           graph_codec::kDecodePadding;
+  }
+
+  static void checkSize(size_t size) {
+    if (size > std::numeric_limits<uint32_t>::max()) {
+      throw std::invalid_argument("Invalid argument: too many vertices");
+    }
+  }
+
+  // compress the lists given as CSR, whose ranges of targets are sorted
+  // in place
+  void build(size_t size, const std::vector<uint64_t>& offsets, std::vector<uint32_t>& targets) {
+    size_ = size;
+    n_edges_ = 0;
+    offsets_buffer_.resize(size + 1);
+    data_buffer_.clear();
+    data_buffer_.reserve(targets.size() + size + graph_codec::kDecodePadding);
+
+    for (size_t v = 0; v < size; ++v) {
+      auto first = targets.begin() + offsets[v];
+      auto last = targets.begin() + offsets[v + 1];
+      std::sort(first, last);
+      last = std::unique(first, last);
+      appendList(v, targets.data() + offsets[v], last - first);
+    }
+    finishBuild();
+  }
+
+  // compress the list of vertex v after the lists of the vertices before
+  // it, where the neighbors are sorted without duplicates and are
+  // replaced by their gaps
+  void appendList(size_t v, uint32_t* neighbors, size_t degree) {
+    for (size_t i = degree; i-- > 1;) { neighbors[i] -= neighbors[i - 1]; }
+
+    size_t position = data_buffer_.size();
+    offsets_buffer_[v] = position;
+    data_buffer_.resize(position + 10 + graph_codec::maxStreamVByteBytes(degree));
+    uint8_t* out = &data_buffer_[position];
+    size_t n_bytes = graph_codec::encodeVarint(degree, out);
+    if (degree > 0) { n_bytes += graph_codec::encodeStreamVByte(neighbors, degree, out + n_bytes); }
+    data_buffer_.resize(position + n_bytes);
+    n_edges_ += degree;
+  }
+
+  // end the lists with the padding of the decoders
+  void finishBuild() {
+    offsets_buffer_[size_] = data_buffer_.size();
+    data_bytes_ = data_buffer_.size();
+    data_buffer_.resize(data_bytes_ + graph_codec::kDecodePadding, 0);
+    // a copy of the lists is only worth it for a large slack, e.g. not
+    // after reversed() reserved about the right size
+    if (data_buffer_.capacity() - data_buffer_.size() > data_buffer_.size()/8) {
+      data_buffer_.shrink_to_fit();
+    }
+
+    offsets_ = offsets_buffer_.data();
+    data_ = data_buffer_.data();
+  }
+};
+
+
+#endif //GRAPH_COMPRESSED_GRAPH_H
@@ -58,6 +58,12 @@ public:
     return (this->delEdge(src, dst));
   }
 
+  // connect two vertices which are known not to be connected, in O(1)
+  // time, e.g. to load the edges of a generated graph
+  void connectNew(size_t src, size_t dst, T weight) {
+    this->prependEdge(src, dst, weight);
+  }
+
   // increase the number of vertices by one
   void increaseVertex() {
     vertices_.push_back(nullptr);
@@ -0,0 +1,177 @@
+//
+// Disjoint-set (union-find) data structures over the vertices
+// 0, 1, ..., n - 1.
+//
+
+#ifndef GRAPH_DISJOINT_SET_H
+#define GRAPH_DISJOINT_SET_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+//
+// Disjoint sets with union by rank and path halving
+//
+// Both find() and unite() take amortized O(α(n)) time, where α is the
+// inverse Ackermann function. The parents (32-bit) and the ranks
+// (8-bit, since a rank never exceeds log2(n)) are stored in two flat
+// arrays.
+//
+class DisjointSet {
+public:
+  /**
+   * constructor
+   *
+   * @param size: No. of elements, each of which is a set at first
+   */
+  explicit DisjointSet(size_t size=0) { reset(size); }
+
+  // make each of "size" elements a set
+  void reset(size_t size) {
+    if (size > std::numeric_limits<uint32_t>::max()) {
+      throw std::invalid_argument("Invalid argument: too many elements");
+    }
+    parents_.resize(size);
+    for (size_t i = 0; i < size; ++i) { parents_[i] = (uint32_t)i; }
+    ranks_.assign(size, 0);
+    n_sets_ = size;
+  }
+
+  // get No. of elements
+  size_t size() const { return parents_.size(); }
+
+  // get No. of disjoint sets
+  size_t countSets() const { return n_sets_; }
+
+  // find the root of the set containing v
+  size_t find(size_t v) {
+    // path halving: point every other vertex on the path to its
+    // grandparent, which halves the path in a single pass
+    while (parents_[v] != v) {
+      parents_[v] = parents_[parents_[v]];
+      v = parents_[v];
+    }
+    return v;
+  }
+
+  // whether u and v are in the same set
+  bool sameSet(size_t u, size_t v) { return find(u) == find(v); }
+
+  /**
+   * Merge the sets containing u and v
+   *
+   * @return: false if they are already in the same set
+   */
+  bool unite(size_t u, size_t v) {
+    size_t root_u = find(u);
+    size_t root_v = find(v);
+    if (root_u == root_v) { return false; }
+
+    // the lower tree goes under the higher one
+    if (ranks_[root_u] < ranks_[root_v]) { std::swap(root_u, root_v); }
+    parents_[root_v] = (uint32_t)root_u;
+    if (ranks_[root_u] == ranks_[root_v]) { ++ranks_[root_u]; }
+
+    --n_sets_;
+    return true;
+  }
+
+private:
+  std::vector<uint32_t> parents_;
+  std::vector<uint8_t> ranks_;
+  size_t n_sets_;
+};
+
+//
+// Disjoint sets which can be used by many threads at the same time
+// without locks
+//
+// A root is linked under another root by a compare-and-swap on its
+// parent, which fails if another thread has linked it first; the
+// operation is then retried with the new roots. Roots are linked by
+// index (the larger index goes under the smaller one) instead of by
+// rank, which needs no extra state and keeps the result independent of
+// the order of the threads. Path halving is done with compare-and-swap
+// as well, so a find() never undoes a link made by another thread.
+//
+class ConcurrentDisjointSet {
+public:
+  explicit ConcurrentDisjointSet(size_t size=0) { reset(size); }
+
+  // make each of "size" elements a set (not thread-safe)
+  void reset(size_t size) {
+    if (size > std::numeric_limits<uint32_t>::max()) {
+      throw std::invalid_argument("Invalid argument: too many elements");
+    }
+    // std::atomic is neither copyable nor movable
+    std::vector<std::atomic<uint32_t>> parents(size);
+    parents_.swap(parents);
+    for (size_t i = 0; i < size; ++i) {
+      parents_[i].store((uint32_t)i, std::memory_order_relaxed);
+    }
+  }
+
+  size_t size() const { return parents_.size(); }
+
+  // find the root of the set containing v
+  size_t find(size_t v) {
+    uint32_t parent = parents_[v].load(std::memory_order_acquire);
+    while (parent != v) {
+      uint32_t grandparent = parents_[parent].load(std::memory_order_acquire);
+      if (grandparent != parent) {
+        // it is fine to lose the race: another thread has changed the
+        // parent to something closer to the root
+        uint32_t expected = parent;
+        parents_[v].compare_exchange_weak(expected, grandparent,
+                                          std::memory_order_acq_rel);
+      }
+      v = parent;
+      parent = grandparent;
+    }
+    return v;
+  }
+
+  // whether u and v are in the same set
+  bool sameSet(size_t u, size_t v) {
+    while (true) {
+      size_t root_u = find(u);
+      size_t root_v = find(v);
+      if (root_u == root_v) { return true; }
+      // root_u is still a root, so the sets were different when root_v
+      // was found
+      if (parents_[root_u].load(std::memory_order_acquire) == root_u) {
+        return false;
+      }
+    }
+  }
+
+  /**
+   * Merge the sets containing u and v
+   *
+   * @return: false if they are already in the same set
+   */
+  bool unite(size_t u, size_t v) {
+    while (true) {
+      size_t root_u = find(u);
+      size_t root_v = find(v);
+      if (root_u == root_v) { return false; }
+      if (root_u < root_v) { std::swap(root_u, root_v); }
+
+      uint32_t expected = (uint32_t)root_u;
+      if (parents_[root_u].compare_exchange_strong(expected, (uint32_t)root_v,
+                                                   std::memory_order_acq_rel)) {
+        return true;
+      }
+    }
+  }
+
+private:
+  std::vector<std::atomic<uint32_t>> parents_;
+};
+
+#endif //GRAPH_DISJOINT_SET_H
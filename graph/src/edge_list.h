@@ -0,0 +1,63 @@
+//
+// A flat list of the edges of an undirected graph, which stores each
+// edge only once.
+//
+
+#ifndef GRAPH_EDGE_LIST_H
+#define GRAPH_EDGE_LIST_H
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "undirected_graph.h"
+
+
+template <class T>
+struct WeightedEdge {
+  T weight;
+  uint32_t src;  // the smaller vertex
+  uint32_t dst;  // the larger vertex
+};
+
+//
+// Order the edges by weight, and the ties by their vertices, so that
+// the minimum spanning tree algorithms pick the same tree even if the
+// weights are not distinct
+//
+template <class T>
+bool operator<(const WeightedEdge<T>& e1, const WeightedEdge<T>& e2) {
+  if (e1.weight != e2.weight) { return e1.weight < e2.weight; }
+  if (e1.src != e2.src) { return e1.src < e2.src; }
+  return e1.dst < e2.dst;
+}
+
+/**
+ * Copy out the edges of an undirected graph
+ *
+ * @param graph: undirected graph with less than 2^32 vertices
+ * @return: each edge once as (smaller vertex, larger vertex)
+ */
+template <class T>
+std::vector<WeightedEdge<T>> edgeList(const UndirectedGraph<T>& graph) {
+  if (graph.size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument("Invalid argument: too many vertices");
+  }
+
+  std::vector<WeightedEdge<T>> edges;
+  for (size_t i=0; i<graph.size(); ++i) {
+    graph::Edge<T>* current_edge = graph.getList(i);
+    while (current_edge != nullptr) {
+      if (i < current_edge->dst) {
+        edges.push_back({current_edge->weight, (uint32_t)i,
+                         (uint32_t)current_edge->dst});
+      }
+      current_edge = current_edge->next;
+    }
+  }
+
+  return edges;
+}
+
+#endif //GRAPH_EDGE_LIST_H
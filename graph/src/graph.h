@@ -93,6 +93,35 @@ protected:
     return true;
   }
 
+  /**
+   * Add an edge (src->dst), which is known not to exist, at the head of
+   * the linked list
+   *
+   * Unlike addEdge(), it does not scan the list for the edge, so it
+   * takes O(1) time instead of O(degree).
+   *
+   * @param src: source vertex
+   * @param dst: destination vertex (not src)
+   * @param weight: edge weight
+   */
+  void prependEdge(size_t src, size_t dst, T weight) {
+    if ( src >= vertices_.size() ) {
+      throw std::invalid_argument("Out of range: src vertex");
+    }
+
+    if ( dst >= vertices_.size() ) {
+      throw std::invalid_argument("Out of range: dst vertex");
+    }
+
+    if ( src == dst ) {
+      throw std::invalid_argument("Invalid argument: self-loop");
+    }
+
+    graph::Edge<T>* new_edge = graph::newEdge(dst, weight);
+    new_edge->next = vertices_[src];
+    vertices_[src] = new_edge;
+  }
+
   /**
    * Delete an edge (src->dst)
    *
@@ -109,15 +138,18 @@ protected:
       throw std::invalid_argument("Out of range: dst vertex");
     }
 
-    graph::Edge<T>* current_edge = vertices_[src];
-    graph::Edge<T>* previous_edge = current_edge;
-    while (current_edge != nullptr) {
+    // "link" points to the pointer to the current edge, which is either
+    // the head of the list or the "next" of the previous edge
+    graph::Edge<T>** link = &vertices_[src];
+    while (*link != nullptr) {
+      graph::Edge<T>* current_edge = *link;
       if (current_edge->dst == dst) {
-        previous_edge->next = current_edge->next;
-        return current_edge->weight;
+        *link = current_edge->next;
+        T weight = current_edge->weight;
+        delete current_edge;
+        return weight;
       }
-      previous_edge = current_edge;
-      current_edge = current_edge->next;
+      link = &current_edge->next;
     }
 
     // src and dst are not connected
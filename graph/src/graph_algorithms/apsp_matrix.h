@@ -0,0 +1,204 @@
+//
+// The V x V result of the all-pair shortest path algorithms, stored in
+// one contiguous row-major buffer in RAM or in a memory-mapped file.
+//
+
+#ifndef GRAPH_APSP_MATRIX_H
+#define GRAPH_APSP_MATRIX_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../mapped_file.h"
+#include "../parallel.h"
+
+
+// a read-only view of a row of contiguous values
+template <class T>
+class MatrixRow {
+public:
+  MatrixRow(const T* first, size_t size) : first_(first), size_(size) {}
+
+  size_t size() const { return size_; }
+  const T* begin() const { return first_; }
+  const T* end() const { return first_ + size_; }
+  const T& operator[](size_t i) const { return first_[i]; }
+
+private:
+  const T* first_;
+  size_t size_;
+};
+
+template <class T>
+class ApspMatrix {
+public:
+  // the cost of a pair of vertices which are not connected, which is
+  // the same as the INF of SearchWorkspace and of Floyd-Warshall
+  static T infinity() { return (T)(std::numeric_limits<T>::max()/2.0); }
+
+  /**
+   * constructor
+   *
+   * All the costs are infinity() at first.
+   *
+   * @param size: No. of vertices
+   * @param path: if not empty, the matrix is stored in this memory-mapped
+   *              file instead of RAM, and the file holds the raw costs
+   *              as johnsonToFile() writes them
+   */
+  explicit ApspMatrix(size_t size, const std::string& path="")
+      : size_(size), writable_(true) {
+    if (path.empty()) {
+      buffer_.assign(size*size, infinity());
+      data_ = buffer_.data();
+    } else {
+      file_.reset(new MappedFile(path, size*size*sizeof(T)));
+      data_ = static_cast<T*>(file_->data());
+      std::fill(data_, data_ + size*size, infinity());
+    }
+  }
+
+  // take over a row-major V x V buffer, e.g. from floydWarshallBlocked()
+  explicit ApspMatrix(std::vector<T>&& costs)
+      : size_((size_t)std::sqrt((double)costs.size())), writable_(true),
+        buffer_(std::move(costs)) {
+    if (size_*size_ != buffer_.size()) {
+      throw std::invalid_argument("Invalid argument: not a square matrix");
+    }
+    data_ = buffer_.data();
+  }
+
+  ApspMatrix(const ApspMatrix&) = delete;
+  ApspMatrix& operator=(const ApspMatrix&) = delete;
+  ApspMatrix(ApspMatrix&&) = default;
+
+  /**
+   * Map a file written by johnsonToFile() or by a file-backed matrix
+   * for reading only
+   *
+   * @param path: file path
+   * @throw: std::invalid_argument if the file is not a V x V matrix
+   */
+  static ApspMatrix open(const std::string& path) {
+    std::unique_ptr<MappedFile> file(new MappedFile(path));
+    size_t n_costs = file->size()/sizeof(T);
+    size_t size = (size_t)std::sqrt((double)n_costs);
+    if (file->size()%sizeof(T) != 0 || size*size != n_costs) {
+      throw std::invalid_argument("Invalid argument: not a cost matrix file");
+    }
+    return ApspMatrix(size, std::move(file));
+  }
+
+  // get No. of vertices
+  size_t size() const { return size_; }
+
+  // get the raw row-major costs
+  const T* data() const { return data_; }
+  T* data() {
+    if (!writable_) {
+      throw std::invalid_argument("Invalid operation: the matrix is read-only");
+    }
+    return data_;
+  }
+
+  // get the smallest cost from src to dst
+  T dist(size_t src, size_t dst) const {
+    if ( src >= size_ || dst >= size_ ) {
+      throw std::out_of_range("Out of range: vertex");
+    }
+    return data_[src*size_ + dst];
+  }
+
+  // whether dst can be reached from src
+  bool reachable(size_t src, size_t dst) const { return dist(src, dst) < infinity(); }
+
+  // get the smallest costs from src
+  MatrixRow<T> row(size_t src) const {
+    if ( src >= size_ ) { throw std::out_of_range("Out of range: vertex"); }
+    return MatrixRow<T>(data_ + src*size_, size_);
+  }
+
+  // set the smallest costs from src, e.g. from a row handler of johnson()
+  void setRow(size_t src, const std::vector<T>& costs) {
+    if ( src >= size_ ) { throw std::out_of_range("Out of range: vertex"); }
+    if (costs.size() != size_) {
+      throw std::invalid_argument("Invalid argument: wrong row size");
+    }
+    std::copy(costs.begin(), costs.end(), data() + src*size_);
+  }
+
+  /**
+   * Get the smallest cost over all the pairs ("the shortest shortest
+   * path"), which is at most 0 because of the diagonal
+   *
+   * @param n_threads: No. of threads (0 for the hardware default)
+   */
+  T min(size_t n_threads=0) const {
+    return reduce(n_threads, infinity(), [](T best, T cost) {
+      return cost < best ? cost : best;
+    });
+  }
+
+  /**
+   * Get the largest cost over the pairs which are connected (the
+   * diameter for non-negative weights)
+   *
+   * @param n_threads: No. of threads (0 for the hardware default)
+   */
+  T max(size_t n_threads=0) const {
+    const T inf = infinity();
+    return reduce(n_threads, std::numeric_limits<T>::lowest(), [inf](T best, T cost) {
+      return (cost < inf && cost > best) ? cost : best;
+    });
+  }
+
+  // flush a file-backed matrix to the file
+  void sync() {
+    if (file_ && writable_) { file_->sync(); }
+  }
+
+private:
+  size_t size_;
+  bool writable_;
+  std::vector<T> buffer_;
+  std::unique_ptr<MappedFile> file_;
+  T* data_;  // points to buffer_ or the mapped file
+
+  ApspMatrix(size_t size, std::unique_ptr<MappedFile> file)
+      : size_(size), writable_(false), file_(std::move(file)) {
+    data_ = static_cast<T*>(file_->data());
+  }
+
+  // Each range is reduced by a plain loop over contiguous memory with
+  // a branch-free body, which the compiler vectorizes (for 64-bit costs
+  // with GRAPH_NATIVE_ARCH), and the results of the threads are then
+  // combined.
+  template <class Combine>
+  T reduce(size_t n_threads, T identity, Combine combine) const {
+    const size_t n = size_*size_;
+    const T* data = data_;
+    if (n_threads == 0) { n_threads = graph_parallel::defaultThreadCount(); }
+    // threads only pay off for large matrices
+    if (n < (1 << 20)) { n_threads = 1; }
+
+    std::vector<T> partials(n_threads, identity);
+    graph_parallel::parallelForRange(n, n_threads,
+                                     [&](size_t thread_id, size_t begin, size_t end) {
+      T best = partials[thread_id];
+      for (size_t i = begin; i < end; ++i) { best = combine(best, data[i]); }
+      partials[thread_id] = best;
+    });
+
+    T best = identity;
+    for (auto partial : partials) { best = combine(best, partial); }
+    return best;
+  }
+};
+
+
+#endif //GRAPH_APSP_MATRIX_H
@@ -0,0 +1,137 @@
+//
+// Answer a batch of point-to-point shortest path queries with one
+// truncated Dijkstra search per distinct source.
+//
+
+#ifndef GRAPH_BATCH_SHORTEST_PATH_H
+#define GRAPH_BATCH_SHORTEST_PATH_H
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../graph.h"
+#include "../parallel.h"
+#include "dijkstra.h"
+#include "search_workspace.h"
+
+
+//
+// Statistics of a batch of queries
+//
+struct BatchQueryStats {
+  size_t n_queries = 0;
+  size_t n_sources = 0;  // No. of distinct sources, i.e. searches
+  size_t n_settled = 0;  // No. of vertices settled by all the searches
+  double group_time = 0;  // wall time of grouping the queries in ms
+  double search_time = 0;  // wall time of all the searches in ms
+  double max_source_time = 0;  // the longest search in ms
+};
+
+/**
+ * Smallest costs of a batch of (src, dst) queries
+ *
+ * The queries are grouped by source. For each distinct source a single
+ * Dijkstra search runs until all the destinations of its queries are
+ * settled, so repeated sources do not repeat any work and a search
+ * never explores beyond its farthest destination. The searches run on
+ * a pool of threads, each of which owns a search workspace.
+ *
+ * @param graph: a directed/undirected graph with non-negative weights
+ * @param queries: (src, dst) pairs
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param stats: optional statistics of the batch on return
+ * @return: the smallest cost of each query in the input order
+ *          (SearchWorkspace<T>::infinity() if dst cannot be reached)
+ */
+template <class T>
+std::vector<T>
+dijkstraBatch(const Graph<T>& graph,
+              const std::vector<std::pair<size_t, size_t>>& queries,
+              size_t n_threads=0, BatchQueryStats* stats=nullptr) {
+  typedef std::chrono::steady_clock clock;
+  auto elapsed = [](clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+  };
+
+  for (const auto& query : queries) {
+    if ( query.first >= graph.size() ) {
+      throw std::out_of_range("Out of range: source");
+    }
+    if ( query.second >= graph.size() ) {
+      throw std::out_of_range("Out of range: destination");
+    }
+  }
+
+  // sort the query indices by source and split them into groups
+  auto t_group = clock::now();
+  std::vector<size_t> order(queries.size());
+  for (size_t q = 0; q < order.size(); ++q) { order[q] = q; }
+  std::sort(order.begin(), order.end(), [&queries](size_t a, size_t b) {
+    return queries[a].first < queries[b].first;
+  });
+
+  // queries of the g-th source are order[group_begin[g], group_begin[g + 1])
+  std::vector<size_t> group_begin;
+  for (size_t q = 0; q < order.size(); ++q) {
+    if (q == 0 || queries[order[q]].first != queries[order[q - 1]].first) {
+      group_begin.push_back(q);
+    }
+  }
+  const size_t n_groups = group_begin.size();
+  group_begin.push_back(order.size());
+  double group_time = elapsed(t_group);
+
+  // run one search for each source
+  auto t_search = clock::now();
+  if (n_threads == 0) { n_threads = graph_parallel::defaultThreadCount(); }
+  std::vector<SearchWorkspace<T>> workspaces(n_threads);
+  std::vector<size_t> n_settled(n_threads, 0);
+  std::vector<double> max_source_time(n_threads, 0);
+  std::vector<T> costs(queries.size());
+
+  graph_parallel::parallelFor(n_groups, n_threads,
+                              [&](size_t thread_id, size_t g) {
+    auto t_source = clock::now();
+    SearchWorkspace<T>& workspace = workspaces[thread_id];
+    const size_t src = queries[order[group_begin[g]]].first;
+
+    // the search stops when the last distinct destination is settled
+    size_t n_targets = 0;
+    workspace.clearTargets(graph.size());
+    for (size_t q = group_begin[g]; q < group_begin[g + 1]; ++q) {
+      if (workspace.markTarget(queries[order[q]].second)) { ++n_targets; }
+    }
+    dijkstraSearch(graph, src, workspace, [&](size_t v, T) {
+      return !workspace.isTarget(v) || --n_targets > 0;
+    });
+
+    // either all the destinations are settled or the search has
+    // explored every reachable vertex, so the costs are final
+    for (size_t q = group_begin[g]; q < group_begin[g + 1]; ++q) {
+      costs[order[q]] = workspace.cost(queries[order[q]].second);
+    }
+
+    n_settled[thread_id] += workspace.settled().size();
+    max_source_time[thread_id] = std::max(max_source_time[thread_id],
+                                          elapsed(t_source));
+  });
+
+  if (stats != nullptr) {
+    stats->n_queries = queries.size();
+    stats->n_sources = n_groups;
+    stats->n_settled = 0;
+    for (auto n : n_settled) { stats->n_settled += n; }
+    stats->group_time = group_time;
+    stats->search_time = elapsed(t_search);
+    stats->max_source_time = *std::max_element(max_source_time.begin(),
+                                               max_source_time.end());
+  }
+
+  return costs;
+}
+
+
+#endif //GRAPH_BATCH_SHORTEST_PATH_H
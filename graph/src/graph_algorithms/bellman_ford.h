@@ -6,53 +6,108 @@
 #define GRAPH_BELLMAN_FORD_H
 
 #include <iostream>
+#include <deque>
 #include <vector>
 #include <limits>
+#include <stdexcept>
 
 #include "../directed_graph.h"
+#include "search_workspace.h"
+#include "../graph_stats.h"
 
 
+// thrown when a negative cycle is found, with the offending cycle
+class NegativeCycleError : public std::invalid_argument {
+public:
+  explicit NegativeCycleError(const std::deque<size_t>& cycle)
+      : std::invalid_argument("Found negative cycle in the graph!"),
+        cycle_(cycle) {}
+
+  // vertices of the cycle in the direction of its edges
+  const std::deque<size_t>& cycle() const { return cycle_; }
+
+private:
+  std::deque<size_t> cycle_;
+};
+
 /**
- * Bellman-Ford's shorted path algorithm
+ * Collect the cycle of previous vertices which contains a vertex
  *
- * Time complexity O(VE)
- *
- * @param graph: a directed graph
- * @param src: the source vertex
- * @return: a pair of two deques: the first one stores the smallest
- *          cost of each vertex; the second one stores the previous
- *          vertex of each vertex in the shortest path.
+ * @param workspace: search workspace
+ * @param v: a vertex on a cycle of the previous vertices
+ * @return: vertices of the cycle in the direction of its edges
  */
 template <class T>
-std::pair<std::deque<T>, std::deque<size_t>>
-bellmanFord(const DirectedGraph<T>& graph, size_t src) {
-  if ( src < 0 || src >= graph.size() ) {
-    throw std::out_of_range("Out of range: source");
-  }
+std::deque<size_t> collectCycle(const SearchWorkspace<T>& workspace, size_t v) {
+  std::deque<size_t> cycle;
+  size_t u = v;
+  do {
+    cycle.push_front(u);
+    u = workspace.cameFrom(u);
+  } while (u != v);
 
-  T kMaxCost = (T)(std::numeric_limits<T>::max()/2.0);
+  return cycle;
+}
 
-  // actual minimum cost to the source so far
-  std::deque<T> costs(graph.size(), kMaxCost);
-  // the previous point that allows to achieve the minimum cost so far
-  std::deque<size_t> came_from(graph.size());
+/**
+ * Look for a cycle in the graph of the previous vertices.
+ *
+ * Every cycle formed by the previous vertices during the relaxation
+ * is a negative cycle. Time complexity O(V).
+ *
+ * @param workspace: search workspace
+ * @param walk: scratch memory for the walks, resized to the No. of
+ *              vertices
+ * @return: the cycle found (empty if there is no cycle)
+ */
+template <class T>
+std::deque<size_t> findParentCycle(const SearchWorkspace<T>& workspace,
+                                   std::vector<size_t>& walk) {
+  // walk[v] is 1 + the index of the walk which first visited v
+  walk.assign(workspace.size(), 0);
 
-  costs[src] = 0;
-  came_from[src] = src;
+  size_t id = 0;
+  for (auto v : workspace.touched()) {
+    ++id;
+    // walk to the root until reaching a vertex visited before
+    while (walk[v] == 0) {
+      walk[v] = id;
+      if (workspace.cameFrom(v) == v) { break; }  // a root
+      v = workspace.cameFrom(v);
+    }
+    if (walk[v] == id && workspace.cameFrom(v) != v) {
+      return collectCycle(workspace, v);
+    }
+  }
+
+  return {};
+}
 
+/**
+ * Run the Bellman-Ford's iterations from the vertices which have
+ * already been reached in the workspace.
+ *
+ * Time complexity O(VE)
+ *
+ * @param graph: a directed graph
+ * @param workspace: search workspace holding the initial costs, which
+ *                   stores the smallest costs on return
+ */
+template <class T>
+void bellmanFordIterate(const DirectedGraph<T>& graph,
+                        SearchWorkspace<T>& workspace) {
   // If there is no negative directed cycle, the minimum path from vertex
   // u to v will contain at most [V - 1] edges.
-  for (size_t count = 0; count < graph.size() - 1; ++count) {
+  for (size_t count = 0; count + 1 < graph.size(); ++count) {
+    graph_stats::count(&SearchStats::rounds);
     for (size_t edge_src=0; edge_src < graph.size(); ++edge_src) {
+      // vertices which have not been reached cannot relax any edge
+      if (!workspace.reached(edge_src)) { continue; }
+
       graph::Edge<T>* current_edge = graph.getList(edge_src);
       while (current_edge != nullptr) {
-        size_t edge_dst = current_edge->dst;
-
-        T new_cost = costs[edge_src] + current_edge->weight;
-        if (costs[edge_dst] > new_cost) {
-          costs[edge_dst] = new_cost;
-          came_from[edge_dst] = edge_src;
-        }
+        T new_cost = workspace.cost(edge_src) + current_edge->weight;
+        workspace.relax(current_edge->dst, new_cost, edge_src);
 
         current_edge = current_edge->next;
       }
@@ -61,19 +116,224 @@ bellmanFord(const DirectedGraph<T>& graph, size_t src) {
 
   // check negative cycles
   for (size_t edge_src=0; edge_src < graph.size(); ++edge_src) {
+    if (!workspace.reached(edge_src)) { continue; }
+
     graph::Edge<T>* current_edge = graph.getList(edge_src);
     while (current_edge != nullptr) {
       T weight = current_edge->weight;
 
-      if (costs[edge_src] + weight < costs[current_edge->dst]) {
-        throw std::invalid_argument("Found negative cycle in the graph!");
+      if (workspace.cost(edge_src) + weight < workspace.cost(current_edge->dst)) {
+        // After one more relaxation, walking back V steps from the
+        // vertex must end up on the cycle.
+        size_t v = current_edge->dst;
+        workspace.set(v, workspace.cost(edge_src) + weight, edge_src);
+        for (size_t count = 0; count < graph.size(); ++count) {
+          v = workspace.cameFrom(v);
+        }
+        throw NegativeCycleError(collectCycle(workspace, v));
+      }
+
+      current_edge = current_edge->next;
+    }
+  }
+}
+
+/**
+ * Queue-based Bellman-Ford's iterations (a.k.a. SPFA) from the
+ * vertices which have already been reached in the workspace.
+ *
+ * Only the vertices whose cost changed are scanned again, so the search
+ * stops as soon as a round makes no update. A vertex whose new cost is
+ * smaller than the cost at the front of the queue jumps the queue
+ * (small label first). After every V relaxations the graph of the
+ * previous vertices is checked for a cycle (amortized O(1) per
+ * relaxation), which detects negative cycles long before the V - 1
+ * rounds are finished.
+ *
+ * Time complexity O(VE) in the worst case
+ *
+ * @param graph: a directed graph
+ * @param workspace: search workspace holding the initial costs, which
+ *                   stores the smallest costs on return
+ * @return: the vertices of a negative cycle in the direction of its
+ *          edges (empty if there is no negative cycle)
+ */
+template <class T>
+std::deque<size_t> bellmanFordQueueIterate(const DirectedGraph<T>& graph,
+                                           SearchWorkspace<T>& workspace) {
+  std::deque<size_t> open_set(workspace.touched().begin(),
+                              workspace.touched().end());
+  std::vector<bool> in_queue(graph.size(), false);
+  for (auto v : open_set) { in_queue[v] = true; }
+  graph_stats::count(&SearchStats::pushes, open_set.size());
+
+  std::vector<size_t> walk;
+  size_t relaxations = 0;
+  while (!open_set.empty()) {
+    size_t pick = open_set.front();
+    open_set.pop_front();
+    in_queue[pick] = false;
+    graph_stats::count(&SearchStats::pops);
+
+    graph::Edge<T>* current_edge = graph.getList(pick);
+    while (current_edge != nullptr) {
+      size_t edge_dst = current_edge->dst;
+      T new_cost = workspace.cost(pick) + current_edge->weight;
+
+      if (workspace.relax(edge_dst, new_cost, pick)) {
+        if (++relaxations == graph.size()) {
+          relaxations = 0;
+          std::deque<size_t> cycle = findParentCycle(workspace, walk);
+          if (!cycle.empty()) { return cycle; }
+        }
+
+        if (!in_queue[edge_dst]) {
+          in_queue[edge_dst] = true;
+          graph_stats::count(&SearchStats::pushes);
+          if (!open_set.empty() && new_cost < workspace.cost(open_set.front())) {
+            open_set.push_front(edge_dst);
+          } else {
+            open_set.push_back(edge_dst);
+          }
+        }
       }
 
       current_edge = current_edge->next;
     }
   }
 
-  return std::make_pair(costs, came_from);
+  return {};
+}
+
+/**
+ * Bellman-Ford's shorted path algorithm which keeps its state in a
+ * reusable workspace.
+ *
+ * Time complexity O(VE)
+ *
+ * @param graph: a directed graph
+ * @param src: the source vertex
+ * @param workspace: search workspace which stores the costs and the
+ *                   previous vertices on return
+ */
+template <class T>
+void bellmanFord(const DirectedGraph<T>& graph, size_t src,
+                 SearchWorkspace<T>& workspace) {
+  if ( src < 0 || src >= graph.size() ) {
+    throw std::out_of_range("Out of range: source");
+  }
+
+  workspace.reset(graph.size());
+  workspace.set(src, 0, src);
+
+  bellmanFordIterate(graph, workspace);
+}
+
+/**
+ * Bellman-Ford's shorted path algorithm from a virtual source, which
+ * is connected to every vertex by a zero-weight edge.
+ *
+ * The virtual source is never added to the graph: every vertex simply
+ * starts with zero cost. The result is the vertex potential used by
+ * Johnson's algorithm.
+ *
+ * Time complexity O(VE) in the worst case (queue-based)
+ *
+ * @param graph: a directed graph
+ * @param workspace: search workspace which stores the costs on return.
+ *                   A vertex whose cost is zero came from itself.
+ */
+template <class T>
+void bellmanFordVirtualSource(const DirectedGraph<T>& graph,
+                              SearchWorkspace<T>& workspace) {
+  workspace.reset(graph.size());
+  for (size_t i=0; i<graph.size(); ++i) { workspace.set(i, 0, i); }
+
+  std::deque<size_t> cycle = bellmanFordQueueIterate(graph, workspace);
+  if (!cycle.empty()) { throw NegativeCycleError(cycle); }
+}
+
+/**
+ * Bellman-Ford's shorted path algorithm
+ *
+ * Time complexity O(VE)
+ *
+ * @param graph: a directed graph
+ * @param src: the source vertex
+ * @return: a pair of two deques: the first one stores the smallest
+ *          cost of each vertex; the second one stores the previous
+ *          vertex of each vertex in the shortest path.
+ */
+template <class T>
+std::pair<std::deque<T>, std::deque<size_t>>
+bellmanFord(const DirectedGraph<T>& graph, size_t src) {
+  SearchWorkspace<T> workspace(graph.size());
+  bellmanFord(graph, src, workspace);
+
+  return workspace.toDeque();
+}
+
+/**
+ * Queue-based Bellman-Ford's shorted path algorithm (SPFA) which keeps
+ * its state in a reusable workspace.
+ *
+ * Time complexity O(VE) in the worst case
+ *
+ * @param graph: a directed graph
+ * @param src: the source vertex
+ * @param workspace: search workspace which stores the costs and the
+ *                   previous vertices on return
+ * @throw NegativeCycleError: if a negative cycle is reachable from src
+ */
+template <class T>
+void bellmanFordQueue(const DirectedGraph<T>& graph, size_t src,
+                      SearchWorkspace<T>& workspace) {
+  if ( src < 0 || src >= graph.size() ) {
+    throw std::out_of_range("Out of range: source");
+  }
+
+  workspace.reset(graph.size());
+  workspace.set(src, 0, src);
+
+  std::deque<size_t> cycle = bellmanFordQueueIterate(graph, workspace);
+  if (!cycle.empty()) { throw NegativeCycleError(cycle); }
+}
+
+/**
+ * Queue-based Bellman-Ford's shorted path algorithm (SPFA)
+ *
+ * Time complexity O(VE) in the worst case
+ *
+ * @param graph: a directed graph
+ * @param src: the source vertex
+ * @return: a pair of two deques: the first one stores the smallest
+ *          cost of each vertex; the second one stores the previous
+ *          vertex of each vertex in the shortest path.
+ * @throw NegativeCycleError: if a negative cycle is reachable from src
+ */
+template <class T>
+std::pair<std::deque<T>, std::deque<size_t>>
+bellmanFordQueue(const DirectedGraph<T>& graph, size_t src) {
+  SearchWorkspace<T> workspace(graph.size());
+  bellmanFordQueue(graph, src, workspace);
+
+  return workspace.toDeque();
+}
+
+/**
+ * Find a negative cycle anywhere in the graph
+ *
+ * @param graph: a directed graph
+ * @return: the vertices of a negative cycle in the direction of its
+ *          edges (empty if the graph has no negative cycle)
+ */
+template <class T>
+std::deque<size_t> findNegativeCycle(const DirectedGraph<T>& graph) {
+  SearchWorkspace<T> workspace(graph.size());
+  workspace.reset(graph.size());
+  for (size_t i=0; i<graph.size(); ++i) { workspace.set(i, 0, i); }
+
+  return bellmanFordQueueIterate(graph, workspace);
 }
 
 #endif //GRAPH_BELLMAN_FORD_H
\ No newline at end of file
@@ -0,0 +1,139 @@
+#ifndef GRAPH_BORUVKA_H
+#define GRAPH_BORUVKA_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../disjoint_set.h"
+#include "../edge_list.h"
+#include "../parallel.h"
+#include "../undirected_graph.h"
+
+
+//
+// Implementation of the Borůvka's minimum spanning tree algorithm on a
+// pool of threads
+//
+// In each round every component picks its lightest outgoing edge, and
+// the components are merged along these edges, which at least halves
+// the No. of components. Hence there are at most log2(V) rounds of
+// O(E) work each, and every step of a round is parallel:
+//
+//   1. label each vertex with the root of its component;
+//   2. for each edge between two components, lower the lightest edge
+//      of both components with an atomic compare-and-swap;
+//   3. merge the components along the picked edges with the
+//      concurrent disjoint set;
+//   4. drop the edges inside a component.
+//
+// Edges are compared by (weight, smaller vertex, larger vertex), a
+// strict total order even if weights are equal, so the picked edges
+// never form a cycle and the tree is the same as kruskal()'s.
+//
+// @param graph: undirected graph object
+// @param n_threads: No. of threads (0 for the hardware default)
+//
+// @return: a pair in which the first element is the total cost of
+//          the minimum spanning tree while the second one is a
+//          vector of the edges (<smaller vertex, larger vertex>) in
+//          the tree in the same order as kruskal().
+//
+template <class T> std::pair<T, std::vector<std::pair<size_t, size_t>>>
+boruvka(const UndirectedGraph<T>& graph, size_t n_threads=0) {
+  const uint64_t kNone = std::numeric_limits<uint64_t>::max();
+  const size_t n = graph.size();
+  if (n_threads == 0) { n_threads = graph_parallel::defaultThreadCount(); }
+
+  std::vector<WeightedEdge<T>> edges = edgeList(graph);
+  ConcurrentDisjointSet components(n);
+  std::vector<uint32_t> labels(n);
+  std::vector<std::atomic<uint64_t>> lightest(n);  // index of the edge
+  std::vector<std::vector<WeightedEdge<T>>> picked(n_threads);
+
+  size_t n_mst_edges = 0;
+  while (!edges.empty() && n_mst_edges + 1 < n) {
+    // 1. labels
+    graph_parallel::parallelForRange(n, n_threads,
+                                     [&](size_t, size_t begin, size_t end) {
+      for (size_t v = begin; v < end; ++v) {
+        labels[v] = (uint32_t)components.find(v);
+        lightest[v].store(kNone, std::memory_order_relaxed);
+      }
+    });
+
+    // 2. the lightest edge of each component
+    auto lower = [&edges](std::atomic<uint64_t>& best, uint64_t e) {
+      uint64_t current = best.load(std::memory_order_relaxed);
+      while ((current == kNone || edges[e] < edges[current]) &&
+             !best.compare_exchange_weak(current, e, std::memory_order_relaxed)) {}
+    };
+    graph_parallel::parallelForRange(edges.size(), n_threads,
+                                     [&](size_t, size_t begin, size_t end) {
+      for (size_t e = begin; e < end; ++e) {
+        lower(lightest[labels[edges[e].src]], e);
+        lower(lightest[labels[edges[e].dst]], e);
+      }
+    });
+
+    // 3. merge along the picked edges. Two components may pick the same
+    // edge, which only joins them once.
+    graph_parallel::parallelForRange(n, n_threads,
+                                     [&](size_t thread_id, size_t begin, size_t end) {
+      for (size_t v = begin; v < end; ++v) {
+        uint64_t e = lightest[v].load(std::memory_order_relaxed);
+        if (e != kNone && components.unite(edges[e].src, edges[e].dst)) {
+          picked[thread_id].push_back(edges[e]);
+        }
+      }
+    });
+    n_mst_edges = 0;
+    for (const auto& p : picked) { n_mst_edges += p.size(); }
+
+    // 4. compact each range of edges in parallel, then move the ranges
+    // together
+    const size_t n_ranges = std::min(edges.size(), n_threads);
+    std::vector<size_t> bounds(n_ranges + 1), kept(n_ranges);
+    for (size_t k = 0; k <= n_ranges; ++k) { bounds[k] = edges.size()*k/n_ranges; }
+    graph_parallel::parallelFor(n_ranges, n_threads, [&](size_t, size_t k) {
+      auto range_end = std::remove_if(edges.begin() + bounds[k], edges.begin() + bounds[k + 1],
+                                      [&components](const WeightedEdge<T>& e) {
+        return components.find(e.src) == components.find(e.dst);
+      });
+      kept[k] = (size_t)(range_end - (edges.begin() + bounds[k]));
+    });
+    size_t n_kept = 0;
+    for (size_t k = 0; k < n_ranges; ++k) {
+      // n_kept <= bounds[k], and std::move() must not move a range onto itself
+      if (n_kept != bounds[k]) {
+        std::move(edges.begin() + bounds[k], edges.begin() + bounds[k] + kept[k],
+                  edges.begin() + n_kept);
+      }
+      n_kept += kept[k];
+    }
+    edges.resize(n_kept);
+  }
+
+  if ( n_mst_edges + 1 < n ) {
+    throw std::invalid_argument("Input graph is not connected!");
+  }
+
+  // in the same order as kruskal()
+  std::vector<WeightedEdge<T>> tree;
+  for (const auto& p : picked) { tree.insert(tree.end(), p.begin(), p.end()); }
+  std::sort(tree.begin(), tree.end());
+
+  std::vector<std::pair<size_t, size_t>> mst;
+  T cost = 0;
+  for (const auto& e : tree) {
+    mst.push_back(std::make_pair(e.src, e.dst));
+    cost += e.weight;
+  }
+  return std::make_pair(cost, mst);
+}
+
+
+#endif //GRAPH_BORUVKA_H
@@ -5,9 +5,13 @@
 #ifndef GRAPH_BREATH_FIRST_SEARCH_H
 #define GRAPH_BREATH_FIRST_SEARCH_H
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
 #include "../graph.h"
+#include "../compressed_graph.h"
 
 
 /**
@@ -49,4 +53,105 @@ std::vector<size_t> breathFirstSearch(const Graph<T>& graph, size_t src) {
   return search;
 }
 
+// the distance of a vertex which cannot be reached
+const size_t kUnreachedDistance = std::numeric_limits<size_t>::max();
+
+/**
+ * No. of edges on the shortest path (ignoring the weights) from a
+ * vertex to each vertex
+ *
+ * The search expands a whole level at a time, which is also how the
+ * sharded BFS works, so the two can be compared level by level.
+ *
+ * @param graph: graph object
+ * @param src: the source vertex
+ * @return: the hop distance of each vertex (kUnreachedDistance if it
+ *          cannot be reached from src)
+ */
+template <class T>
+std::vector<size_t> bfsDistance(const Graph<T>& graph, size_t src) {
+  if ( src >= graph.size() ) {
+    throw std::out_of_range("Out of range: src");
+  }
+
+  std::vector<size_t> distances(graph.size(), kUnreachedDistance);
+  std::vector<size_t> frontier {src};
+  std::vector<size_t> next;
+  distances[src] = 0;
+  for (size_t level = 1; !frontier.empty(); ++level) {
+    next.clear();
+    for (auto u : frontier) {
+      for (graph::Edge<T>* e = graph.getList(u); e != nullptr; e = e->next) {
+        if (distances[e->dst] == kUnreachedDistance) {
+          distances[e->dst] = level;
+          next.push_back(e->dst);
+        }
+      }
+    }
+    frontier.swap(next);
+  }
+
+  return distances;
+}
+
+//
+// Breadth-first-search on a compressed graph, where the neighbors of a
+// vertex are visited in ascending order
+//
+inline std::vector<size_t> breathFirstSearch(const CompressedGraph& graph, size_t src) {
+  if ( src >= graph.size() ) {
+    throw std::out_of_range("Out of range: src");
+  }
+
+  std::vector<size_t> search {src};
+  std::vector<bool> visited (graph.size(), false);
+  std::vector<uint32_t> neighbors;
+  visited[src] = true;
+  // the visited vertices are also the queue
+  for (size_t head = 0; head < search.size(); ++head) {
+    neighbors.resize(std::max<size_t>(neighbors.size(), graph.degree(search[head])));
+    size_t degree = graph.decodeNeighbors(search[head], neighbors.data());
+    for (size_t i = 0; i < degree; ++i) {
+      if ( !visited[neighbors[i]] ) {
+        visited[neighbors[i]] = true;
+        search.push_back(neighbors[i]);
+      }
+    }
+  }
+
+  return search;
+}
+
+//
+// Hop distances on a compressed graph, the same as bfsDistance() on
+// the graph it was built from
+//
+inline std::vector<size_t> bfsDistance(const CompressedGraph& graph, size_t src) {
+  if ( src >= graph.size() ) {
+    throw std::out_of_range("Out of range: src");
+  }
+
+  std::vector<size_t> distances(graph.size(), kUnreachedDistance);
+  std::vector<uint32_t> frontier {(uint32_t)src};
+  std::vector<uint32_t> next;
+  std::vector<uint32_t> neighbors;
+  distances[src] = 0;
+  for (size_t level = 1; !frontier.empty(); ++level) {
+    next.clear();
+    for (auto u : frontier) {
+      neighbors.resize(std::max<size_t>(neighbors.size(), graph.degree(u)));
+      size_t degree = graph.decodeNeighbors(u, neighbors.data());
+      for (size_t i = 0; i < degree; ++i) {
+        if (distances[neighbors[i]] == kUnreachedDistance) {
+          distances[neighbors[i]] = level;
+          next.push_back(neighbors[i]);
+        }
+      }
+    }
+    frontier.swap(next);
+  }
+
+  return distances;
+}
+
 #endif //GRAPH_BREATH_FIRST_SEARCH_H
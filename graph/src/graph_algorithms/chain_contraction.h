@@ -0,0 +1,500 @@
+//
+// Contraction of the chains of degree-2 vertices and the trees of
+// degree-1 vertices of a sparse (e.g. road-like) graph, so that the
+// single source shortest path algorithms only run on the remaining
+// core, whose edges are the shortcuts of the chains.
+//
+// The degree of a vertex is its No. of distinct neighbors, following
+// the edges in both directions:
+// - the trees are peeled off by removing the vertices of degree 1
+//   repeatedly, each of which hangs from its only neighbor (parent);
+// - a remaining vertex of degree 2 is on a chain between two core
+//   vertices (or on a cycle, one vertex of which is kept in the core);
+// - the chain a -> ... -> b gives the shortcut a -> b of the chain's
+//   total weight (if all its edges point that way), and likewise b -> a.
+//
+// The costs of the other vertices are restored from the core costs in
+// one pass over the chains and the trees.
+//
+
+#ifndef GRAPH_CHAIN_CONTRACTION_H
+#define GRAPH_CHAIN_CONTRACTION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../graph.h"
+#include "../directed_graph.h"
+#include "search_workspace.h"
+#include "dijkstra.h"
+#include "bellman_ford.h"
+
+
+template <class T>
+class ChainContraction {
+public:
+  /**
+   * constructor
+   *
+   * Time complexity O(V + ElogE)
+   *
+   * @param graph: a directed/undirected graph
+   * @throw NegativeCycleError: if a negative self-loop, a pair of edges
+   *        u -> v -> u or a chain around a cycle is negative, which the
+   *        core cannot show. Other negative cycles stay in the core.
+   */
+  explicit ChainContraction(const Graph<T>& graph);
+
+  ChainContraction(const ChainContraction&) = delete;
+  ChainContraction& operator=(const ChainContraction&) = delete;
+
+  static T infinity() { return SearchWorkspace<T>::infinity(); }
+
+  // No. of vertices of the original graph
+  size_t size() const { return kinds_.size(); }
+
+  // the core graph, whose vertex i is coreVertex(i) of the original graph
+  const DirectedGraph<T>& core() const { return *core_; }
+
+  bool isCore(size_t v) const { return kinds_.at(v) == kCore; }
+
+  size_t coreVertex(size_t id) const { return core_vertices_.at(id); }
+
+  // vertex of the core graph (throws std::invalid_argument if not in the core)
+  size_t coreId(size_t v) const {
+    if (!isCore(v)) { throw std::invalid_argument("Invalid argument: not a core vertex"); }
+    return core_ids_[v];
+  }
+
+  size_t countChain() const { return chain_begin_.size() - 1; }
+
+  size_t countTreeVertex() const { return peel_order_.size(); }
+
+  /**
+   * Shortest paths from a vertex of the original graph
+   *
+   * The solver runs from at most two core vertices: the ends of the
+   * chain of src (or of the chain its tree hangs from).
+   *
+   * @param src: the source vertex
+   * @param solve: callable with the signature
+   *               std::pair<std::deque<T>, std::deque<size_t>>(
+   *                   const DirectedGraph<T>& core, size_t core_src),
+   *               e.g. a single source algorithm on the core
+   * @return: a pair of two deques over the original vertices: the first
+   *          one stores the smallest cost of each vertex (infinity() if
+   *          not reachable); the second one stores the previous vertex
+   *          of each vertex in the shortest path (see reconstructPath()).
+   */
+  template <class Solver>
+  std::pair<std::deque<T>, std::deque<size_t>> shortestPaths(size_t src, Solver solve) const;
+
+private:
+  enum Kind : uint8_t { kCore, kChain, kTree };
+
+  // an edge of the core graph, which may stand for a chain
+  struct Shortcut {
+    uint32_t src;
+    uint32_t dst;
+    uint32_t chain;  // kNone for an edge of the original graph
+  };
+
+  static const uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+  std::vector<Kind> kinds_;
+  std::vector<uint32_t> core_ids_;
+  std::vector<uint32_t> core_vertices_;
+  std::unique_ptr<DirectedGraph<T>> core_;
+  std::vector<Shortcut> shortcuts_;  // in ascending order of (src, dst)
+
+  // chain c is chain_vertices_[chain_begin_[c], chain_begin_[c + 1]),
+  // from one core vertex to another, where forward_[i] (backward_[i])
+  // is the weight of the edge chain_vertices_[i] -> [i + 1] ([i + 1] -> [i])
+  std::vector<size_t> chain_begin_;
+  std::vector<uint32_t> chain_vertices_;
+  std::vector<T> forward_;
+  std::vector<T> backward_;
+  std::vector<uint32_t> chains_;  // chain of each vertex on a chain
+
+  // the tree vertices in the order they are peeled off (leaves first),
+  // with the weights of the edges to (up) and from (down) their parents
+  std::vector<uint32_t> peel_order_;
+  std::vector<uint32_t> parents_;
+  std::vector<T> up_;
+  std::vector<T> down_;
+
+  static T add(T a, T b) {
+    return (a >= infinity() || b >= infinity()) ? infinity() : a + b;
+  }
+
+  // the vertex before dst on the path of the core edge src -> dst
+  size_t lastHop(size_t src, size_t dst) const {
+    auto shortcut = std::lower_bound(shortcuts_.begin(), shortcuts_.end(), Shortcut{
+        (uint32_t)src, (uint32_t)dst, 0}, [](const Shortcut& a, const Shortcut& b) {
+      return a.src < b.src || (a.src == b.src && a.dst < b.dst);
+    });
+    if (shortcut->chain == kNone) { return src; }
+    size_t begin = chain_begin_[shortcut->chain];
+    size_t end = chain_begin_[shortcut->chain + 1];
+    return chain_vertices_[begin] == src ? chain_vertices_[end - 2] : chain_vertices_[begin + 1];
+  }
+
+  // relax the edges of a chain from both of its ends
+  template <class Relax>
+  void relaxChain(size_t chain, Relax relax) const {
+    size_t begin = chain_begin_[chain];
+    size_t end = chain_begin_[chain + 1];
+    for (size_t i = begin + 1; i < end; ++i) {
+      relax(chain_vertices_[i - 1], chain_vertices_[i], forward_[i - 1]);
+    }
+    for (size_t i = end - 1; i-- > begin;) {
+      relax(chain_vertices_[i + 1], chain_vertices_[i], backward_[i]);
+    }
+  }
+};
+
+template <class T>
+const uint32_t ChainContraction<T>::kNone;
+
+template <class T>
+ChainContraction<T>::ChainContraction(const Graph<T>& graph) {
+  const size_t n = graph.size();
+  if (n > kNone) {
+    throw std::invalid_argument("Invalid argument: too many vertices");
+  }
+
+  // the neighbors of each vertex, with the smallest weight of the
+  // edges in each direction (infinity() if there is none)
+  struct Link {
+    uint32_t lo;
+    uint32_t hi;
+    T lo_hi;
+    T hi_lo;
+  };
+  std::vector<Link> links;
+  for (size_t u = 0; u < n; ++u) {
+    for (graph::Edge<T>* e = graph.getList(u); e != nullptr; e = e->next) {
+      size_t v = e->dst;
+      if (u == v) {
+        if (e->weight < 0) { throw NegativeCycleError(std::deque<size_t>{u}); }
+        continue;
+      }
+      if (u < v) {
+        links.push_back({(uint32_t)u, (uint32_t)v, e->weight, infinity()});
+      } else {
+        links.push_back({(uint32_t)v, (uint32_t)u, infinity(), e->weight});
+      }
+    }
+  }
+  std::sort(links.begin(), links.end(), [](const Link& a, const Link& b) {
+    return a.lo < b.lo || (a.lo == b.lo && a.hi < b.hi);
+  });
+  size_t n_links = 0;
+  for (const auto& link : links) {
+    if (n_links > 0 && links[n_links - 1].lo == link.lo && links[n_links - 1].hi == link.hi) {
+      links[n_links - 1].lo_hi = std::min(links[n_links - 1].lo_hi, link.lo_hi);
+      links[n_links - 1].hi_lo = std::min(links[n_links - 1].hi_lo, link.hi_lo);
+    } else {
+      links[n_links++] = link;
+    }
+  }
+  links.resize(n_links);
+
+  struct Neighbor {
+    uint32_t vertex;
+    T out;  // weight of the edge to the neighbor
+    T in;   // weight of the edge from the neighbor
+  };
+  std::vector<size_t> offsets(n + 1, 0);
+  for (const auto& link : links) {
+    if (add(link.lo_hi, link.hi_lo) < 0) {
+      throw NegativeCycleError(std::deque<size_t>{link.lo, link.hi});
+    }
+    ++offsets[link.lo + 1];
+    ++offsets[link.hi + 1];
+  }
+  for (size_t v = 0; v < n; ++v) { offsets[v + 1] += offsets[v]; }
+  std::vector<Neighbor> neighbors(offsets[n]);
+  {
+    std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (const auto& link : links) {
+      neighbors[fill[link.lo]++] = {link.hi, link.lo_hi, link.hi_lo};
+      neighbors[fill[link.hi]++] = {link.lo, link.hi_lo, link.lo_hi};
+    }
+  }
+  links.clear();
+  links.shrink_to_fit();
+
+  // peel off the trees
+  kinds_.assign(n, kCore);
+  parents_.assign(n, kNone);
+  up_.assign(n, infinity());
+  down_.assign(n, infinity());
+  std::vector<size_t> degrees(n);
+  std::vector<uint32_t> leaves;
+  for (size_t v = 0; v < n; ++v) {
+    degrees[v] = offsets[v + 1] - offsets[v];
+    if (degrees[v] == 1) { leaves.push_back((uint32_t)v); }
+  }
+  while (!leaves.empty()) {
+    size_t v = leaves.back();
+    leaves.pop_back();
+    // the last vertex of a tree component has no neighbor left
+    if (degrees[v] != 1) { continue; }
+
+    for (size_t i = offsets[v]; i < offsets[v + 1]; ++i) {
+      const Neighbor& parent = neighbors[i];
+      if (kinds_[parent.vertex] == kTree) { continue; }
+      kinds_[v] = kTree;
+      parents_[v] = parent.vertex;
+      up_[v] = parent.out;
+      down_[v] = parent.in;
+      degrees[v] = 0;
+      if (--degrees[parent.vertex] == 1) { leaves.push_back(parent.vertex); }
+      break;
+    }
+    peel_order_.push_back((uint32_t)v);
+  }
+
+  // the link of a vertex on a chain to its remaining neighbor other
+  // than "from", and to "from"
+  auto other = [&](size_t v, size_t from) {
+    size_t i = offsets[v];
+    while (kinds_[neighbors[i].vertex] == kTree || neighbors[i].vertex == from) { ++i; }
+    return i;
+  };
+  auto link = [&](size_t v, size_t to) {
+    size_t i = offsets[v];
+    while (neighbors[i].vertex != to) { ++i; }
+    return i;
+  };
+
+  // walk the chains
+  for (size_t v = 0; v < n; ++v) {
+    if (kinds_[v] == kCore && degrees[v] == 2) { kinds_[v] = kChain; }
+  }
+  chains_.assign(n, kNone);
+  chain_begin_.push_back(0);
+  for (size_t v = 0; v < n; ++v) {
+    if (kinds_[v] != kChain || chains_[v] != kNone) { continue; }
+
+    // find a core end of the chain of v, or keep v in the core if the
+    // chain is a cycle
+    size_t prev = v;
+    size_t end = neighbors[other(v, n)].vertex;
+    while (kinds_[end] == kChain && end != v) {
+      size_t following = neighbors[other(end, prev)].vertex;
+      prev = end;
+      end = following;
+    }
+    if (end == v) { kinds_[v] = kCore; }
+
+    // walk back from that end to the other one
+    const uint32_t chain = (uint32_t)countChain();
+    chain_vertices_.push_back((uint32_t)end);
+    size_t from = end;
+    size_t current = prev;
+    while (true) {
+      size_t back = link(current, from);
+      size_t ahead = other(current, from);
+      chain_vertices_.push_back((uint32_t)current);
+      chains_[current] = chain;
+      forward_.push_back(neighbors[back].in);
+      backward_.push_back(neighbors[back].out);
+
+      size_t following = neighbors[ahead].vertex;
+      if (kinds_[following] != kChain) {
+        chain_vertices_.push_back((uint32_t)following);
+        forward_.push_back(neighbors[ahead].out);
+        backward_.push_back(neighbors[ahead].in);
+        forward_.push_back(infinity());  // after the last vertex
+        backward_.push_back(infinity());
+        break;
+      }
+      from = current;
+      current = following;
+    }
+    chain_begin_.push_back(chain_vertices_.size());
+  }
+
+  // the core graph, with the smallest of the parallel shortcuts
+  core_ids_.assign(n, kNone);
+  for (size_t v = 0; v < n; ++v) {
+    if (kinds_[v] == kCore) {
+      core_ids_[v] = (uint32_t)core_vertices_.size();
+      core_vertices_.push_back((uint32_t)v);
+    }
+  }
+
+  std::vector<std::pair<Shortcut, T>> candidates;
+  for (auto u : core_vertices_) {
+    for (size_t i = offsets[u]; i < offsets[u + 1]; ++i) {
+      if (kinds_[neighbors[i].vertex] == kCore && neighbors[i].out < infinity()) {
+        candidates.push_back({{u, neighbors[i].vertex, kNone}, neighbors[i].out});
+      }
+    }
+  }
+  for (size_t chain = 0; chain < countChain(); ++chain) {
+    size_t begin = chain_begin_[chain];
+    size_t end = chain_begin_[chain + 1];
+    T forward = 0;
+    T backward = 0;
+    for (size_t i = begin; i + 1 < end; ++i) {
+      forward = add(forward, forward_[i]);
+      backward = add(backward, backward_[i]);
+    }
+
+    uint32_t a = chain_vertices_[begin];
+    uint32_t b = chain_vertices_[end - 1];
+    if (a == b) {
+      // a cycle through one core vertex is never on a shortest path
+      // unless it is negative
+      if (forward < 0 || backward < 0) {
+        std::deque<size_t> cycle(chain_vertices_.begin() + begin, chain_vertices_.begin() + end - 1);
+        if (forward >= 0) { std::reverse(cycle.begin() + 1, cycle.end()); }
+        throw NegativeCycleError(cycle);
+      }
+      continue;
+    }
+    if (forward < infinity()) { candidates.push_back({{a, b, (uint32_t)chain}, forward}); }
+    if (backward < infinity()) { candidates.push_back({{b, a, (uint32_t)chain}, backward}); }
+  }
+  std::sort(candidates.begin(), candidates.end(), [](const std::pair<Shortcut, T>& a,
+                                                     const std::pair<Shortcut, T>& b) {
+    if (a.first.src != b.first.src) { return a.first.src < b.first.src; }
+    if (a.first.dst != b.first.dst) { return a.first.dst < b.first.dst; }
+    return a.second < b.second;
+  });
+
+  core_.reset(new DirectedGraph<T>(core_vertices_.size()));
+  for (const auto& candidate : candidates) {
+    const Shortcut& shortcut = candidate.first;
+    if (!shortcuts_.empty() && shortcuts_.back().src == shortcut.src &&
+        shortcuts_.back().dst == shortcut.dst) {
+      continue;
+    }
+    shortcuts_.push_back(shortcut);
+    core_->connectNew(core_ids_[shortcut.src], core_ids_[shortcut.dst], candidate.second);
+  }
+}
+
+template <class T>
+template <class Solver>
+std::pair<std::deque<T>, std::deque<size_t>>
+ChainContraction<T>::shortestPaths(size_t src, Solver solve) const {
+  if ( src >= size() ) {
+    throw std::out_of_range("Out of range: source");
+  }
+
+  std::deque<T> costs(size(), infinity());
+  std::deque<size_t> came_from(size());
+  auto relax = [&](size_t u, size_t v, T weight) {
+    T cost = add(costs[u], weight);
+    if (cost < costs[v]) {
+      costs[v] = cost;
+      came_from[v] = u;
+    }
+  };
+
+  // from src up its tree to a core vertex or a chain, and along that
+  // chain to the core vertices at its ends
+  costs[src] = 0;
+  came_from[src] = src;
+  size_t anchor = src;
+  while (kinds_[anchor] == kTree) {
+    relax(anchor, parents_[anchor], up_[anchor]);
+    anchor = parents_[anchor];
+  }
+  std::vector<size_t> entries {anchor};
+  if (kinds_[anchor] == kChain) {
+    size_t chain = chains_[anchor];
+    relaxChain(chain, relax);
+    entries = {chain_vertices_[chain_begin_[chain]], chain_vertices_[chain_begin_[chain + 1] - 1]};
+    if (entries[0] == entries[1]) { entries.pop_back(); }
+  }
+
+  // the core, where the core path to a vertex ends with the last edge of
+  // its shortcut
+  for (auto entry : entries) {
+    const T entry_cost = costs[entry];
+    if (entry_cost >= infinity()) { continue; }
+    const size_t core_src = core_ids_[entry];
+    std::pair<std::deque<T>, std::deque<size_t>> result = solve(*core_, core_src);
+    for (size_t id = 0; id < core_vertices_.size(); ++id) {
+      if (id == core_src || result.first[id] >= infinity()) { continue; }
+      size_t v = core_vertices_[id];
+      T cost = entry_cost + result.first[id];
+      if (cost < costs[v]) {
+        costs[v] = cost;
+        came_from[v] = lastHop(core_vertices_[result.second[id]], v);
+      }
+    }
+  }
+
+  // the chains from their ends, then the trees from their roots
+  for (size_t chain = 0; chain < countChain(); ++chain) { relaxChain(chain, relax); }
+  for (size_t i = peel_order_.size(); i-- > 0;) {
+    size_t v = peel_order_[i];
+    relax(parents_[v], v, down_[v]);
+  }
+
+  return std::make_pair(costs, came_from);
+}
+
+/**
+ * Dijkstra's algorithm on the core of a contracted graph
+ *
+ * Time complexity O(V + E'logV') for the V' vertices and E' edges of
+ * the core
+ *
+ * @param contraction: a contracted graph with non-negative weights
+ * @param src: source vertex of the original graph
+ * @return: the smallest costs and the previous vertices of the original
+ *          vertices (see ChainContraction::shortestPaths())
+ */
+template <class T>
+std::pair<std::deque<T>, std::deque<size_t>>
+dijkstra(const ChainContraction<T>& contraction, size_t src) {
+  SearchWorkspace<T> workspace(contraction.core().size());
+  return contraction.shortestPaths(src, [&workspace](const DirectedGraph<T>& core, size_t core_src) {
+    dijkstra(core, core_src, workspace);
+    return workspace.toDeque();
+  });
+}
+
+/**
+ * Bellman-Ford's algorithm on the core of a contracted graph
+ *
+ * Time complexity O(V + V'E') for the V' vertices and E' edges of the
+ * core
+ *
+ * @param contraction: a contracted graph
+ * @param src: source vertex of the original graph
+ * @return: the smallest costs and the previous vertices of the original
+ *          vertices (see ChainContraction::shortestPaths())
+ * @throw NegativeCycleError: if a negative cycle of the core is
+ *        reachable, with the core vertices of the cycle
+ */
+template <class T>
+std::pair<std::deque<T>, std::deque<size_t>>
+bellmanFord(const ChainContraction<T>& contraction, size_t src) {
+  SearchWorkspace<T> workspace(contraction.core().size());
+  return contraction.shortestPaths(src, [&](const DirectedGraph<T>& core, size_t core_src) {
+    try {
+      bellmanFord(core, core_src, workspace);
+    } catch (const NegativeCycleError& e) {
+      std::deque<size_t> cycle;
+      for (auto id : e.cycle()) { cycle.push_back(contraction.coreVertex(id)); }
+      throw NegativeCycleError(cycle);
+    }
+    return workspace.toDeque();
+  });
+}
+
+#endif //GRAPH_CHAIN_CONTRACTION_H
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "../graph.h"
+#include "../compressed_graph.h"
 
 
 /**
@@ -66,5 +67,66 @@ std::vector<size_t> depthFirstSearch(const Graph<T>& graph, size_t src) {
   return depthFirstSearch(graph, src, visited);
 }
 
+/**
+ * Depth-first-search on a compressed graph, where the neighbors of a
+ * vertex are visited in ascending order
+ *
+ * A vertex on the tracker keeps a cursor in its list, which is decoded
+ * one group of four neighbors at a time, so that a deep search holds a
+ * few bytes per vertex on the tracker rather than their whole lists.
+ *
+ * @param graph: compressed graph
+ * @param src: source vertex
+ * @param visited: indicator
+ * @return: a vector of sink vertices, ordered by finding time
+ */
+inline std::vector<size_t> depthFirstSearch(const CompressedGraph& graph, size_t src,
+                                            std::vector<bool>& visited) {
+  if (graph.size() != visited.size()) {
+    throw std::invalid_argument("Invalid argument: different sizes of graph and indicator");
+  }
+
+  if ( src >= graph.size() ) {
+    throw std::out_of_range("Out of range: src");
+  }
+
+  std::vector<CompressedGraph::ListCursor> tracker {graph.cursor(src)};
+  visited[src] = true;
+
+  // the container for sink vertices in finding sequence
+  std::vector<size_t> sink;
+  uint32_t group[4];
+  while ( !tracker.empty() ) {
+    CompressedGraph::ListCursor& top = tracker.back();
+    // find the next reachable vertex which has not been visited
+    size_t n = graph.decodeGroup(top, group);
+    size_t i = top.next%4;
+    while (i < n && visited[group[i]]) { ++i; }
+    if (i < n) {
+      size_t v = group[i];
+      if (i + 1 < n) {
+        top.next += (uint32_t)(i + 1 - top.next%4);
+      } else {
+        graph.nextGroup(top, group, n);
+      }
+      tracker.push_back(graph.cursor(v));
+      visited[v] = true;
+    } else if (n > 0) {
+      graph.nextGroup(top, group, n);
+    } else {
+      // if a sink vertex is found
+      sink.push_back(top.vertex);
+      tracker.pop_back();
+    }
+  }
+
+  return sink;
+}
+
+inline std::vector<size_t> depthFirstSearch(const CompressedGraph& graph, size_t src) {
+  std::vector<bool> visited (graph.size(), false);
+  return depthFirstSearch(graph, src, visited);
+}
+
 
 #endif //GRAPH_DEPTH_FIRST_SEARCH_H
\ No newline at end of file
@@ -14,6 +14,8 @@
 
 #include "../directed_graph.h"
 #include "../undirected_graph.h"
+#include "search_workspace.h"
+#include "../graph_stats.h"
 
 
 /**
@@ -90,6 +92,7 @@ dijkstraOriginal(const Graph<T>& graph, size_t src, size_t dst) {
       }
     }
     explored[pick] = true;
+    graph_stats::count(&SearchStats::settled);
 
     // stop search when reaching the destination
     if (src != dst && pick == dst) {
@@ -105,7 +108,9 @@ dijkstraOriginal(const Graph<T>& graph, size_t src, size_t dst) {
 
       auto vertex = current_edge->dst;
       T new_cost = costs[pick] + current_edge->weight;
+      graph_stats::count(&SearchStats::relaxations);
       if (costs[vertex] > new_cost) {
+        graph_stats::count(&SearchStats::updates);
         costs[vertex] = new_cost;
         came_from[vertex] = pick;
       }
@@ -159,11 +164,14 @@ dijkstraTreeBase(const Graph<T>& graph, size_t src, size_t dst) {
   came_from[src] = src;
 
   open_set.insert(std::make_pair(0, src));
+  graph_stats::count(&SearchStats::pushes);
   // Run until there is no vertex left in the remain set.
   while (!open_set.empty()) {
     // Pick the one in the open set with the smallest cost.
     auto pick = open_set.begin()->second;
     open_set.erase(open_set.begin());
+    graph_stats::count(&SearchStats::pops);
+    graph_stats::count(&SearchStats::settled);
 
     // stop search when reaching the destination
     if (src != dst && pick == dst) {
@@ -179,7 +187,10 @@ dijkstraTreeBase(const Graph<T>& graph, size_t src, size_t dst) {
 
       auto vertex = current_edge->dst;
       T new_cost = costs[pick] + current_edge->weight;
+      graph_stats::count(&SearchStats::relaxations);
       if (costs[vertex] > new_cost) {
+        graph_stats::count(&SearchStats::updates);
+        graph_stats::count(&SearchStats::pushes);
         open_set.erase(std::make_pair(costs[vertex], vertex));
         costs[vertex] = new_cost;
         came_from[vertex] = pick;
@@ -200,91 +211,215 @@ dijkstraTreeBase(const Graph<T>& graph, size_t src, size_t dst) {
 }
 
 /**
- * Priority queue implementation of Dijkstra's algorithm
+ * Priority queue implementation of Dijkstra's algorithm which keeps
+ * its state in a reusable workspace and reports each vertex it settles.
  *
- * Time complexity O(ElogV)
+ * Time complexity O(ElogV). Only the vertices visited by the search
+ * are touched, so many short queries on a large graph do not pay O(V)
+ * each for initialization.
  *
  * @param graph: a directed/undirected graph
  * @param src: source vertex
- * @param dst: destination vertex
- * @return: two deque containers. The first one stores the shortest
- *          distance from each vertex to the source; the second one
- *          stores the previous vertex of each vertex in the shortest
- *          path.
+ * @param workspace: search workspace which stores the costs and the
+ *                   previous vertices on return
+ * @param visit: callable with the signature bool(size_t v, T cost),
+ *               which is called when v is settled with its final cost
+ *               (in non-decreasing order of cost) and before its edges
+ *               are explored. The search stops if it returns false.
+ * @param potentials: optional vertex potentials p. If given, the edge
+ *                    (u, v) is searched with the reduced cost
+ *                    w + p[u] - p[v] and the costs in the workspace
+ *                    are the reduced ones.
+ * @return: true if the search is stopped by "visit".
  */
-template <class T>
-std::pair<std::deque<T>, std::deque<size_t>>
-dijkstraPriorityQueueBase(const Graph<T>& graph, size_t src, size_t dst) {
+template <class T, class Visitor>
+bool dijkstraSearch(const Graph<T>& graph, size_t src,
+                    SearchWorkspace<T>& workspace, Visitor visit,
+                    const std::vector<T>* potentials=nullptr) {
   if ( src < 0 || src >= graph.size() ) {
     throw std::out_of_range("Out of range: source");
   }
-  if ( dst < 0 || dst >= graph.size() ) {
-    throw std::out_of_range("Out of range: destination");
-  }
-
-  T kMaxCost = (T)(std::numeric_limits<T>::max()/2.0);
-
-  // The first element is the cost from source to the current
-  // vertex; the second element is the current vertex.
-  std::priority_queue<std::pair<T, size_t>,
-      std::vector<std::pair<T, size_t>>,
-      std::greater<std::pair<T, size_t>>> open_set;
-
-  // actual minimum cost to the source so far
-  std::deque<T> costs(graph.size(), kMaxCost);
-  // the previous point that allows to achieve the minimum cost so far
-  std::deque<size_t> came_from(graph.size());
-  // mark the explored point (another way to screen the old copies)
-//  std::deque<bool> explored(graph.size(), false);
 
   // initialization
-  costs[src] = 0;
-  came_from[src] = src;
+  workspace.reset(graph.size());
+  workspace.set(src, 0, src);
 
   // Run until there is no points left in the open set.
-  open_set.push(std::make_pair(0, src));
-  while (!open_set.empty()) {
+  workspace.push(0, src);
+  while (!workspace.empty()) {
     // Pick the point in the open set with the smallest cost.
-    auto pick = open_set.top();
-    open_set.pop();
+    auto pick = workspace.pop();
 
-    // stop search when reaching the destination
-    if (src != dst && pick.second == dst) {
-      return std::make_pair(costs, came_from);
+    // skip the old copies in the open set
+    if (pick.first > workspace.cost(pick.second)) {
+      graph_stats::count(&SearchStats::stale);
+      continue;
     }
+    workspace.settle(pick.second);
 
-    // skip the old copies in the open set
-//    if (explored[pick.second]) { continue; }
-//    explored[pick.second] = true;
-    if (pick.first > costs[pick.second]) { continue; }
+    if (!visit(pick.second, pick.first)) { return true; }
 
     graph::Edge<T> *current_edge = graph.getList(pick.second);
     // Loop the neighbors of the picked vertex
     while (current_edge) {
-      if ( current_edge->weight < 0 ) {
+      T weight = current_edge->weight;
+      if (potentials != nullptr) {
+        weight += (*potentials)[pick.second] - (*potentials)[current_edge->dst];
+      }
+      if ( weight < 0 ) {
         std::cerr << "Graph has negative weight! Result could be wrong!" << std::endl;
       }
 
-      auto vertex = current_edge->dst;
       // It is unnecessary to find and remove the old copy here since it
       // can be screened out later.
-      T new_cost = costs[pick.second] + current_edge->weight;
-      if (costs[vertex] > new_cost) {
-        costs[vertex] = new_cost;
-        came_from[vertex] = pick.second;
-        open_set.push(std::make_pair(new_cost, vertex));
+      T new_cost = pick.first + weight;
+      if (workspace.relax(current_edge->dst, new_cost, pick.second)) {
+        workspace.push(new_cost, current_edge->dst);
       }
       current_edge = current_edge->next;
     }
   }
 
-  if (src != dst) {
+  return false;
+}
+
+/**
+ * Priority queue implementation of Dijkstra's algorithm which keeps
+ * its state in a reusable workspace.
+ *
+ * Time complexity O(ElogV)
+ *
+ * @param graph: a directed/undirected graph
+ * @param src: source vertex
+ * @param dst: destination vertex
+ * @param workspace: search workspace which stores the costs and the
+ *                   previous vertices on return
+ * @param potentials: optional vertex potentials (see dijkstraSearch())
+ * @return: true if the destination is reached (always true if
+ *          src == dst, in which case the entire graph is explored).
+ */
+template <class T>
+bool dijkstraPriorityQueueBase(const Graph<T>& graph, size_t src, size_t dst,
+                               SearchWorkspace<T>& workspace,
+                               const std::vector<T>* potentials=nullptr) {
+  if ( dst < 0 || dst >= graph.size() ) {
+    throw std::out_of_range("Out of range: destination");
+  }
+
+  // stop search when reaching the destination
+  return dijkstraSearch(graph, src, workspace, [src, dst](size_t v, T) {
+    return src == dst || v != dst;
+  }, potentials) || src == dst;
+}
+
+/**
+ * Dijkstra's algorithm which stops after the k nearest targets are
+ * settled
+ *
+ * Time complexity O(ElogV) in the worst case, but only the vertices
+ * closer than the k-th nearest target are settled.
+ *
+ * @param graph: a directed/undirected graph
+ * @param src: source vertex
+ * @param targets: target vertices (duplicates are ignored)
+ * @param k: max No. of targets to find
+ * @param workspace: search workspace
+ * @return: <target, cost> of the (up to) k nearest reachable targets
+ *          in non-decreasing order of cost
+ */
+template <class T>
+std::vector<std::pair<size_t, T>>
+dijkstraNearestTargets(const Graph<T>& graph, size_t src,
+                       const std::vector<size_t>& targets, size_t k,
+                       SearchWorkspace<T>& workspace) {
+  std::vector<std::pair<size_t, T>> nearest;
+
+  workspace.clearTargets(graph.size());
+  for (auto v : targets) {
+    if ( v >= graph.size() ) {
+      throw std::out_of_range("Out of range: target");
+    }
+    workspace.markTarget(v);
+  }
+  if (k == 0) { return nearest; }
+
+  dijkstraSearch(graph, src, workspace, [&](size_t v, T cost) {
+    if (workspace.isTarget(v)) { nearest.push_back(std::make_pair(v, cost)); }
+    return nearest.size() < k;
+  });
+
+  return nearest;
+}
+
+template <class T>
+std::vector<std::pair<size_t, T>>
+dijkstraNearestTargets(const Graph<T>& graph, size_t src,
+                       const std::vector<size_t>& targets, size_t k) {
+  SearchWorkspace<T> workspace(graph.size());
+  return dijkstraNearestTargets(graph, src, targets, k, workspace);
+}
+
+/**
+ * Dijkstra's algorithm which stops at a cost radius
+ *
+ * Time complexity O(ElogV) in the worst case, but only the vertices
+ * within the radius are settled.
+ *
+ * @param graph: a directed/undirected graph
+ * @param src: source vertex
+ * @param radius: max cost
+ * @param workspace: search workspace
+ * @return: <vertex, cost> of all the vertices whose smallest cost is
+ *          no larger than the radius in non-decreasing order of cost
+ *          (including the source)
+ */
+template <class T>
+std::vector<std::pair<size_t, T>>
+dijkstraWithinRadius(const Graph<T>& graph, size_t src, T radius,
+                     SearchWorkspace<T>& workspace) {
+  std::vector<std::pair<size_t, T>> within;
+
+  // the search stops at the first vertex beyond the radius
+  dijkstraSearch(graph, src, workspace, [&](size_t v, T cost) {
+    if (cost > radius) { return false; }
+    within.push_back(std::make_pair(v, cost));
+    return true;
+  });
+
+  return within;
+}
+
+template <class T>
+std::vector<std::pair<size_t, T>>
+dijkstraWithinRadius(const Graph<T>& graph, size_t src, T radius) {
+  SearchWorkspace<T> workspace(graph.size());
+  return dijkstraWithinRadius(graph, src, radius, workspace);
+}
+
+/**
+ * Priority queue implementation of Dijkstra's algorithm
+ *
+ * Time complexity O(ElogV)
+ *
+ * @param graph: a directed/undirected graph
+ * @param src: source vertex
+ * @param dst: destination vertex
+ * @return: two deque containers. The first one stores the shortest
+ *          distance from each vertex to the source; the second one
+ *          stores the previous vertex of each vertex in the shortest
+ *          path.
+ */
+template <class T>
+std::pair<std::deque<T>, std::deque<size_t>>
+dijkstraPriorityQueueBase(const Graph<T>& graph, size_t src, size_t dst) {
+  SearchWorkspace<T> workspace(graph.size());
+
+  if (!dijkstraPriorityQueueBase(graph, src, dst, workspace)) {
     throw std::invalid_argument(
         "Invalid argument: source and destination are not connected!");
   }
 
-  // if no destination is specified
-  return std::make_pair(costs, came_from);
+  return workspace.toDeque();
 }
 
 //
@@ -305,4 +440,22 @@ dijkstra(const Graph<T>& graph, size_t src, size_t dst) {
   return dijkstraPriorityQueueBase(graph, src, dst);
 }
 
+//
+// Explore the entire graph, reusing the memory of the workspace
+//
+template <class T>
+void dijkstra(const Graph<T>& graph, size_t src, SearchWorkspace<T>& workspace) {
+  dijkstraPriorityQueueBase(graph, src, src, workspace);
+}
+
+//
+// Explore the graph until reaching the destination vertex, reusing the
+// memory of the workspace
+//
+template <class T>
+bool dijkstra(const Graph<T>& graph, size_t src, size_t dst,
+              SearchWorkspace<T>& workspace) {
+  return dijkstraPriorityQueueBase(graph, src, dst, workspace);
+}
+
 #endif //GRAPH_DIJKSTRA_H
\ No newline at end of file
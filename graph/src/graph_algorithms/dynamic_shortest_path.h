@@ -0,0 +1,277 @@
+//
+// Single source shortest paths maintained under edge insertions,
+// deletions and weight changes.
+//
+
+#ifndef GRAPH_DYNAMIC_SHORTEST_PATH_H
+#define GRAPH_DYNAMIC_SHORTEST_PATH_H
+
+#include <deque>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../directed_graph.h"
+#include "dijkstra.h"
+#include "search_workspace.h"
+
+
+/**
+ * Shortest path tree of a directed graph with non-negative weights,
+ * which is repaired incrementally when the graph changes (in the style
+ * of Ramalingam and Reps).
+ *
+ * The graph must only be modified through this object, which keeps a
+ * reversed copy of it to look up the incoming edges of a vertex.
+ *
+ * - A shorter or new edge (u, v) can only lower the costs of v and the
+ *   vertices reached through v, which are repaired by a Dijkstra
+ *   search seeded with v.
+ * - A longer or deleted edge (u, v) only matters if it is in the tree.
+ *   The costs of the subtree of v become invalid; each vertex in it
+ *   takes its best incoming edge from outside the subtree and a
+ *   Dijkstra search seeded with these vertices repairs the rest.
+ *
+ * Either way only the affected vertices and their edges are touched,
+ * instead of O(ElogV) for a search from scratch.
+ */
+template <class T>
+class DynamicShortestPath {
+public:
+  // <cost, vertex>
+  typedef std::pair<T, size_t> heap_entry;
+
+  /**
+   * constructor
+   *
+   * @param graph: a directed graph with non-negative weights, which is
+   *               referenced (not copied) by this object
+   * @param src: source vertex
+   */
+  DynamicShortestPath(DirectedGraph<T>& graph, size_t src)
+      : graph_(graph), reversed_(graph), src_(src),
+        costs_(graph.size(), infinity()), came_from_(graph.size(), graph.size()),
+        affected_(graph.size(), false), n_affected_(0) {
+    reversed_.reverse();
+
+    SearchWorkspace<T> workspace(graph.size());
+    dijkstraSearch(graph_, src_, workspace, [&](size_t v, T cost) {
+      costs_[v] = cost;
+      came_from_[v] = workspace.cameFrom(v);
+      return true;
+    });
+  }
+
+  // the cost of a vertex which cannot be reached
+  static T infinity() { return SearchWorkspace<T>::infinity(); }
+
+  // get the source vertex
+  size_t source() const { return src_; }
+
+  // get the smallest cost from the source (infinity() if not reached)
+  T cost(size_t v) const { return costs_[v]; }
+
+  // whether a vertex can be reached from the source
+  bool reached(size_t v) const { return came_from_[v] != graph_.size(); }
+
+  // the previous vertex in the shortest path (only valid if reached)
+  size_t cameFrom(size_t v) const { return came_from_[v]; }
+
+  // No. of vertices settled by the repair search of the last update
+  size_t countAffected() const { return n_affected_; }
+
+  /**
+   * Get the shortest path from the source to a vertex
+   *
+   * @return: the vertices from the source to dst (empty if not reached)
+   */
+  std::deque<size_t> path(size_t dst) const {
+    std::deque<size_t> path;
+    if (!reached(dst)) { return path; }
+
+    for (size_t v = dst; v != src_; v = came_from_[v]) { path.push_front(v); }
+    path.push_front(src_);
+    return path;
+  }
+
+  /**
+   * Add an edge and repair the shortest paths
+   *
+   * @return: false if the edge already exists (nothing is changed)
+   */
+  bool insertEdge(size_t src, size_t dst, T weight) {
+    checkWeight(weight);
+    if (!graph_.connect(src, dst, weight)) { return false; }
+    reversed_.connect(dst, src, weight);
+
+    n_affected_ = 0;
+    decrease(src, dst, weight);
+    return true;
+  }
+
+  /**
+   * Remove an edge and repair the shortest paths
+   *
+   * @return: weight of the deleted edge (0 if it does not exist)
+   */
+  T deleteEdge(size_t src, size_t dst) {
+    if (findEdge(graph_, src, dst) == nullptr) { return 0; }
+    T weight = graph_.disconnect(src, dst);
+    reversed_.disconnect(dst, src);
+
+    n_affected_ = 0;
+    increase(src, dst);
+    return weight;
+  }
+
+  /**
+   * Change the weight of an edge and repair the shortest paths
+   *
+   * @return: false if the edge does not exist
+   */
+  bool updateWeight(size_t src, size_t dst, T weight) {
+    checkWeight(weight);
+    graph::Edge<T>* edge = findEdge(graph_, src, dst);
+    if (edge == nullptr) { return false; }
+    T old_weight = edge->weight;
+    edge->weight = weight;
+    findEdge(reversed_, dst, src)->weight = weight;
+
+    n_affected_ = 0;
+    if (weight < old_weight) {
+      decrease(src, dst, weight);
+    } else if (weight > old_weight) {
+      increase(src, dst);
+    }
+    return true;
+  }
+
+private:
+  DirectedGraph<T>& graph_;
+  DirectedGraph<T> reversed_;  // incoming edges of each vertex
+  size_t src_;
+
+  std::vector<T> costs_;
+  std::vector<size_t> came_from_;  // V if not reached
+
+  std::vector<bool> affected_;  // scratch for increase()
+  size_t n_affected_;
+
+  std::priority_queue<heap_entry, std::vector<heap_entry>,
+                      std::greater<heap_entry>> heap_;
+
+  static graph::Edge<T>* findEdge(const DirectedGraph<T>& graph,
+                                  size_t src, size_t dst) {
+    if ( src >= graph.size() || dst >= graph.size() ) {
+      throw std::out_of_range("Out of range: vertex");
+    }
+    graph::Edge<T>* current_edge = graph.getList(src);
+    while (current_edge != nullptr && current_edge->dst != dst) {
+      current_edge = current_edge->next;
+    }
+    return current_edge;
+  }
+
+  static void checkWeight(T weight) {
+    if (weight < 0) {
+      throw std::invalid_argument("Invalid argument: negative weight");
+    }
+  }
+
+  // lower the cost of a vertex and queue it for propagate()
+  void relax(size_t v, T cost, size_t came_from) {
+    costs_[v] = cost;
+    came_from_[v] = came_from;
+    heap_.push(std::make_pair(cost, v));
+  }
+
+  //
+  // Dijkstra's search from the queued vertices. Only the vertices whose
+  // costs are lowered are queued, so the search stops at the boundary
+  // of the affected region.
+  //
+  void propagate() {
+    while (!heap_.empty()) {
+      heap_entry pick = heap_.top();
+      heap_.pop();
+
+      // skip the old copies
+      if (pick.first > costs_[pick.second]) { continue; }
+      ++n_affected_;
+
+      graph::Edge<T>* current_edge = graph_.getList(pick.second);
+      while (current_edge != nullptr) {
+        T new_cost = pick.first + current_edge->weight;
+        if (new_cost < costs_[current_edge->dst]) {
+          relax(current_edge->dst, new_cost, pick.second);
+        }
+        current_edge = current_edge->next;
+      }
+    }
+  }
+
+  // repair after the edge (src, dst) becomes shorter or is added
+  void decrease(size_t src, size_t dst, T weight) {
+    if (!reached(src)) { return; }
+
+    T new_cost = costs_[src] + weight;
+    if (new_cost < costs_[dst]) {
+      relax(dst, new_cost, src);
+      propagate();
+    }
+  }
+
+  // repair after the edge (src, dst) becomes longer or is removed
+  void increase(size_t src, size_t dst) {
+    // a non-tree edge is not on any shortest path
+    if (!reached(dst) || dst == src_ || came_from_[dst] != src) { return; }
+
+    // collect the subtree of dst: the children of v are the vertices
+    // at the end of its edges whose previous vertex is v
+    std::vector<size_t> subtree(1, dst);
+    affected_[dst] = true;
+    for (size_t k = 0; k < subtree.size(); ++k) {
+      size_t v = subtree[k];
+      graph::Edge<T>* current_edge = graph_.getList(v);
+      while (current_edge != nullptr) {
+        size_t child = current_edge->dst;
+        if (!affected_[child] && came_from_[child] == v) {
+          affected_[child] = true;
+          subtree.push_back(child);
+        }
+        current_edge = current_edge->next;
+      }
+    }
+
+    for (auto v : subtree) {
+      costs_[v] = infinity();
+      came_from_[v] = graph_.size();
+    }
+
+    // the best incoming edge from the rest of the tree, whose costs do
+    // not change
+    for (auto v : subtree) {
+      graph::Edge<T>* in_edge = reversed_.getList(v);
+      while (in_edge != nullptr) {
+        size_t u = in_edge->dst;
+        if (!affected_[u] && reached(u)) {
+          T new_cost = costs_[u] + in_edge->weight;
+          if (new_cost < costs_[v]) {
+            costs_[v] = new_cost;
+            came_from_[v] = u;
+          }
+        }
+        in_edge = in_edge->next;
+      }
+      if (reached(v)) { heap_.push(std::make_pair(costs_[v], v)); }
+    }
+
+    for (auto v : subtree) { affected_[v] = false; }
+    propagate();
+  }
+};
+
+
+#endif //GRAPH_DYNAMIC_SHORTEST_PATH_H
@@ -5,67 +5,287 @@
 #ifndef GRAPH_FLOYD_WARSHALL_H
 #define GRAPH_FLOYD_WARSHALL_H
 
+#include <algorithm>
 #include <iostream>
 #include <deque>
 #include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "../directed_graph.h"
+#include "../parallel.h"
+#include "apsp_matrix.h"
+#include "min_plus.h"
+#include "next_hop_table.h"
+
 
 /**
- * Floyd-Warshall's all-pair shorted path algorithm
+ * Run the Floyd-Warshall's updates of a tile of the cost matrix and
+ * keep the next hops of the updated pairs
  *
- * Time complexity O(V^3)
+ *   costs[i][j] = min(costs[i][j], costs[i][k] + costs[k][j])
+ *   next[i][j] = next[i][k] if costs[i][j] is updated through k
  *
- * @param graph: a directed graph
- * @return: a pair of two 2D deques: the first one stores the smallest
- *          cost between each pair of vertices; the second one stores
- *          the previous vertex of each vertex in the shortest path.
+ * for k in [k0, k1), i in [i0, i1) and j in [j0, j1). Without the next
+ * hops this is minPlusTile() with all the operands being the cost
+ * matrix.
+ *
+ * @param costs: the V x V cost matrix in row-major order
+ * @param next: the V x V next-hop matrix in row-major order
+ * @param n: No. of vertices
+ * @param threshold: costs no smaller than it are INF
  */
-template <class T>
-std::pair<std::deque<std::deque<T>> , std::deque<std::deque<size_t>>>
-floydWarshall(const DirectedGraph<T>& graph) {
-  const auto kINF = (T)(std::numeric_limits<T>::max()/2.0);
+template <class T, class I>
+void floydWarshallTile(T* costs, I* next, size_t n, T threshold,
+                       size_t k0, size_t k1, size_t i0, size_t i1,
+                       size_t j0, size_t j1) {
+  for (size_t k = k0; k < k1; ++k) {
+    const T* row_k = costs + k*n;
+    for (size_t i = i0; i < i1; ++i) {
+      T* row_i = costs + i*n;
+      I* next_i = next + i*n;
+      const T cost_ik = row_i[k];
+      if (cost_ik >= threshold) { continue; }
+      const I next_ik = next_i[k];
+
+      for (size_t j = j0; j < j1; ++j) {
+        T new_cost = cost_ik + row_k[j];
+        bool shorter = new_cost < row_i[j];
+        row_i[j] = shorter ? new_cost : row_i[j];
+        next_i[j] = shorter ? next_ik : next_i[j];
+      }
+    }
+  }
+}
 
-  // initialization
-  std::deque<std::deque<T>>
-      costs(graph.size(), std::deque<T>(graph.size(), kINF));
-  for (size_t i=0; i<graph.size(); ++i) {
-    costs[i][i] = (T)0;
+/**
+ * Schedule the tiles of the blocked Floyd-Warshall's algorithm
+ *
+ * For each block of k, the diagonal tile is updated first, then the
+ * tiles in the same row and column of blocks, and at last all the other
+ * tiles. The tiles in the last two phases are independent and are
+ * processed by a pool of threads.
+ *
+ * @param costs: the V x V cost matrix in row-major order
+ * @param n: No. of vertices
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param block_size: No. of rows and columns of a tile
+ * @param tile: callable with the signature
+ *              void(k0, k1, i0, i1, j0, j1) which updates a tile
+ */
+template <class T, class Tile>
+void floydWarshallSchedule(const T* costs, size_t n, size_t n_threads,
+                           size_t block_size, Tile tile) {
+  const size_t n_blocks = (n + block_size - 1) / block_size;
+  auto block_begin = [block_size](size_t b) { return b*block_size; };
+  auto block_end = [block_size, n](size_t b) {
+    return std::min(n, (b + 1)*block_size);
+  };
+
+  for (size_t kb = 0; kb < n_blocks; ++kb) {
+    const size_t k0 = block_begin(kb), k1 = block_end(kb);
+
+    // phase 1: the diagonal tile depends only on itself
+    tile(k0, k1, k0, k1, k0, k1);
+
+    // phase 2: tiles in the same row or column of blocks depend on
+    // themselves and the diagonal tile
+    graph_parallel::parallelFor(2*n_blocks, n_threads,
+                                [&](size_t, size_t t) {
+      size_t b = t % n_blocks;
+      if (b == kb) { return; }
+      if (t < n_blocks) {
+        tile(k0, k1, k0, k1, block_begin(b), block_end(b));
+      } else {
+        tile(k0, k1, block_begin(b), block_end(b), k0, k1);
+      }
+    });
+
+    // phase 3: the other tiles depend on the tiles of phase 2
+    graph_parallel::parallelFor(n_blocks*n_blocks, n_threads,
+                                [&](size_t, size_t t) {
+      size_t ib = t / n_blocks;
+      size_t jb = t % n_blocks;
+      if (ib == kb || jb == kb) { return; }
+      tile(k0, k1, block_begin(ib), block_end(ib),
+           block_begin(jb), block_end(jb));
+    });
+
+    // test negative cycle (stop early since the costs on a negative
+    // cycle keep decreasing)
+    for (size_t i = 0; i < n; ++i) {
+      if (costs[i*n + i] < 0) {
+        throw std::invalid_argument("Found negative cycle in the graph!");
+      }
+    }
+  }
+}
+
+/**
+ * Run the blocked Floyd-Warshall's algorithm with the next hops stored
+ * as entries of type I
+ */
+template <class T, class I>
+void floydWarshallBlockedNextHop(const DirectedGraph<T>& graph, T* costs,
+                                 NextHopTable& next_hops, size_t n_threads,
+                                 size_t block_size, T threshold) {
+  const size_t n = graph.size();
+  I* next = next_hops.template data<I>();
+
+  next_hops.clear();
+  for (size_t i=0; i<n; ++i) {
+    next[i*n + i] = (I)i;
 
     graph::Edge<T>* current_edge = graph.getList(i);
     while (current_edge != nullptr) {
-      costs[i][current_edge->dst] = current_edge->weight;
+      next[i*n + current_edge->dst] = (I)current_edge->dst;
       current_edge = current_edge->next;
     }
   }
 
-  // TODO:: implement reconstruction
-  std::deque<std::deque<size_t>>
-      came_from(graph.size(), std::deque<size_t>(graph.size()));
-
-  // dynamic programming of Floyd-Marshall's algorithm
-  for (size_t k = 0; k < graph.size(); ++k) {
-    for (size_t i = 0; i < graph.size(); ++i) {
-      for (size_t j = 0; j < graph.size(); ++j) {
-        // avoid doing math on the defined INF, which may cause bugs
-        if (std::abs(kINF - costs[i][k]) > std::numeric_limits<T>::epsilon() &&
-            std::abs(kINF - costs[k][j]) > std::numeric_limits<T>::epsilon() ) {
-          T new_cost = costs[i][k] + costs[k][j];
-          if (new_cost < costs[i][j]) { costs[i][j] = new_cost; }
-        }
-      }
+  floydWarshallSchedule(costs, n, n_threads, block_size,
+      [=](size_t k0, size_t k1, size_t i0, size_t i1, size_t j0, size_t j1) {
+    floydWarshallTile(costs, next, n, threshold, k0, k1, i0, i1, j0, j1);
+  });
+}
+
+/**
+ * Blocked (tiled) Floyd-Warshall's all-pair shorted path algorithm on
+ * a V x V cost matrix in row-major order
+ *
+ * @param graph: a directed graph
+ * @param costs: buffer of V x V costs, which stores the smallest costs
+ *               on return ((T)(max/2) if there is no path)
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param block_size: No. of rows and columns of a tile
+ * @param next_hops: optional table of size V which stores the next
+ *                   hops of the shortest paths on return
+ */
+template <class T>
+void floydWarshallBlockedInPlace(const DirectedGraph<T>& graph, T* costs,
+                                 size_t n_threads, size_t block_size,
+                                 NextHopTable* next_hops) {
+  const auto kINF = (T)(std::numeric_limits<T>::max()/2.0);
+  const auto kThreshold = (T)(kINF/2);
+  const size_t n = graph.size();
+  if (block_size == 0) { block_size = 64; }
+  if (next_hops != nullptr && next_hops->size() != n) {
+    throw std::invalid_argument(
+        "Invalid argument: different sizes of graph and next-hop table");
+  }
+
+  edgeCostMatrix(graph, kINF, costs);
+
+  if (next_hops == nullptr) {
+    floydWarshallSchedule(costs, n, n_threads, block_size,
+        [=](size_t k0, size_t k1, size_t i0, size_t i1, size_t j0, size_t j1) {
+      minPlusTile(costs, costs, costs, n, kThreshold, k0, k1, i0, i1, j0, j1);
+    });
+  } else {
+    // the kernel is instantiated for each width of the next hops
+    switch (next_hops->width()) {
+      case 1:
+        floydWarshallBlockedNextHop<T, uint8_t>(
+            graph, costs, *next_hops, n_threads, block_size, kThreshold);
+        break;
+      case 2:
+        floydWarshallBlockedNextHop<T, uint16_t>(
+            graph, costs, *next_hops, n_threads, block_size, kThreshold);
+        break;
+      case 4:
+        floydWarshallBlockedNextHop<T, uint32_t>(
+            graph, costs, *next_hops, n_threads, block_size, kThreshold);
+        break;
+      default:
+        floydWarshallBlockedNextHop<T, uint64_t>(
+            graph, costs, *next_hops, n_threads, block_size, kThreshold);
     }
   }
 
-  // test negative cycle
-  for (size_t i = 0; i < graph.size(); ++i) {
-    if (costs[i][i] < 0) {
-      throw std::invalid_argument("Found negative cycle in the graph!");
+  // clamp the drifted INF, whose next hops are meaningless
+  for (size_t k = 0; k < n*n; ++k) {
+    if (costs[k] >= kThreshold) {
+      costs[k] = kINF;
+      if (next_hops != nullptr) { next_hops->set(k / n, k % n, next_hops->none()); }
     }
   }
+}
+
+/**
+ * Blocked (tiled) Floyd-Warshall's all-pair shorted path algorithm
+ *
+ * Time complexity O(V^3). The flat cost matrix is split into tiles of
+ * block_size x block_size, which stay in cache during the updates (see
+ * floydWarshallSchedule()).
+ *
+ * @param graph: a directed graph
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param block_size: No. of rows and columns of a tile
+ * @param next_hops: optional table of size V which stores the next
+ *                   hops of the shortest paths on return
+ * @return: the V x V cost matrix in row-major order. The cost is
+ *          (T)(max/2) if there is no path.
+ */
+template <class T>
+std::vector<T> floydWarshallBlocked(const DirectedGraph<T>& graph,
+                                    size_t n_threads=0, size_t block_size=64,
+                                    NextHopTable* next_hops=nullptr) {
+  std::vector<T> costs(graph.size()*graph.size());
+  floydWarshallBlockedInPlace(graph, costs.data(), n_threads, block_size, next_hops);
+
+  return costs;
+}
+
+/**
+ * Blocked Floyd-Warshall's all-pair shorted path algorithm which
+ * returns an ApspMatrix
+ *
+ * @param graph: a directed graph
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param path: if not empty, the matrix is stored in this memory-mapped
+ *              file instead of RAM
+ * @param next_hops: optional table of size V which stores the next
+ *                   hops of the shortest paths on return
+ * @return: the smallest costs (ApspMatrix<T>::infinity() if there is
+ *          no path)
+ */
+template <class T>
+ApspMatrix<T> floydWarshallMatrix(const DirectedGraph<T>& graph, size_t n_threads=0,
+                                  const std::string& path="",
+                                  NextHopTable* next_hops=nullptr) {
+  ApspMatrix<T> costs(graph.size(), path);
+  floydWarshallBlockedInPlace(graph, costs.data(), n_threads, 64, next_hops);
+  costs.sync();
+
+  return costs;
+}
+
+/**
+ * Floyd-Warshall's all-pair shorted path algorithm
+ *
+ * Time complexity O(V^3)
+ *
+ * @param graph: a directed graph
+ * @return: a pair of two 2D deques: the first one stores the smallest
+ *          cost between each pair of vertices; the second one stores
+ *          the next vertex after i on the shortest path from i to j
+ *          (V if j cannot be reached from i).
+ */
+template <class T>
+std::pair<std::deque<std::deque<T>> , std::deque<std::deque<size_t>>>
+floydWarshall(const DirectedGraph<T>& graph) {
+  const size_t n = graph.size();
+  NextHopTable next_hops(n);
+  std::vector<T> flat_costs = floydWarshallBlocked(graph, 0, 64, &next_hops);
+
+  std::deque<std::deque<T>> costs(n);
+  for (size_t i=0; i<n; ++i) {
+    costs[i].assign(flat_costs.begin() + i*n, flat_costs.begin() + (i + 1)*n);
+  }
 
-  return std::make_pair(costs, came_from);
+  return std::make_pair(costs, next_hops.toDeque());
 };
 
 
-#endif //GRAPH_FLOYD_WARSHALL_H
\ No newline at end of file
+#endif //GRAPH_FLOYD_WARSHALL_H
@@ -0,0 +1,139 @@
+//
+// Minimum spanning forest of a stream of edges.
+//
+
+#ifndef GRAPH_INCREMENTAL_MST_H
+#define GRAPH_INCREMENTAL_MST_H
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "../disjoint_set.h"
+#include "../edge_list.h"
+#include "../parallel.h"
+#include "../undirected_graph.h"
+
+
+/**
+ * Minimum spanning forest which is kept up to date as batches of edges
+ * are inserted.
+ *
+ * By the cycle property, an edge which is not in the forest of the
+ * edges so far is the heaviest one on a cycle, and it stays out of the
+ * forest whatever edges come later. So only the forest (at most V - 1
+ * edges) is kept, and a batch of B edges is merged by a Kruskal's scan
+ * over the forest and the sorted batch in O(BlogB + V) time, instead
+ * of re-running kruskal() over all the edges so far.
+ *
+ * Edges are ordered as WeightedEdge, so the forest is the same as the
+ * one kruskal() finds for all the edges.
+ */
+template <class T>
+class IncrementalMinimumSpanningForest {
+public:
+  /**
+   * constructor
+   *
+   * @param n_vertices: No. of vertices, which have no edge at first
+   * @param n_threads: No. of threads to sort a batch (0 for the
+   *                   hardware default)
+   */
+  explicit IncrementalMinimumSpanningForest(size_t n_vertices, size_t n_threads=0)
+      : n_vertices_(n_vertices), n_threads_(n_threads), cost_(0),
+        components_(n_vertices) {}
+
+  // start with the minimum spanning forest of a graph
+  explicit IncrementalMinimumSpanningForest(const UndirectedGraph<T>& graph,
+                                            size_t n_threads=0)
+      : IncrementalMinimumSpanningForest(graph.size(), n_threads) {
+    insertEdges(edgeList(graph));
+  }
+
+  // get No. of vertices
+  size_t size() const { return n_vertices_; }
+
+  // get the total cost of the forest in O(1)
+  T cost() const { return cost_; }
+
+  // get the edges of the forest in ascending order
+  const std::vector<WeightedEdge<T>>& edges() const { return forest_; }
+
+  // get No. of trees in the forest (1 if it spans all the vertices)
+  size_t countTrees() const { return n_vertices_ - forest_.size(); }
+
+  // whether u and v are connected by the edges so far
+  bool connected(size_t u, size_t v) {
+    checkVertex(u);
+    checkVertex(v);
+    return components_.sameSet(u, v);
+  }
+
+  /**
+   * Insert an edge
+   *
+   * It costs O(V) like a batch, so the edges should be inserted in
+   * batches whenever possible.
+   */
+  void insertEdge(size_t u, size_t v, T weight) {
+    checkVertex(u);
+    checkVertex(v);
+    insertEdges(std::vector<WeightedEdge<T>>(
+        1, WeightedEdge<T>{weight, (uint32_t)u, (uint32_t)v}));
+  }
+
+  /**
+   * Insert a batch of edges and update the forest
+   *
+   * @param batch: edges in any order, whose ends may be in any order.
+   *               Self-loops are ignored.
+   */
+  void insertEdges(std::vector<WeightedEdge<T>> batch) {
+    // (smaller vertex, larger vertex) as the order of the edges expects
+    size_t n_kept = 0;
+    for (const auto& e : batch) {
+      checkVertex(e.src);
+      checkVertex(e.dst);
+      if (e.src == e.dst) { continue; }
+      batch[n_kept++] = e.src < e.dst ? e : WeightedEdge<T>{e.weight, e.dst, e.src};
+    }
+    batch.resize(n_kept);
+    if (batch.empty()) { return; }
+
+    graph_parallel::parallelSort(batch.begin(), batch.end(), n_threads_);
+
+    merged_.clear();
+    std::merge(forest_.begin(), forest_.end(), batch.begin(), batch.end(),
+               std::back_inserter(merged_));
+
+    // Kruskal's scan of the forest and the batch
+    forest_.clear();
+    cost_ = 0;
+    components_.reset(n_vertices_);
+    for (const auto& e : merged_) {
+      if (forest_.size() + 1 >= n_vertices_) { break; }
+      if (components_.unite(e.src, e.dst)) {
+        forest_.push_back(e);
+        cost_ += e.weight;
+      }
+    }
+  }
+
+private:
+  size_t n_vertices_;
+  size_t n_threads_;
+
+  std::vector<WeightedEdge<T>> forest_;  // in ascending order
+  T cost_;
+  DisjointSet components_;  // the trees of the forest
+
+  std::vector<WeightedEdge<T>> merged_;  // scratch for insertEdges()
+
+  void checkVertex(size_t v) const {
+    if (v >= n_vertices_) { throw std::out_of_range("Out of range: vertex"); }
+  }
+};
+
+
+#endif //GRAPH_INCREMENTAL_MST_H
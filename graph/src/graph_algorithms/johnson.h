@@ -8,63 +8,163 @@
 #include <iostream>
 #include <deque>
 #include <limits>
+#include <string>
+#include <vector>
 
 #include "../directed_graph.h"
+#include "../mapped_file.h"
+#include "../parallel.h"
+#include "apsp_matrix.h"
 #include "bellman_ford.h"
 #include "dijkstra.h"
+#include "next_hop_table.h"
 
 
+/**
+ * Johnson's all-pair shorted path algorithm with streamed output
+ *
+ * Time complexity O(EVlogV). The input graph is not modified, so it is
+ * safe to call concurrently. The Dijkstra searches from different
+ * sources run on a pool of threads, each of which owns a search
+ * workspace. Instead of building the V x V matrix, each row of the
+ * result is handed to "handle_row" as soon as it is computed.
+ *
+ * @param graph: a directed graph
+ * @param handle_row: callable with the signature
+ *                    void(size_t src, const std::vector<T>& costs),
+ *                    where costs[j] is the smallest cost from src to
+ *                    j (the INF value of the workspace if j cannot be
+ *                    reached). It is called concurrently from different
+ *                    threads for different sources.
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param next_hops: optional table of size V which stores the next
+ *                   hops of the shortest paths on return
+ */
+template <class T, class RowHandler>
+void johnson(const DirectedGraph<T>& graph, RowHandler handle_row,
+             size_t n_threads, NextHopTable* next_hops=nullptr) {
+  if (next_hops != nullptr && next_hops->size() != graph.size()) {
+    throw std::invalid_argument(
+        "Invalid argument: different sizes of graph and next-hop table");
+  }
+
+  const auto kINF = SearchWorkspace<T>::infinity();
+
+  // Run Bellman Ford once from a virtual vertex connected to all the
+  // vertices. The smallest costs are the vertex potentials, with which
+  // the reduced cost w(u, v) + p(u) - p(v) of every edge is
+  // non-negative. The graph itself is never modified.
+  std::vector<T> potentials(graph.size());
+  {
+    SearchWorkspace<T> workspace(graph.size());
+    bellmanFordVirtualSource(graph, workspace);
+    for (size_t i=0; i<graph.size(); ++i) { potentials[i] = workspace.cost(i); }
+  }
+
+  // run Dijkstra's algorithm with the reduced costs for each vertex
+  if (n_threads == 0) { n_threads = graph_parallel::defaultThreadCount(); }
+  std::vector<SearchWorkspace<T>> workspaces(n_threads);
+  std::vector<std::vector<T>> rows(n_threads, std::vector<T>(graph.size()));
+
+  graph_parallel::parallelFor(graph.size(), n_threads,
+                              [&](size_t thread_id, size_t i) {
+    SearchWorkspace<T>& workspace = workspaces[thread_id];
+    std::vector<T>& costs_i = rows[thread_id];
+
+    dijkstraPriorityQueueBase(graph, i, i, workspace, &potentials);
+    // recover the original cost from the reduced one
+    for (size_t j=0; j<graph.size(); ++j) {
+      costs_i[j] = workspace.reached(j) ?
+                   workspace.cost(j) + potentials[j] - potentials[i] : kINF;
+    }
+
+    if (next_hops != nullptr) {
+      // A vertex is settled after its previous vertex, so the next hop
+      // of the previous vertex is known when a vertex is visited.
+      next_hops->clearRow(i);
+      for (auto v : workspace.settled()) {
+        size_t prev = workspace.cameFrom(v);
+        next_hops->set(i, v, (v == i || prev == i) ? v : next_hops->get(i, prev));
+      }
+    }
+
+    handle_row(i, costs_i);
+  });
+}
+
 /**
  * Johnson's all-pair shorted path algorithm
  *
  * Time complexity O(EVlogV)
  *
  * @param graph: a directed graph
+ * @param n_threads: No. of threads (0 for the hardware default)
  * @return: a pair of two 2D deques: the first one stores the smallest
  *          cost between each pair of vertices; the second one stores
- *          the previous vertex of each vertex in the shortest path.
+ *          the next vertex after i on the shortest path from i to j
+ *          (V if j cannot be reached from i).
  */
 template <class T>
 std::pair<std::deque<std::deque<T>>, std::deque<std::deque<size_t>>>
-johnson(DirectedGraph<T>& graph) {
-  const auto kINF = (T) (std::numeric_limits<T>::max() / 2.0);
-
-  // Add a new vertex and run Bellman Ford once
-  graph.increaseVertex();
-
-  for (size_t i=0; i<graph.size() - 1; ++i) {
-    graph.connect(graph.size() - 1, i, (T)0);
-  }
+johnson(const DirectedGraph<T>& graph, size_t n_threads=0) {
+  NextHopTable next_hops(graph.size());
+  std::deque<std::deque<T>> costs(graph.size());
 
-  auto result = bellmanFord(graph, graph.size() - 1);
+  // each row is written by only one thread
+  johnson(graph, [&costs](size_t src, const std::vector<T>& costs_src) {
+    costs[src].assign(costs_src.begin(), costs_src.end());
+  }, n_threads, &next_hops);
 
-  // re-weight the graph
-  for (size_t i=0; i<graph.size() - 1; ++i) {
-    for (size_t j=0; j<graph.size() - 1; ++j) {
-      graph.increaseWeight(i, j, result.first[i] - result.first[j]);
-    }
-  }
+  return std::make_pair(costs, next_hops.toDeque());
+}
 
-  // delete the new vertex and run Dijkstra's algorithm for each vertex
-  graph.decreaseVertex();
+/**
+ * Johnson's all-pair shorted path algorithm which returns an
+ * ApspMatrix
+ *
+ * @param graph: a directed graph
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param path: if not empty, the matrix is stored in this memory-mapped
+ *              file instead of RAM
+ * @param next_hops: optional table of size V which stores the next
+ *                   hops of the shortest paths on return
+ * @return: the smallest costs (ApspMatrix<T>::infinity() if there is
+ *          no path)
+ */
+template <class T>
+ApspMatrix<T> johnsonMatrix(const DirectedGraph<T>& graph, size_t n_threads=0,
+                            const std::string& path="",
+                            NextHopTable* next_hops=nullptr) {
+  const size_t n = graph.size();
+  ApspMatrix<T> costs(n, path);
+  T* output = costs.data();
 
-  // TODO:: implement reconstruction
-  std::deque<std::deque<size_t>> came_from;
-  std::deque<std::deque<T>> costs;
-  for (size_t i=0; i<graph.size(); ++i) {
-    std::pair<std::deque<T>, std::deque<size_t>> result_i = dijkstra(graph, i);
-    costs.push_back(result_i.first);
-  }
+  // rows of different sources do not overlap in the matrix
+  johnson(graph, [output, n](size_t src, const std::vector<T>& costs_src) {
+    std::copy(costs_src.begin(), costs_src.end(), output + src*n);
+  }, n_threads, next_hops);
+  costs.sync();
 
-  // re-weight the graph (recover the original cost)
-  for (size_t i=0; i<graph.size(); ++i) {
-    for (size_t j=0; j<graph.size(); ++j) {
-      costs[i][j] += result.first[j] - result.first[i];
-    }
-  }
-
-  return std::make_pair(costs, came_from);
+  return costs;
 }
 
+/**
+ * Johnson's all-pair shorted path algorithm which writes the result
+ * into a memory-mapped file instead of RAM.
+ *
+ * The file holds the V x V cost matrix in row-major order as raw
+ * values of type T, which can be mapped again by ApspMatrix<T>::open().
+ *
+ * @param graph: a directed graph
+ * @param path: output file path
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param next_hops: optional table of size V which stores the next
+ *                   hops of the shortest paths on return
+ */
+template <class T>
+void johnsonToFile(const DirectedGraph<T>& graph, const std::string& path,
+                   size_t n_threads=0, NextHopTable* next_hops=nullptr) {
+  johnsonMatrix(graph, n_threads, path, next_hops);
+}
 
-#endif //GRAPH_JOHNSON_H
\ No newline at end of file
+#endif //GRAPH_JOHNSON_H
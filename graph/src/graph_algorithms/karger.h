@@ -5,69 +5,272 @@
 #ifndef GRAPH_KARGER_H
 #define GRAPH_KARGER_H
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <random>
+#include <utility>
 #include <vector>
 
+#include "../disjoint_set.h"
+#include "../edge_list.h"
+#include "../parallel.h"
 #include "../undirected_graph.h"
 
 
+// an edge of a multigraph (weights are ignored by the min cut)
+typedef std::pair<uint32_t, uint32_t> cut_edge;
+
+/**
+ * Copy out the edges of an undirected graph for the min cut algorithms
+ */
+template <class T>
+std::vector<cut_edge> cutEdgeList(const UndirectedGraph<T>& graph) {
+  std::vector<cut_edge> edges;
+  for (const auto& e : edgeList(graph)) { edges.push_back(std::make_pair(e.src, e.dst)); }
+  return edges;
+}
+
 /**
- * Contract an undirected graph until only two non-empty linked lists remain
+ * Contract a multigraph at random until "n_remaining" vertices remain
  *
- * @param graph: UndirectedGraph object
- * @param display
- * @return: the number of edges in the contracted graph
+ * Contracting a random edge among those left is the same as taking the
+ * edges in a random order and merging their ends, which is done with a
+ * Fisher-Yates shuffle that stops as soon as enough vertices have been
+ * merged. An edge inside a merged vertex is a self-loop and is skipped.
  *
- * TODO: finish
+ * @param edges: edges of the multigraph, which are permuted
+ * @param unions: the merged vertices, reset to the vertices of the
+ *                multigraph
+ * @param n_remaining: No. of vertices to remain (at least 1)
+ * @param generator: random number generator
  */
-template <class T>
-inline size_t graphContract(UndirectedGraph<T>& graph, bool display=false) {
-  // Distribution on which to apply the generator
-  std::vector<T> connected_vertices = graph.getConnectedVertices();
+template <class Generator>
+void randomContract(std::vector<cut_edge>& edges, DisjointSet& unions,
+                    size_t n_remaining, Generator& generator) {
+  for (size_t k = 0; k < edges.size() && unions.countSets() > n_remaining; ++k) {
+    std::uniform_int_distribution<size_t> pick(k, edges.size() - 1);
+    std::swap(edges[k], edges[pick(generator)]);
+    unions.unite(edges[k].first, edges[k].second);
+  }
+}
 
-  std::random_device rd;
-  std::default_random_engine generator(rd());
-  while ( connected_vertices.size() > 2 ) {
-    std::uniform_int_distribution<long unsigned> distribution(0, 10000000);
+/**
+ * Count the edges between the merged vertices
+ */
+inline size_t countCutEdges(const std::vector<cut_edge>& edges, DisjointSet& unions) {
+  size_t cut = 0;
+  for (const auto& e : edges) {
+    if (!unions.sameSet(e.first, e.second)) { ++cut; }
+  }
+  return cut;
+}
 
-    unsigned long first = distribution(generator) % connected_vertices.size();
-    unsigned long second = distribution(generator) % (connected_vertices.size() - 1);
-    if (second >= first) { ++second; }
+/**
+ * Merge the parallel edges of a multigraph into one edge whose weight
+ * is their No.
+ *
+ * @param edges: edges weighted by their No. of parallel edges, with
+ *               src < dst
+ */
+inline void mergeParallelEdges(std::vector<WeightedEdge<size_t>>& edges) {
+  std::sort(edges.begin(), edges.end(),
+            [](const WeightedEdge<size_t>& e1, const WeightedEdge<size_t>& e2) {
+    return e1.src != e2.src ? e1.src < e2.src : e1.dst < e2.dst;
+  });
+  size_t n_kept = 0;
+  for (const auto& e : edges) {
+    if (n_kept > 0 && edges[n_kept - 1].src == e.src && edges[n_kept - 1].dst == e.dst) {
+      edges[n_kept - 1].weight += e.weight;
+    } else {
+      edges[n_kept++] = e;
+    }
+  }
+  edges.resize(n_kept);
+}
 
-    if ( display ) {
-      std::cout << connected_vertices[first] << " " << connected_vertices[second] << std::endl;
+/**
+ * Exact min cut of a small multigraph by trying each partition
+ *
+ * @param edges: edges weighted by their No. of parallel edges
+ * @param n_vertices: No. of vertices (at most 16)
+ */
+inline size_t bruteForceMinCut(const std::vector<WeightedEdge<size_t>>& edges,
+                               size_t n_vertices) {
+  size_t min_cut = std::numeric_limits<size_t>::max();
+  // vertex n_vertices - 1 is always on the unset side
+  for (uint32_t side = 1; side + 1 < (1u << n_vertices); side += 2) {
+    size_t cut = 0;
+    for (const auto& e : edges) {
+      if (((side >> e.src) & 1u) != ((side >> e.dst) & 1u)) { cut += e.weight; }
     }
-    graph.collapse(connected_vertices[first], connected_vertices[second]);
+    min_cut = std::min(min_cut, cut);
+  }
+  return min_cut;
+}
 
-    connected_vertices = graph.getConnectedVertices();
-    if ( display) { graph.display(); }
+/**
+ * Recursion of kargerStein()
+ *
+ * The first contractions are the least likely to hit the min cut, so
+ * the graph is only contracted to about n/sqrt(2) vertices, twice
+ * independently, and each of them is solved recursively. A run finds
+ * the min cut with probability Ω(1/logn).
+ *
+ * The parallel edges are merged after each contraction, so a
+ * multigraph of n vertices has at most n(n-1)/2 edges. An edge of
+ * weight w is contracted with probability proportional to w by ordering
+ * the edges by exponential random clocks with rate w.
+ *
+ * @param edges: edges weighted by their No. of parallel edges
+ * @param n_vertices: No. of vertices in the multigraph
+ * @param generator: random number generator
+ */
+template <class Generator>
+size_t kargerSteinRecursion(const std::vector<WeightedEdge<size_t>>& edges,
+                            size_t n_vertices, Generator& generator) {
+  // a disconnected graph, which includes the case that all the edges
+  // have been contracted
+  if (edges.empty()) { return 0; }
+  if (n_vertices <= 6) { return bruteForceMinCut(edges, n_vertices); }
+
+  const size_t n_remaining =
+      (size_t)std::ceil(1 + n_vertices / std::sqrt(2.0));
+  std::exponential_distribution<double> clock;
+  size_t min_cut = std::numeric_limits<size_t>::max();
+  for (int k = 0; k < 2; ++k) {
+    // <time, edge>
+    std::vector<std::pair<double, size_t>> order(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) {
+      order[i] = std::make_pair(clock(generator)/edges[i].weight, i);
+    }
+    std::sort(order.begin(), order.end());
+
+    DisjointSet unions(n_vertices);
+    for (size_t i = 0; i < order.size() && unions.countSets() > n_remaining; ++i) {
+      unions.unite(edges[order[i].second].src, edges[order[i].second].dst);
+    }
+
+    // relabel the merged vertices as 0, 1, ..., n_remaining - 1 and
+    // drop the self-loops
+    std::vector<uint32_t> labels(n_vertices, std::numeric_limits<uint32_t>::max());
+    uint32_t n_labels = 0;
+    for (size_t v = 0; v < n_vertices; ++v) {
+      size_t root = unions.find(v);
+      if (labels[root] == std::numeric_limits<uint32_t>::max()) { labels[root] = n_labels++; }
+    }
+    std::vector<WeightedEdge<size_t>> contracted;
+    for (const auto& e : edges) {
+      uint32_t u = labels[unions.find(e.src)];
+      uint32_t v = labels[unions.find(e.dst)];
+      if (u != v) {
+        contracted.push_back({e.weight, std::min(u, v), std::max(u, v)});
+      }
+    }
+    mergeParallelEdges(contracted);
+
+    min_cut = std::min(min_cut, kargerSteinRecursion(contracted, n_labels, generator));
+  }
+  return min_cut;
+}
+
+/**
+ * Run independent trials of a min cut algorithm on a pool of threads
+ *
+ * Each thread owns a generator, which is seeded with the seed and the
+ * No. of the trial before each trial, so the result only depends on
+ * the seed and not on the No. of threads.
+ *
+ * @param trial: callable with the signature
+ *               size_t(size_t thread_id, std::mt19937_64& generator),
+ *               which returns the cut found by a trial
+ * @return: the smallest cut found by the trials
+ */
+template <class Trial>
+size_t runMinCutTrials(size_t n_trials, size_t n_threads, unsigned seed, Trial trial) {
+  if (n_trials == 0) {
+    throw std::invalid_argument("Invalid argument: no trial");
   }
+  if (n_threads == 0) { n_threads = graph_parallel::defaultThreadCount(); }
+
+  std::vector<std::mt19937_64> generators(n_threads);
+  std::vector<size_t> min_cuts(n_threads, std::numeric_limits<size_t>::max());
+  graph_parallel::parallelFor(n_trials, n_threads, [&](size_t thread_id, size_t i) {
+    std::seed_seq seeds{(uint64_t)seed, (uint64_t)i};
+    generators[thread_id].seed(seeds);
+    min_cuts[thread_id] = std::min(min_cuts[thread_id],
+                                   trial(thread_id, generators[thread_id]));
+  });
 
-  return int(graph.countWeightedEdge());
+  return *std::min_element(min_cuts.begin(), min_cuts.end());
 }
 
 /**
- * Karger's mini-cut algorithm on an undirected graph
+ * Karger's min cut algorithm on an undirected graph
  *
- * @param graph: UndirectedGraph object
- * @param n: the number of random contractions
- * @return: the number of min cut
+ * Each trial contracts random edges of a flat edge array with a
+ * disjoint set until two vertices remain, in O(Eα(V)) time. A trial
+ * finds the min cut with probability at least 2/(V(V-1)).
+ *
+ * @param graph: UndirectedGraph object with at least 2 vertices (the
+ *               weights are ignored)
+ * @param n_trials: the number of random contractions
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param seed: seed of the random contractions
+ * @return: the number of edges in the smallest cut found
  */
 template <class T>
-size_t karger(const UndirectedGraph<T>& graph, size_t n) {
+size_t karger(const UndirectedGraph<T>& graph, size_t n_trials,
+              size_t n_threads=0, unsigned seed=std::random_device()()) {
+  if (graph.size() < 2) {
+    throw std::invalid_argument("Invalid argument: less than 2 vertices");
+  }
+
+  if (n_threads == 0) { n_threads = graph_parallel::defaultThreadCount(); }
 
-  size_t min_cut = graph.countEdge();
-  size_t cut;
+  const std::vector<cut_edge> edges = cutEdgeList(graph);
+  // scratch of each thread
+  std::vector<std::vector<cut_edge>> edges_copies(n_threads);
+  std::vector<DisjointSet> unions(n_threads);
 
-  for (unsigned int i = 0; i < n; ++i) {
-    auto graph_copy(graph);
+  return runMinCutTrials(n_trials, n_threads, seed,
+                         [&](size_t thread_id, std::mt19937_64& generator) {
+    edges_copies[thread_id] = edges;
+    unions[thread_id].reset(graph.size());
+    randomContract(edges_copies[thread_id], unions[thread_id], 2, generator);
+    return countCutEdges(edges_copies[thread_id], unions[thread_id]);
+  });
+}
 
-    cut = graphContract(graph_copy);
-    if (cut < min_cut) { min_cut = cut; }
+/**
+ * Karger-Stein's recursive contraction min cut algorithm on an
+ * undirected graph
+ *
+ * @param graph: UndirectedGraph object with at least 2 vertices (the
+ *               weights are ignored)
+ * @param n_trials: the number of recursive contractions
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param seed: seed of the random contractions
+ * @return: the number of edges in the smallest cut found
+ */
+template <class T>
+size_t kargerStein(const UndirectedGraph<T>& graph, size_t n_trials,
+                   size_t n_threads=0, unsigned seed=std::random_device()()) {
+  if (graph.size() < 2) {
+    throw std::invalid_argument("Invalid argument: less than 2 vertices");
   }
 
-  return min_cut;
+  std::vector<WeightedEdge<size_t>> edges;
+  for (const auto& e : cutEdgeList(graph)) { edges.push_back({1, e.first, e.second}); }
+  mergeParallelEdges(edges);
+
+  const size_t n_vertices = graph.size();
+  return runMinCutTrials(n_trials, n_threads, seed,
+                         [&edges, n_vertices](size_t, std::mt19937_64& generator) {
+    return kargerSteinRecursion(edges, n_vertices, generator);
+  });
 }
 
 
-#endif //GRAPH_KARGER_H
\ No newline at end of file
+#endif //GRAPH_KARGER_H
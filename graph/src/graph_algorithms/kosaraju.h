@@ -5,9 +5,12 @@
 #ifndef GRAPH_KOSARAJU_H
 #define GRAPH_KOSARAJU_H
 
+#include <cstdint>
 #include <deque>
+#include <vector>
 
 #include "../directed_graph.h"
+#include "../compressed_graph.h"
 #include "depth_first_search.h"
 
 
@@ -54,5 +57,66 @@ std::deque<std::deque<size_t>> kosaraju(DirectedGraph<T>& graph) {
   return scc;
 }
 
+/**
+ * Kosaraju's algorithm on a compressed directed graph, which labels the
+ * vertices instead of listing the components
+ *
+ * A compressed graph is read-only, so the first pass runs on a reversed
+ * copy of it instead of reversing it in place. Besides the two graphs,
+ * the memory is a few bytes per vertex (see CompressedGraph::reversed()
+ * for the memory to build the copy).
+ *
+ * @param graph: a compressed directed graph
+ * @return: the component of each vertex, where the components are
+ *          numbered in the order in which kosaraju() returns them
+ */
+inline std::vector<uint32_t> kosarajuComponents(const CompressedGraph& graph) {
+  // First pass on the reversed graph
+  std::vector<uint32_t> finish_time;
+  finish_time.reserve(graph.size());
+  {
+    CompressedGraph reversed = graph.reversed();
+    std::vector<bool> visited (graph.size(), false);
+    for (std::size_t i = 0; i < graph.size(); ++i) {
+      if (!visited[i]) {
+        std::vector<size_t> search = depthFirstSearch(reversed, i, visited);
+        finish_time.insert(finish_time.end(), search.begin(), search.end());
+      }
+    }
+  }
+
+  // Second pass on the original graph, from the last finished vertex
+  std::vector<uint32_t> components(graph.size());
+  std::vector<bool> reversed_visited (graph.size(), false);
+  uint32_t n_components = 0;
+  for (auto v = finish_time.rbegin(); v != finish_time.rend(); ++v) {
+    if (!reversed_visited[*v]) {
+      for (size_t u : depthFirstSearch(graph, *v, reversed_visited)) {
+        components[u] = n_components;
+      }
+      ++n_components;
+    }
+  }
+
+  return components;
+}
+
+/**
+ * Kosaraju's algorithm on a compressed directed graph
+ *
+ * @param graph: a compressed directed graph
+ * @return: the strongly connected components, whose vertices are in
+ *          ascending order
+ */
+inline std::deque<std::deque<size_t>> kosaraju(const CompressedGraph& graph) {
+  std::vector<uint32_t> components = kosarajuComponents(graph);
+  std::deque<std::deque<size_t>> scc;
+  for (size_t v = 0; v < graph.size(); ++v) {
+    if (components[v] >= scc.size()) { scc.resize(components[v] + 1); }
+    scc[components[v]].push_back(v);
+  }
+  return scc;
+}
+
 
 #endif //GRAPH_KOSARAJU_H
\ No newline at end of file
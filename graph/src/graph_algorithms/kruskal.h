@@ -6,127 +6,163 @@
 #define GRAPH_KRUSKAL_H
 
 #include <algorithm>
+#include <stdexcept>
+#include <vector>
 
-#include "breath_first_search.h"
+#include "../disjoint_set.h"
+#include "../edge_list.h"
+#include "../parallel.h"
 #include "../undirected_graph.h"
 
 
-// a union-find data structure composed of the head vertex of
-// each union and its rank
-typedef std::vector<std::pair<size_t, size_t>> union_find;
-
-// Comparator
-template <class T>
-struct edgeLess {
-  // <weight, <src, dst>>
-  typedef std::pair<T, std::pair<size_t, size_t>> graph_edge;
-
-  bool operator()(const graph_edge& e1, const graph_edge& e2) {
-    return e1.first < e2.first;
-  }
-};
-
 /**
- * Find the head vertex of a vertex.
+ * Scan sorted edges and add those which connect two different unions
+ * to the minimum spanning tree
  *
- * @param src: source vertex
- * @param union_: union-find data structure
- * @return: head vertex
+ * @param first, last: edges in ascending order
+ * @param unions: disjoint sets of the vertices
+ * @param mst: edges (src, dst) in the minimum spanning tree
+ * @param cost: total cost of the minimum spanning tree
+ * @param n_vertices: No. of vertices in the graph
  */
-size_t find(size_t src, const union_find& union_) {
-  size_t head(union_[src].first);
-  while ( src != head ) {
-    src = head;
-    head = union_[src].first;
-  }
-  return head;
-}
+template <class T, class EdgeIt>
+void kruskalScan(EdgeIt first, EdgeIt last, DisjointSet& unions,
+                 std::vector<std::pair<size_t, size_t>>& mst, T& cost,
+                 size_t n_vertices) {
+  for ( ; first != last; ++first ) {
+    if (mst.size() + 1 >= n_vertices) { break; }
 
-/**
- * Fuse the two unions by rank
- *
- * @param head1: head vertex 1
- * @param head2: head vertex 2
- * @param union_: union-find data structure
- */
-void unionByRank(size_t head1, size_t head2, union_find& union_) {
-
-  if ( union_[head1].second > union_[head2].second ) {
-    union_[head2].first = union_[head1].first;
-  } else {
-    union_[head1].first = union_[head2].first;
-    // the rank changes only when two unions have the same rank
-    if ( union_[head1].second == union_[head2].second ) {
-      ++union_[head2].second;
+    // if they are in different unions
+    if ( unions.unite(first->src, first->dst) ) {
+      mst.push_back(std::make_pair(first->src, first->dst));
+      cost += first->weight;
     }
   }
 }
 
-
 //
 // Implementation of the Kruskal's minimum spanning tree algorithm
 //
-// Union-by-rank is implemented so the time complexity is
-// O(2ElogV) = O(ElogV). However, Kruskal's algorithm is bounded by
-// edge sorting, which has a time complexity of O(ElogE) = O(ElogV),
-// E <= V^2.
+// The unions are merged in amortized O(α(V)) time per edge (see
+// DisjointSet). Kruskal's algorithm is bounded by edge sorting, which
+// has a time complexity of O(ElogE) = O(ElogV), E <= V^2.
 //
 // @param graph: undirected graph object
 //
 // @return: a pair in which the first element is the total cost of
 //          the minimum spanning tree while the second one is a
-//          vector of the leaves (<from vertex, to vertex>) in the
-//          tree in sequence.
+//          vector of the leaves (<smaller vertex, larger vertex>) in
+//          the tree in sequence.
 //
 template <class T> std::pair<T, std::vector<std::pair<size_t, size_t>>>
 kruskal(const UndirectedGraph<T>& graph) {
+  // each edge only once, sorted in ascending order of (weight, src, dst)
+  std::vector<WeightedEdge<T>> edges = edgeList(graph);
+  std::sort(edges.begin(), edges.end());
+
+  DisjointSet unions(graph.size());
+
+  // edges (src, dst) in the minimum spanning tree in sequence
+  std::vector<std::pair<size_t, size_t>> mst;
+  // total cost of the minimum spanning tree
+  T cost = 0;
+  kruskalScan(edges.begin(), edges.end(), unions, mst, cost, graph.size());
+
   // check the connectivity of the graph
-  auto bfs_search = breathFirstSearch(graph, 0);
-  if ( bfs_search.size() != graph.size() ) {
+  if ( mst.size() + 1 < graph.size() ) {
     throw std::invalid_argument("Input graph is not connected!");
   }
+  return std::make_pair(cost, mst);
+}
 
-  // <weight, <src, dst>>
-  typedef std::pair<T, std::pair<size_t, size_t>> graph_edge;
-  // store all the edges in a vector
-  std::vector<graph_edge> edges;
-  // read out all the edges
-  for ( size_t i=0; i<graph.size(); ++i ) {
-    graph::Edge<T>* current_edge = graph.getList(i);
-    while ( current_edge ) {
-      edges.push_back(std::make_pair(
-          current_edge->weight, std::make_pair(i, current_edge->dst)));
-      current_edge = current_edge->next;
+/**
+ * Recursion of filterKruskal()
+ *
+ * The edges are partitioned around a pivot like quicksort. The light
+ * part is processed first; then the heavy edges whose vertices are
+ * already in the same union are filtered out before the heavy part
+ * is processed. Small parts are sorted and scanned.
+ *
+ * Only the light part is a recursive call, while the heavy part is
+ * processed by the loop. As in introsort, the parts are sorted and
+ * scanned once depth_limit partitions were made on the way to them, so
+ * that bad pivots cannot nest the calls deeper than that.
+ */
+template <class T, class EdgeIt>
+void filterKruskalRecursion(EdgeIt first, EdgeIt last, DisjointSet& unions,
+                            std::vector<std::pair<size_t, size_t>>& mst,
+                            T& cost, size_t n_vertices, size_t n_threads,
+                            size_t depth_limit) {
+  // Below this size the edges are sorted. With several threads the
+  // parts are large enough for a parallel sort, which is faster than
+  // the sequential partitioning.
+  const size_t sort_threshold =
+      n_threads > 1 ? 2*n_threads*graph_parallel::kMinSortChunk : 1024;
+
+  while (true) {
+    const size_t n = (size_t)(last - first);
+    if (n < sort_threshold || depth_limit == 0) {
+      graph_parallel::parallelSort(first, last, n_threads);
+      kruskalScan(first, last, unions, mst, cost, n_vertices);
+      return;
     }
+    --depth_limit;
+
+    // The median of three edges is the pivot. Since the edges are
+    // distinct, both parts are not empty.
+    WeightedEdge<T> a = *first, b = *(first + n/2), c = *(last - 1);
+    WeightedEdge<T> pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+    EdgeIt middle = std::partition(first, last, [&pivot](const WeightedEdge<T>& e) {
+      return e < pivot;
+    });
+
+    filterKruskalRecursion(first, middle, unions, mst, cost, n_vertices, n_threads,
+                           depth_limit);
+    if (mst.size() + 1 >= n_vertices) { return; }
+
+    EdgeIt kept = std::partition(middle, last, [&unions](const WeightedEdge<T>& e) {
+      return !unions.sameSet(e.src, e.dst);
+    });
+    first = middle;
+    last = kept;
   }
-  // sort the edges in descending order
-  std::sort(edges.begin(), edges.end(), edgeLess<T>());
+}
+
+//
+// Implementation of the Filter-Kruskal's minimum spanning tree algorithm
+//
+// Instead of sorting all the edges, the edges are partitioned around
+// pivots like quicksort, and the heavy edges inside a union are
+// discarded before they are sorted. The expected time is
+// O(E + VlogVlog(E/V)) on random graphs, i.e. close to linear when
+// E >> V, and O(ElogE) at worst since the partitions are nested at
+// most 2log(E) deep. The small parts which are sorted use a parallel
+// sort.
+//
+// @param graph: undirected graph object
+// @param n_threads: No. of threads for sorting (0 for the hardware default)
+//
+// @return: the same minimum spanning tree as kruskal()
+//
+template <class T> std::pair<T, std::vector<std::pair<size_t, size_t>>>
+filterKruskal(const UndirectedGraph<T>& graph, size_t n_threads=0) {
+  if (n_threads == 0) { n_threads = graph_parallel::defaultThreadCount(); }
+  std::vector<WeightedEdge<T>> edges = edgeList(graph);
 
-  union_find union_;
+  DisjointSet unions(graph.size());
 
-  // initialization
-  for ( size_t i=0; i<graph.size(); ++i ) {
-    union_.push_back(std::make_pair(i, 0));
-  }
+  // 2log(E) partitions at most, as in introsort
+  size_t depth_limit = 0;
+  for (size_t n = edges.size(); n > 1; n /= 2) { depth_limit += 2; }
 
-  // edges (src, dst) in the minimum spanning tree in sequence
   std::vector<std::pair<size_t, size_t>> mst;
-  // total cost of the minimum spanning tree
   T cost = 0;
-  for ( auto v : edges ) {
-    if (mst.size() == graph.size()) { break; }
-
-    // O(ElogV) in worst case for union-by-rank
-    size_t head_src = find(v.second.first, union_);
-    // O(ElogV) in worst case for union-by-rank
-    size_t head_dst = find(v.second.second, union_);
+  filterKruskalRecursion(edges.begin(), edges.end(), unions, mst, cost,
+                         graph.size(), n_threads, depth_limit);
 
-    // if they are in different unions
-    if ( head_src != head_dst ) {
-      mst.push_back(v.second);
-      cost += v.first;
-      unionByRank(head_src, head_dst, union_);
-    }
+  if ( mst.size() + 1 < graph.size() ) {
+    throw std::invalid_argument("Input graph is not connected!");
   }
   return std::make_pair(cost, mst);
 }
@@ -0,0 +1,189 @@
+//
+// Matrix products over the (min, +) semiring, where "+" is replaced by
+// min and "*" is replaced by +, and the all-pair shortest path
+// algorithm based on repeated squaring of the cost matrix.
+//
+
+#ifndef GRAPH_MIN_PLUS_H
+#define GRAPH_MIN_PLUS_H
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../directed_graph.h"
+#include "../parallel.h"
+
+
+/**
+ * Write the V x V cost matrix of the edges in row-major order into a
+ * buffer of V x V entries, e.g. a memory-mapped file
+ *
+ * @param graph: a directed graph
+ * @param inf: the cost of a pair of vertices which are not connected
+ * @param costs: costs[i*V + j] is the weight of (i, j), 0 if i == j
+ */
+template <class T>
+void edgeCostMatrix(const DirectedGraph<T>& graph, T inf, T* costs) {
+  const size_t n = graph.size();
+  std::fill(costs, costs + n*n, inf);
+  for (size_t i=0; i<n; ++i) {
+    costs[i*n + i] = (T)0;
+
+    graph::Edge<T>* current_edge = graph.getList(i);
+    while (current_edge != nullptr) {
+      costs[i*n + current_edge->dst] = current_edge->weight;
+      current_edge = current_edge->next;
+    }
+  }
+}
+
+/**
+ * Build the V x V cost matrix of the edges in row-major order
+ *
+ * @param graph: a directed graph
+ * @param inf: the cost of a pair of vertices which are not connected
+ * @return: costs[i*V + j] is the weight of (i, j), 0 if i == j
+ */
+template <class T>
+std::vector<T> edgeCostMatrix(const DirectedGraph<T>& graph, T inf) {
+  std::vector<T> costs(graph.size()*graph.size());
+  edgeCostMatrix(graph, inf, costs.data());
+
+  return costs;
+}
+
+/**
+ * Min-plus multiply-add of a tile of V x V row-major matrices
+ *
+ *   c[i][j] = min(c[i][j], a[i][k] + b[k][j])
+ *
+ * for k in [k0, k1), i in [i0, i1) and j in [j0, j1).
+ *
+ * Entries of "a" no smaller than "threshold" are treated as INF and
+ * skipped, which leaves a branch-free inner loop over contiguous memory
+ * that the compiler can vectorize. Adding a finite cost to INF may drift
+ * it below INF, but it stays above "threshold" and should be clamped
+ * back by the caller.
+ *
+ * k is the outermost loop, so the matrices may overlap: with a, b and c
+ * all pointing to the same matrix this is a tile of the Floyd-Warshall's
+ * updates.
+ *
+ * @param a: left operand
+ * @param b: right operand
+ * @param c: accumulator
+ * @param n: No. of rows (and columns) of each matrix
+ * @param threshold: costs no smaller than it are INF
+ */
+template <class T>
+void minPlusTile(const T* a, const T* b, T* c, size_t n, T threshold,
+                 size_t k0, size_t k1, size_t i0, size_t i1,
+                 size_t j0, size_t j1) {
+  for (size_t k = k0; k < k1; ++k) {
+    const T* row_b = b + k*n;
+    for (size_t i = i0; i < i1; ++i) {
+      const T a_ik = a[i*n + k];
+      if (a_ik >= threshold) { continue; }
+
+      // each j only reads and writes the j-th column, so row_b and
+      // row_c may be the same row
+      T* row_c = c + i*n;
+      for (size_t j = j0; j < j1; ++j) {
+        T new_cost = a_ik + row_b[j];
+        row_c[j] = new_cost < row_c[j] ? new_cost : row_c[j];
+      }
+    }
+  }
+}
+
+/**
+ * Blocked min-plus matrix product c = min(c, a * b)
+ *
+ * Time complexity O(V^3). The output is split into tiles of
+ * block_size x block_size, which are independent and processed by a
+ * pool of threads. Each output tile accumulates the products of one
+ * block of columns of "a" and one block of rows of "b" at a time, so
+ * the three operand tiles stay in cache.
+ *
+ * @param a: left operand, which must not overlap with c
+ * @param b: right operand, which must not overlap with c
+ * @param c: accumulator
+ * @param n: No. of rows (and columns) of each matrix
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param block_size: No. of rows and columns of a tile
+ * @param threshold: costs no smaller than it are INF
+ */
+template <class T>
+void minPlusProduct(const T* a, const T* b, T* c, size_t n, size_t n_threads,
+                    size_t block_size, T threshold) {
+  if (block_size == 0) { block_size = 64; }
+  const size_t n_blocks = (n + block_size - 1) / block_size;
+
+  graph_parallel::parallelFor(n_blocks*n_blocks, n_threads,
+                              [&](size_t, size_t t) {
+    const size_t i0 = (t / n_blocks)*block_size;
+    const size_t j0 = (t % n_blocks)*block_size;
+    const size_t i1 = std::min(n, i0 + block_size);
+    const size_t j1 = std::min(n, j0 + block_size);
+    for (size_t k0 = 0; k0 < n; k0 += block_size) {
+      minPlusTile(a, b, c, n, threshold,
+                  k0, std::min(n, k0 + block_size), i0, i1, j0, j1);
+    }
+  });
+}
+
+/**
+ * All-pair shortest path by repeated squaring of the cost matrix
+ *
+ * Time complexity O(V^3 logV). After s squarings the cost matrix holds
+ * the shortest paths with at most 2^s edges. The squaring stops once
+ * the matrix does not change any more, which is after O(log L)
+ * products for shortest paths of at most L edges. It is an alternative
+ * of floydWarshallBlocked() for small and dense graphs, since the
+ * independent output tiles of each product are easier to spread over
+ * many threads than the dependent phases of Floyd-Warshall.
+ *
+ * @param graph: a directed graph
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @param block_size: No. of rows and columns of a tile
+ * @return: the V x V cost matrix in row-major order. The cost is
+ *          (T)(max/2) if there is no path.
+ */
+template <class T>
+std::vector<T> minPlusShortestPath(const DirectedGraph<T>& graph,
+                                   size_t n_threads=0, size_t block_size=64) {
+  const auto kINF = (T)(std::numeric_limits<T>::max()/2.0);
+  const auto kThreshold = (T)(kINF/2);
+  const size_t n = graph.size();
+
+  std::vector<T> costs = edgeCostMatrix(graph, kINF);
+  std::vector<T> squared;
+
+  // a negative cycle has at most V edges
+  for (size_t length = 1; length < n; length *= 2) {
+    // the diagonal is 0, so the product also keeps the current paths
+    squared = costs;
+    minPlusProduct(costs.data(), costs.data(), squared.data(), n,
+                   n_threads, block_size, kThreshold);
+
+    for (auto& cost : squared) {
+      if (cost >= kThreshold) { cost = kINF; }
+    }
+    for (size_t i = 0; i < n; ++i) {
+      if (squared[i*n + i] < 0) {
+        throw std::invalid_argument("Found negative cycle in the graph!");
+      }
+    }
+
+    // the costs on a negative cycle would keep decreasing
+    if (squared == costs) { break; }
+    costs.swap(squared);
+  }
+
+  return costs;
+}
+
+
+#endif //GRAPH_MIN_PLUS_H
@@ -0,0 +1,102 @@
+//
+// A front end which picks the minimum spanning tree algorithm for the
+// size and the density of the graph.
+//
+
+#ifndef GRAPH_MINIMUM_SPANNING_TREE_H
+#define GRAPH_MINIMUM_SPANNING_TREE_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "boruvka.h"
+#include "kruskal.h"
+#include "prim.h"
+#include "../parallel.h"
+#include "../undirected_graph.h"
+
+
+enum class MstAlgorithm { kDensePrim, kPrim, kFilterKruskal, kBoruvka };
+
+inline std::string mstAlgorithmName(MstAlgorithm algorithm) {
+  switch (algorithm) {
+    case MstAlgorithm::kDensePrim: return "dense Prim";
+    case MstAlgorithm::kPrim: return "Prim";
+    case MstAlgorithm::kFilterKruskal: return "Filter-Kruskal";
+    case MstAlgorithm::kBoruvka: return "Boruvka";
+  }
+  return "";
+}
+
+// The cross-over points measured by benchmarks/benchmark_mst.h, where
+// all the algorithms are dominated by walking the adjacency lists:
+//
+// prim_dense() catches up with the heaps and the sorts above this
+// fraction of the V(V-1)/2 possible edges
+const double kDensePrimMinDensity = 0.5;
+// prim() wins below it while the heap and the keys stay in the cache,
+// and loses to filterKruskal() on larger graphs
+const size_t kPrimMaxVertices = 1 << 16;
+// boruvka() on several threads above this No. of edges, which is a
+// guess rather than a measurement: the benchmark does not time boruvka()
+// against filterKruskal() on several threads, so it is not tuned
+const size_t kBoruvkaMinEdges = 1 << 20;
+
+/**
+ * Pick a minimum spanning tree algorithm
+ *
+ * @param n_vertices: No. of vertices
+ * @param n_edges: No. of (undirected) edges
+ * @param n_threads: No. of threads which may be used
+ */
+inline MstAlgorithm chooseMstAlgorithm(size_t n_vertices, size_t n_edges,
+                                       size_t n_threads) {
+  if (n_vertices > 1 &&
+      n_edges >= kDensePrimMinDensity*n_vertices*(n_vertices - 1)/2) {
+    return MstAlgorithm::kDensePrim;
+  }
+  if (n_vertices <= kPrimMaxVertices) {
+    return MstAlgorithm::kPrim;
+  }
+  if (n_threads > 1 && n_edges >= kBoruvkaMinEdges) {
+    return MstAlgorithm::kBoruvka;
+  }
+  return MstAlgorithm::kFilterKruskal;
+}
+
+/**
+ * Minimum spanning tree by the algorithm which suits the graph
+ *
+ * @param graph: connected undirected graph
+ * @param n_threads: No. of threads (0 for the hardware default)
+ * @return: a pair with the first element being the total cost of the
+ *          minimum spanning tree and the second one being a vector of
+ *          the edges (<smaller vertex, larger vertex>) in the tree.
+ */
+template <class T>
+std::pair<T, std::vector<std::pair<size_t, size_t>>>
+minimumSpanningTree(const UndirectedGraph<T>& graph, size_t n_threads=0) {
+  if (n_threads == 0) { n_threads = graph_parallel::defaultThreadCount(); }
+
+  std::pair<T, std::vector<std::pair<size_t, size_t>>> mst {T(0), {}};
+  // an empty graph has an empty tree, while prim() has no vertex to
+  // start from
+  if (graph.size() == 0) { return mst; }
+
+  switch (chooseMstAlgorithm(graph.size(), graph.countEdge(), n_threads)) {
+    case MstAlgorithm::kDensePrim: mst = prim_dense(graph, 0); break;
+    case MstAlgorithm::kPrim: mst = prim(graph, 0); break;
+    case MstAlgorithm::kFilterKruskal: return filterKruskal(graph, n_threads);
+    case MstAlgorithm::kBoruvka: return boruvka(graph, n_threads);
+  }
+
+  // Prim reports the edges as <from vertex, to vertex>
+  for (auto& e : mst.second) {
+    if (e.first > e.second) { std::swap(e.first, e.second); }
+  }
+  return mst;
+}
+
+
+#endif //GRAPH_MINIMUM_SPANNING_TREE_H
@@ -0,0 +1,237 @@
+//
+// A compact V x V table of the next vertex on the shortest path
+// between each pair of vertices, filled by the all-pair shortest path
+// algorithms.
+//
+
+#ifndef GRAPH_NEXT_HOP_TABLE_H
+#define GRAPH_NEXT_HOP_TABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../mapped_file.h"
+
+
+class NextHopTable;
+
+//
+// The vertices on the shortest path from src to dst (both included),
+// which are generated one at a time by following the next hops. Each
+// step is O(1), so walking the path is O(path length).
+//
+class NextHopPath {
+public:
+  class iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef size_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const size_t* pointer;
+    typedef size_t reference;
+
+    iterator(const NextHopTable* table, size_t current, size_t dst)
+        : table_(table), current_(current), dst_(dst) {}
+
+    size_t operator*() const { return current_; }
+    iterator& operator++();
+    iterator operator++(int) {
+      iterator copy(*this);
+      ++(*this);
+      return copy;
+    }
+
+    bool operator==(const iterator& other) const {
+      return current_ == other.current_;
+    }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+
+  private:
+    const NextHopTable* table_;
+    size_t current_;
+    size_t dst_;
+  };
+
+  NextHopPath(const NextHopTable* table, size_t src, size_t dst)
+      : table_(table), src_(src), dst_(dst) {}
+
+  iterator begin() const;
+  iterator end() const;
+
+  // whether dst is not reachable from src
+  bool empty() const { return begin() == end(); }
+
+private:
+  const NextHopTable* table_;
+  size_t src_;
+  size_t dst_;
+};
+
+class NextHopTable {
+public:
+  /**
+   * constructor
+   *
+   * The entries are unsigned integers of the narrowest width (1, 2, 4
+   * or 8 bytes) which can hold all the vertices and the "none" marker.
+   *
+   * @param size: No. of vertices
+   * @param path: if not empty, the table is stored in this memory-mapped
+   *              file instead of RAM
+   */
+  explicit NextHopTable(size_t size, const std::string& path="")
+      : size_(size), width_(widthFor(size)) {
+    size_t bytes = size*size*width_;
+    if (path.empty()) {
+      buffer_.resize(bytes);
+      bytes_ = buffer_.data();
+    } else {
+      file_.reset(new MappedFile(path, bytes));
+      bytes_ = static_cast<unsigned char*>(file_->data());
+    }
+    clear();
+  }
+
+  NextHopTable(const NextHopTable&) = delete;
+  NextHopTable& operator=(const NextHopTable&) = delete;
+  NextHopTable(NextHopTable&&) = default;
+
+  // get the narrowest width in bytes for a graph with "size" vertices
+  static size_t widthFor(size_t size) {
+    if (size < std::numeric_limits<uint8_t>::max()) { return 1; }
+    if (size < std::numeric_limits<uint16_t>::max()) { return 2; }
+    if (size < std::numeric_limits<uint32_t>::max()) { return 4; }
+    return 8;
+  }
+
+  // get No. of vertices
+  size_t size() const { return size_; }
+
+  // get the width of an entry in bytes
+  size_t width() const { return width_; }
+
+  // the entry of a pair of vertices which are not connected
+  size_t none() const {
+    return width_ == 8 ? std::numeric_limits<uint64_t>::max()
+                       : (((size_t)1) << (8*width_)) - 1;
+  }
+
+  // reset all the entries to none()
+  void clear() {
+    std::fill(bytes_, bytes_ + size_*size_*width_, (unsigned char)0xff);
+  }
+
+  // reset the entries from a source vertex to none()
+  void clearRow(size_t src) {
+    unsigned char* row = bytes_ + src*size_*width_;
+    std::fill(row, row + size_*width_, (unsigned char)0xff);
+  }
+
+  /**
+   * Copy the table into the 2D deque returned by floydWarshall() and
+   * johnson(). This is O(V^2).
+   *
+   * @return: the next vertex after i on the shortest path from i to j
+   *          (V if j cannot be reached from i)
+   */
+  std::deque<std::deque<size_t>> toDeque() const {
+    std::deque<std::deque<size_t>> next(size_, std::deque<size_t>(size_, size_));
+    for (size_t i=0; i<size_; ++i) {
+      for (size_t j=0; j<size_; ++j) {
+        size_t next_ij = get(i, j);
+        if (next_ij != none()) { next[i][j] = next_ij; }
+      }
+    }
+    return next;
+  }
+
+  /**
+   * Get the raw row-major entries
+   *
+   * @tparam I: an unsigned integer type whose size equals width()
+   */
+  template <class I>
+  I* data() {
+    if (sizeof(I) != width_) {
+      throw std::invalid_argument("Invalid argument: wrong entry width");
+    }
+    return reinterpret_cast<I*>(bytes_);
+  }
+
+  // get the vertex after src on the shortest path from src to dst
+  size_t get(size_t src, size_t dst) const {
+    size_t k = src*size_ + dst;
+    switch (width_) {
+      case 1: return bytes_[k];
+      case 2: return reinterpret_cast<const uint16_t*>(bytes_)[k];
+      case 4: return reinterpret_cast<const uint32_t*>(bytes_)[k];
+      default: return reinterpret_cast<const uint64_t*>(bytes_)[k];
+    }
+  }
+
+  // set the vertex after src on the shortest path from src to dst
+  void set(size_t src, size_t dst, size_t next) {
+    size_t k = src*size_ + dst;
+    switch (width_) {
+      case 1: bytes_[k] = (uint8_t)next; break;
+      case 2: reinterpret_cast<uint16_t*>(bytes_)[k] = (uint16_t)next; break;
+      case 4: reinterpret_cast<uint32_t*>(bytes_)[k] = (uint32_t)next; break;
+      default: reinterpret_cast<uint64_t*>(bytes_)[k] = (uint64_t)next;
+    }
+  }
+
+  // get the vertices on the shortest path from src to dst
+  NextHopPath path(size_t src, size_t dst) const {
+    if ( src >= size_ || dst >= size_ ) {
+      throw std::out_of_range("Out of range: vertex");
+    }
+    return NextHopPath(this, src, dst);
+  }
+
+private:
+  size_t size_;
+  size_t width_;
+  std::vector<unsigned char> buffer_;
+  std::unique_ptr<MappedFile> file_;
+  unsigned char* bytes_;  // points to buffer_ or the mapped file
+};
+
+inline NextHopPath::iterator& NextHopPath::iterator::operator++() {
+  current_ = (current_ == dst_) ? table_->none() : table_->get(current_, dst_);
+  return *this;
+}
+
+inline NextHopPath::iterator NextHopPath::begin() const {
+  bool connected = src_ == dst_ || table_->get(src_, dst_) != table_->none();
+  return iterator(table_, connected ? src_ : table_->none(), dst_);
+}
+
+inline NextHopPath::iterator NextHopPath::end() const {
+  return iterator(table_, table_->none(), dst_);
+}
+
+/**
+ * Reconstruct the shortest path from a next-hop table
+ *
+ * Time complexity O(path length)
+ *
+ * @param next_hops: next-hop table of an all-pair shortest path search
+ * @param src: source vertex
+ * @param dst: destination vertex
+ * @return: the vertices from src to dst (empty if not connected)
+ */
+inline std::deque<size_t>
+reconstructPath(const NextHopTable& next_hops, size_t src, size_t dst) {
+  NextHopPath path = next_hops.path(src, dst);
+  return std::deque<size_t>(path.begin(), path.end());
+}
+
+#endif //GRAPH_NEXT_HOP_TABLE_H
@@ -0,0 +1,159 @@
+//
+// Split the vertices of a graph into k balanced parts with few edges
+// between the parts, e.g. to spread a large graph over several
+// processes (see graph_shards.h).
+//
+
+#ifndef GRAPH_PARTITION_H
+#define GRAPH_PARTITION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../graph.h"
+
+
+struct GraphPartition {
+  std::vector<uint32_t> parts;  // part of each vertex
+  std::vector<size_t> sizes;    // No. of vertices in each part
+  size_t edge_cut;              // No. of edges between different parts
+};
+
+/**
+ * Count the edges between different parts
+ *
+ * @param graph: directed/undirected graph
+ * @param parts: part of each vertex
+ * @return: No. of edges in the units of graph.countEdge(), i.e. an
+ *          undirected edge counts once
+ */
+template <class T>
+size_t countEdgeCut(const Graph<T>& graph, const std::vector<uint32_t>& parts) {
+  if (parts.size() != graph.size()) {
+    throw std::invalid_argument("Invalid argument: different sizes of graph and parts");
+  }
+
+  size_t n_entries = 0;
+  size_t n_cut_entries = 0;
+  for (size_t u = 0; u < graph.size(); ++u) {
+    for (graph::Edge<T>* e = graph.getList(u); e != nullptr; e = e->next) {
+      ++n_entries;
+      if (parts[u] != parts[e->dst]) { ++n_cut_entries; }
+    }
+  }
+
+  // an undirected edge is in two lists
+  return n_entries == 0 ? 0 : n_cut_entries*graph.countEdge()/n_entries;
+}
+
+/**
+ * Size-constrained label propagation partitioning
+ *
+ * The vertices are first cut into k blocks of consecutive vertices in
+ * BFS order, which already keeps most neighbors together. Then in each
+ * round, the vertices are visited in a random order, and each one
+ * moves to the part which most of its neighbors are in, unless that
+ * part is full. The parts never exceed (1 + imbalance)*V/k vertices.
+ * A round takes O(V + E) time, and the rounds stop when no vertex
+ * moves.
+ *
+ * Only the out-edges are seen in a directed graph.
+ *
+ * @param graph: directed/undirected graph
+ * @param n_parts: No. of parts (k)
+ * @param imbalance: allowed excess of the largest part over V/k
+ * @param max_rounds: max No. of label propagation rounds
+ * @param seed: seed of the visiting order
+ */
+template <class T>
+GraphPartition labelPropagationPartition(const Graph<T>& graph, size_t n_parts,
+                                         double imbalance=0.03, size_t max_rounds=20,
+                                         unsigned seed=0) {
+  const size_t n = graph.size();
+  if (n_parts == 0 || n_parts > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument("Invalid argument: No. of parts");
+  }
+  if (imbalance < 0) {
+    throw std::invalid_argument("Invalid argument: imbalance");
+  }
+  const size_t capacity = std::max<size_t>(
+      1, (size_t)std::ceil((1 + imbalance)*n/n_parts));
+
+  GraphPartition partition;
+  partition.parts.assign(n, 0);
+  partition.sizes.assign(n_parts, 0);
+
+  // blocks of the BFS order, where each unvisited vertex starts a new
+  // search (a new component)
+  std::vector<uint32_t> order;
+  order.reserve(n);
+  {
+    std::vector<bool> visited(n, false);
+    for (size_t root = 0; root < n; ++root) {
+      if (visited[root]) { continue; }
+      visited[root] = true;
+      order.push_back((uint32_t)root);
+      for (size_t head = order.size() - 1; head < order.size(); ++head) {
+        for (graph::Edge<T>* e = graph.getList(order[head]); e != nullptr; e = e->next) {
+          if (!visited[e->dst]) {
+            visited[e->dst] = true;
+            order.push_back((uint32_t)e->dst);
+          }
+        }
+      }
+    }
+  }
+  for (size_t i = 0; i < n; ++i) {
+    uint32_t part = (uint32_t)(i*n_parts/n);
+    partition.parts[order[i]] = part;
+    ++partition.sizes[part];
+  }
+
+  // No. of neighbors in each part, where the touched parts are reset
+  // after each vertex
+  std::vector<size_t> neighbors(n_parts, 0);
+  std::vector<uint32_t> touched;
+  std::mt19937 generator(seed);
+  for (size_t round = 0; round < max_rounds; ++round) {
+    std::shuffle(order.begin(), order.end(), generator);
+
+    size_t n_moves = 0;
+    for (auto v : order) {
+      for (graph::Edge<T>* e = graph.getList(v); e != nullptr; e = e->next) {
+        uint32_t part = partition.parts[e->dst];
+        if (neighbors[part]++ == 0) { touched.push_back(part); }
+      }
+
+      // a tie keeps the vertex where it is
+      uint32_t current = partition.parts[v];
+      uint32_t best = current;
+      for (auto part : touched) {
+        if (neighbors[part] > neighbors[best] && partition.sizes[part] < capacity) {
+          best = part;
+        }
+      }
+      for (auto part : touched) { neighbors[part] = 0; }
+      touched.clear();
+
+      if (best != current) {
+        partition.parts[v] = best;
+        --partition.sizes[current];
+        ++partition.sizes[best];
+        ++n_moves;
+      }
+    }
+
+    if (n_moves == 0) { break; }
+  }
+
+  partition.edge_cut = countEdgeCut(graph, partition.parts);
+  return partition;
+}
+
+
+#endif //GRAPH_PARTITION_H
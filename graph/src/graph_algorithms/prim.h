@@ -5,14 +5,22 @@
 #ifndef GRAPH_PRIM_H
 #define GRAPH_PRIM_H
 
-#include "breath_first_search.h"
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../indexed_heap.h"
 #include "../undirected_graph.h"
 
 
 /**
  * The original Prim's minimum spanning tree algorithm
  *
- * Time complexity O(V^2)
+ * The cheapest edge from the tree to each of the other vertices is
+ * kept in an array, which is scanned for the next vertex. It beats
+ * prim() on dense graphs since there is no heap.
+ *
+ * Time complexity O(V^2 + E)
  *
  * @param graph: undirected graph
  * @param src: source vertex
@@ -23,10 +31,9 @@
 template <class T>
 std::pair<T, std::vector<std::pair<size_t, size_t>>>
 prim_dense(const UndirectedGraph<T>& graph, size_t src) {
-
-  auto bfs_search = breathFirstSearch(graph, src);
-  if ( bfs_search.size() != graph.size() ) {
-    throw std::invalid_argument("Input graph is not connected!");
+  const size_t n = graph.size();
+  if ( src >= n ) {
+    throw std::out_of_range("Out of range: src");
   }
 
   // Minimum spanning tree:
@@ -34,33 +41,69 @@ prim_dense(const UndirectedGraph<T>& graph, size_t src) {
   // where "src" is the vertex in the processed vertices set while "dst"
   // is the vertex in the un-processed vertices set.
   std::vector<std::pair<size_t, size_t>> mst;
-  T cost = 0.0;  // total cost of the minimum spanning tree
+  T cost = 0;  // total cost of the minimum spanning tree
+
+  // the cheapest edge (came_from[v], v) from the processed vertices to
+  // each un-processed vertex, where came_from[v] == n if there is none
+  std::vector<T> keys(n);
+  std::vector<size_t> came_from(n, n);
 
   // An indicator
-  std::vector<bool> processed(graph.size());
-  processed[src] = true;
+  std::vector<bool> processed(n);
 
-  // Loop over the rest vertices
-  for (size_t count = 0; count < graph.size() - 1; ++count) {
-    // TODO:: implement
+  // the un-processed vertices, so that the scans get shorter
+  std::vector<size_t> remaining;
+  for (size_t v = 0; v < n; ++v) {
+    if (v != src) { remaining.push_back(v); }
   }
 
-  return {};
-}
+  size_t pick = src;
+  // Loop over the rest vertices
+  while ( !remaining.empty() ) {
+    processed[pick] = true;
 
-// comparator
-struct edgeGreater {
-  // <weight, <from vertex index, to vertex index>>
-  typedef std::pair<double, std::pair<int, int>> graph_edge;
+    graph::Edge<T>* current_edge = graph.getList(pick);
+    while ( current_edge ) {
+      size_t dst = current_edge->dst;
+      if (!processed[dst] &&
+          (came_from[dst] == n || current_edge->weight < keys[dst])) {
+        keys[dst] = current_edge->weight;
+        came_from[dst] = pick;
+      }
+      current_edge = current_edge->next;
+    }
+
+    // the un-processed vertex with the cheapest edge
+    size_t best = remaining.size();
+    for (size_t k = 0; k < remaining.size(); ++k) {
+      size_t v = remaining[k];
+      if (came_from[v] != n &&
+          (best == remaining.size() || keys[v] < keys[remaining[best]])) {
+        best = k;
+      }
+    }
+    if (best == remaining.size()) {
+      throw std::invalid_argument("Input graph is not connected!");
+    }
+    pick = remaining[best];
+    remaining[best] = remaining.back();
+    remaining.pop_back();
 
-  bool operator()(const graph_edge& e1, const graph_edge& e2) {
-    return e1.first > e2.first;
+    mst.push_back(std::make_pair(came_from[pick], pick));
+    cost += keys[pick];
   }
-};
+
+  return std::make_pair(cost, mst);
+}
 
 /**
- * The Prim's minimum spanning tree algorithm implemented with
- * priority queue.
+ * The Prim's minimum spanning tree algorithm implemented with an
+ * indexed heap.
+ *
+ * The heap holds each un-processed vertex next to the tree once, keyed
+ * by its cheapest edge from the tree, which is lowered in place when a
+ * cheaper edge is found. So the heap has at most V entries instead of
+ * one per edge.
  *
  * Time complexity O(ElogV)
  *
@@ -73,10 +116,9 @@ struct edgeGreater {
 template <class T>
 std::pair<T, std::vector<std::pair<size_t, size_t>>>
 prim(const UndirectedGraph<T>& graph, size_t src) {
-
-  auto bfs_search = breathFirstSearch(graph, src);
-  if ( bfs_search.size() != graph.size() ) {
-    throw std::invalid_argument("Input graph is not connected!");
+  const size_t n = graph.size();
+  if ( src >= n ) {
+    throw std::out_of_range("Out of range: src");
   }
 
   // Minimum spanning tree:
@@ -84,54 +126,43 @@ prim(const UndirectedGraph<T>& graph, size_t src) {
   // where "src" is the vertex in the processed vertices set while "dst"
   // is the vertex in the un-processed vertices set.
   std::vector<std::pair<size_t, size_t>> mst;
-  T cost = 0.0;  // total cost of the minimum spanning tree
+  T cost = 0;  // total cost of the minimum spanning tree
 
-  // <weight, <src, dst>>
-  typedef std::pair<T, std::pair<size_t, size_t>> graph_edge;
-  // A min priority queue store the graph edge information
-  std::priority_queue<graph_edge, std::vector<graph_edge>, edgeGreater> unprocessed;
+  // the un-processed vertices keyed by their cheapest edge
+  // (came_from[v], v) from the processed vertices
+  IndexedMinHeap<T> unprocessed(n);
+  std::vector<size_t> came_from(n);
 
   // An indicator
-  std::vector<bool> processed(graph.size());
-  processed[src] = true;
-
-  // Initialize the priority queue.
-  graph::Edge<T>* current_edge = graph.getList(src);
-  while ( current_edge ) {
-    unprocessed.push(std::make_pair(
-        current_edge->weight,
-        std::make_pair(src, current_edge->dst)));
-    current_edge = current_edge->next;
-  }
+  std::vector<bool> processed(n);
 
-  // Run until there is no vertex in the unprocessed set
-  // or all the vertices have been processed (for speed).
-  while ( mst.size() < graph.size() && !unprocessed.empty() ) {
-    graph_edge pick = unprocessed.top();
-    unprocessed.pop();
+  size_t pick = src;
+  while ( true ) {
+    processed[pick] = true;
 
-    // Skip old copies of a processed vertex left in the priority queue.
-    // It ensures that each vertex will only be processed once!
-    if (processed[pick.second.second]) { continue; }
-    processed[pick.second.second] = true;
-
-    mst.push_back(pick.second);
-    cost += pick.first;
-
-    current_edge = graph.getList(pick.second.second);
     // Since each edge will only be visited once, so the total time
-    // complexity of the two loops is only O(E)
+    // complexity of the two loops is only O(ElogV)
+    graph::Edge<T>* current_edge = graph.getList(pick);
     while ( current_edge ) {
-      unprocessed.push(std::make_pair(
-          current_edge->weight,
-          std::make_pair(pick.second.second, current_edge->dst)));
-
+      size_t dst = current_edge->dst;
+      if (!processed[dst] && unprocessed.pushOrDecrease(dst, current_edge->weight)) {
+        came_from[dst] = pick;
+      }
       current_edge = current_edge->next;
     }
+
+    if (unprocessed.empty()) { break; }
+    pick = unprocessed.pop();
+    mst.push_back(std::make_pair(came_from[pick], pick));
+    cost += unprocessed.key(pick);
+  }
+
+  if ( mst.size() + 1 < n ) {
+    throw std::invalid_argument("Input graph is not connected!");
   }
 
   return std::make_pair(cost, mst);
 }
 
 
-#endif //GRAPH_PRIM_H
\ No newline at end of file
+#endif //GRAPH_PRIM_H
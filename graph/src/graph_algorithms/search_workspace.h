@@ -0,0 +1,204 @@
+//
+// A reusable container for single-source shortest path searches.
+//
+// The cost and came_from arrays are allocated once and reset lazily
+// with a timestamp: a vertex is considered untouched unless its stamp
+// equals the stamp of the current query. Starting a new query is
+// therefore O(1) and a search only pays for the vertices it visits.
+//
+// The relaxations, the heap operations and the settled vertices are
+// counted here for all the searches when GRAPH_ENABLE_STATS is defined.
+//
+
+#ifndef GRAPH_SEARCH_WORKSPACE_H
+#define GRAPH_SEARCH_WORKSPACE_H
+
+#include <vector>
+#include <deque>
+#include <limits>
+#include <algorithm>
+#include <functional>
+
+#include "../graph_stats.h"
+
+
+template <class T>
+class SearchWorkspace {
+public:
+  // <cost, vertex>
+  typedef std::pair<T, size_t> heap_entry;
+
+  /**
+   * constructor
+   *
+   * @param size: No. of vertices in the graph to be searched
+   */
+  explicit SearchWorkspace(size_t size=0)
+      : costs_(size), came_from_(size), stamps_(size, 0), stamp_(1), size_(size),
+        target_stamps_(size, 0), target_stamp_(1) {}
+
+  // the cost of a vertex which has not been reached
+  static T infinity() { return (T)(std::numeric_limits<T>::max()/2.0); }
+
+  /**
+   * Start a new query on a graph with "size" vertices.
+   *
+   * Amortized O(1). The arrays only grow when the graph is larger
+   * than any graph searched before.
+   *
+   * @param size: No. of vertices in the graph to be searched
+   */
+  void reset(size_t size) {
+    if (size > stamps_.size()) {
+      costs_.resize(size);
+      came_from_.resize(size);
+      stamps_.resize(size, 0);
+      target_stamps_.resize(size, 0);
+    }
+    size_ = size;
+
+    // a wrapped-around stamp would revive entries from old queries
+    if (++stamp_ == 0) {
+      std::fill(stamps_.begin(), stamps_.end(), 0);
+      stamp_ = 1;
+    }
+
+    touched_.clear();
+    settled_.clear();
+    heap_.clear();
+  }
+
+  // get No. of vertices in the current query
+  size_t size() const { return size_; }
+
+  // whether a vertex has been reached in the current query
+  bool reached(size_t v) const { return stamps_[v] == stamp_; }
+
+  // the smallest cost so far (infinity() if not reached)
+  T cost(size_t v) const { return reached(v) ? costs_[v] : infinity(); }
+
+  // the previous vertex in the shortest path (only valid if reached)
+  size_t cameFrom(size_t v) const { return came_from_[v]; }
+
+  /**
+   * Set the cost and the previous vertex of a vertex
+   *
+   * @param v: vertex
+   * @param cost: new cost
+   * @param came_from: the previous vertex in the shortest path
+   */
+  void set(size_t v, T cost, size_t came_from) {
+    if (!reached(v)) {
+      stamps_[v] = stamp_;
+      touched_.push_back(v);
+    }
+    costs_[v] = cost;
+    came_from_[v] = came_from;
+  }
+
+  /**
+   * Lower the cost of a vertex if the new cost is smaller
+   *
+   * @return: true if the cost is updated
+   */
+  bool relax(size_t v, T cost, size_t came_from) {
+    graph_stats::count(&SearchStats::relaxations);
+    if (reached(v) && costs_[v] <= cost) { return false; }
+    graph_stats::count(&SearchStats::updates);
+    set(v, cost, came_from);
+    return true;
+  }
+
+  // vertices reached in the current query, in the order of first touch
+  const std::vector<size_t>& touched() const { return touched_; }
+
+  // record that the cost of a vertex is final
+  void settle(size_t v) {
+    graph_stats::count(&SearchStats::settled);
+    settled_.push_back(v);
+  }
+
+  // vertices settled in the current query, in the order of settling
+  const std::vector<size_t>& settled() const { return settled_; }
+
+  //
+  // Targets of the search, which are marked with their own stamp so
+  // that they can be set before reset() is called by the search
+  //
+
+  // unmark all the targets in O(1)
+  void clearTargets(size_t size) {
+    if (size > target_stamps_.size()) { target_stamps_.resize(size, 0); }
+    if (++target_stamp_ == 0) {
+      std::fill(target_stamps_.begin(), target_stamps_.end(), 0);
+      target_stamp_ = 1;
+    }
+  }
+
+  /**
+   * Mark a vertex as a target
+   *
+   * @return: false if it has already been marked
+   */
+  bool markTarget(size_t v) {
+    if (isTarget(v)) { return false; }
+    target_stamps_[v] = target_stamp_;
+    return true;
+  }
+
+  bool isTarget(size_t v) const { return target_stamps_[v] == target_stamp_; }
+
+  //
+  // min-heap of <cost, vertex>, which allows old copies
+  //
+  bool empty() const { return heap_.empty(); }
+
+  void push(T cost, size_t v) {
+    graph_stats::count(&SearchStats::pushes);
+    heap_.push_back(std::make_pair(cost, v));
+    std::push_heap(heap_.begin(), heap_.end(), std::greater<heap_entry>());
+  }
+
+  heap_entry pop() {
+    graph_stats::count(&SearchStats::pops);
+    std::pop_heap(heap_.begin(), heap_.end(), std::greater<heap_entry>());
+    heap_entry top = heap_.back();
+    heap_.pop_back();
+    return top;
+  }
+
+  const heap_entry& top() const { return heap_.front(); }
+
+  /**
+   * Copy the result into the dense containers returned by dijkstra()
+   * and bellmanFord(). This is O(V).
+   *
+   * @return: two deque containers. The first one stores the smallest
+   *          cost of each vertex; the second one stores the previous
+   *          vertex of each vertex in the shortest path.
+   */
+  std::pair<std::deque<T>, std::deque<size_t>> toDeque() const {
+    std::deque<T> costs(size_, infinity());
+    std::deque<size_t> came_from(size_);
+    for (auto v : touched_) {
+      costs[v] = costs_[v];
+      came_from[v] = came_from_[v];
+    }
+    return std::make_pair(costs, came_from);
+  }
+
+private:
+  std::vector<T> costs_;
+  std::vector<size_t> came_from_;
+  std::vector<unsigned int> stamps_;  // query stamp of each vertex
+  unsigned int stamp_;  // stamp of the current query
+  size_t size_;  // No. of vertices in the current query
+  std::vector<unsigned int> target_stamps_;
+  unsigned int target_stamp_;  // stamp of the current targets
+
+  std::vector<size_t> touched_;
+  std::vector<size_t> settled_;
+  std::vector<heap_entry> heap_;
+};
+
+#endif //GRAPH_SEARCH_WORKSPACE_H
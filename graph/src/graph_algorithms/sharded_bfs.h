@@ -0,0 +1,326 @@
+//
+// A BFS in which each part of a partitioned graph is searched by its
+// own process, which only loads the snapshot of its shard. The
+// processes run on one machine and exchange the discovered ghost
+// vertices through shared memory, which stands in for the network of
+// a distributed run and measures its traffic.
+//
+
+#ifndef GRAPH_SHARDED_BFS_H
+#define GRAPH_SHARDED_BFS_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../graph_shards.h"
+#include "breath_first_search.h"
+
+
+struct ShardedBfsStats {
+  size_t n_levels;    // No. of BFS levels (synchronization rounds)
+  size_t n_messages;  // No. of ghost vertices sent to their owners
+  size_t n_bytes;     // size of the messages
+};
+
+namespace graph_sharded {
+
+  //
+  // The memory shared by the processes, which is mapped before the
+  // fork: a header and then the distances of all the vertices and one
+  // outbox per process.
+  //
+  // Each level has two phases separated by a barrier. A process
+  // expands its frontier and writes the ghosts it discovers into its
+  // outbox, grouped by owner; then it reads the messages of the other
+  // processes to itself, and publishes the size of its next frontier.
+  // A process sends each ghost at most once, so an outbox never holds
+  // more than V messages.
+  //
+  struct SharedHeader {
+    pthread_barrier_t barrier;
+    int failed;  // a process could not run its part
+    uint64_t n_levels;
+  };
+
+  class SharedMemory {
+  public:
+    SharedMemory(size_t n_vertices, size_t n_parts)
+        : n_vertices_(n_vertices), n_parts_(n_parts), abandoned_(false) {
+      bytes_ = sizeof(SharedHeader) + n_parts*sizeof(uint64_t)  // frontier sizes
+               + 2*n_parts*n_parts*sizeof(uint64_t)            // outbox segments
+               + n_parts*sizeof(uint64_t)                      // messages sent
+               + n_vertices*sizeof(uint64_t)                   // distances
+               + n_parts*std::max<size_t>(n_vertices, 1)*sizeof(uint32_t);  // outboxes
+      void* p = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED) { throw std::runtime_error("mmap failed for the shared memory"); }
+      base_ = static_cast<char*>(p);
+
+      header()->failed = 0;
+      header()->n_levels = 0;
+      pthread_barrierattr_t attributes;
+      pthread_barrierattr_init(&attributes);
+      pthread_barrierattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+      pthread_barrier_init(&header()->barrier, &attributes, (unsigned)n_parts);
+      pthread_barrierattr_destroy(&attributes);
+    }
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    ~SharedMemory() {
+      if (!abandoned_) { pthread_barrier_destroy(&header()->barrier); }
+      ::munmap(base_, bytes_);
+    }
+
+    // the processes were killed, maybe while waiting at the barrier,
+    // whose destruction would then wait for them forever
+    void abandon() { abandoned_ = true; }
+
+    SharedHeader* header() { return reinterpret_cast<SharedHeader*>(base_); }
+    void wait() { pthread_barrier_wait(&header()->barrier); }
+
+    uint64_t* frontierSizes() {
+      return reinterpret_cast<uint64_t*>(base_ + sizeof(SharedHeader));
+    }
+    // first message and No. of messages from part p to part q
+    uint64_t* segmentBegin(size_t p, size_t q) { return frontierSizes() + n_parts_ + p*n_parts_ + q; }
+    uint64_t* segmentSize(size_t p, size_t q) {
+      return frontierSizes() + n_parts_ + n_parts_*n_parts_ + p*n_parts_ + q;
+    }
+    uint64_t* messagesSent() { return frontierSizes() + n_parts_ + 2*n_parts_*n_parts_; }
+    uint64_t* distances() { return messagesSent() + n_parts_; }
+    uint32_t* outbox(size_t p) {
+      return reinterpret_cast<uint32_t*>(distances() + n_vertices_) +
+             p*std::max<size_t>(n_vertices_, 1);
+    }
+
+  private:
+    size_t n_vertices_;
+    size_t n_parts_;
+    size_t bytes_;
+    char* base_;
+    bool abandoned_;
+  };
+
+  //
+  // Called by each process at the start of each level with its part and
+  // the level, e.g. to make a process fail in a test
+  //
+  inline std::function<void(size_t, size_t)>& levelHook() {
+    static std::function<void(size_t, size_t)> hook;
+    return hook;
+  }
+
+  //
+  // The search of one part, run by its own process
+  //
+  // A process which cannot load its shard raises the failed flag but
+  // keeps joining the barriers, so that the others are not blocked and
+  // all of them stop after the first level.
+  //
+  template <class T>
+  void searchShard(const std::string& path, size_t part, size_t n_parts, size_t src,
+                   SharedMemory& shared) {
+    GraphShard<T> shard;
+    try {
+      shard = graph_shards::loadShard<T>(path);
+      if (shard.part != part || shard.n_parts != n_parts) {
+        throw std::invalid_argument("Invalid argument: wrong shard");
+      }
+    } catch (...) {
+      shard = GraphShard<T>();
+      shard.offsets.push_back(0);
+      shared.header()->failed = 1;
+    }
+
+    const size_t n_owned = shard.owned.size();
+    std::vector<bool> visited(n_owned, false);
+    std::vector<bool> sent(shard.ghosts.size(), false);
+    std::vector<uint32_t> frontier;
+    std::vector<uint32_t> next;
+    std::vector<std::vector<uint32_t>> outgoing(n_parts);
+    uint64_t* distances = shared.distances();
+
+    // the owned vertices are in ascending order
+    auto found = std::lower_bound(shard.owned.begin(), shard.owned.end(), (uint32_t)src);
+    if (found != shard.owned.end() && *found == src) {
+      size_t local = found - shard.owned.begin();
+      visited[local] = true;
+      distances[src] = 0;
+      frontier.push_back((uint32_t)local);
+    }
+
+    uint64_t n_sent = 0;
+    for (size_t level = 0; ; ++level) {
+      if (levelHook()) { levelHook()(part, level); }
+
+      // expand the frontier, where the ghosts are sent to their owners
+      next.clear();
+      for (auto u : frontier) {
+        for (uint64_t e = shard.offsets[u]; e < shard.offsets[u + 1]; ++e) {
+          uint32_t v = shard.targets[e];
+          if (v < n_owned) {
+            if (!visited[v]) {
+              visited[v] = true;
+              distances[shard.owned[v]] = level + 1;
+              next.push_back(v);
+            }
+          } else if (!sent[v - n_owned]) {
+            sent[v - n_owned] = true;
+            outgoing[shard.ghost_owners[v - n_owned]].push_back(
+                shard.ghost_owner_ids[v - n_owned]);
+          }
+        }
+      }
+
+      uint32_t* outbox = shared.outbox(part);
+      uint64_t position = 0;
+      for (size_t q = 0; q < n_parts; ++q) {
+        *shared.segmentBegin(part, q) = position;
+        *shared.segmentSize(part, q) = outgoing[q].size();
+        std::copy(outgoing[q].begin(), outgoing[q].end(), outbox + position);
+        position += outgoing[q].size();
+        outgoing[q].clear();
+      }
+      n_sent += position;
+      shared.wait();
+
+      // receive the vertices which the other parts found
+      for (size_t q = 0; q < n_parts; ++q) {
+        const uint32_t* messages = shared.outbox(q) + *shared.segmentBegin(q, part);
+        for (uint64_t i = 0; i < *shared.segmentSize(q, part); ++i) {
+          uint32_t v = messages[i];
+          if (!visited[v]) {
+            visited[v] = true;
+            distances[shard.owned[v]] = level + 1;
+            next.push_back(v);
+          }
+        }
+      }
+      shared.frontierSizes()[part] = next.size();
+      shared.wait();
+
+      uint64_t n_next = 0;
+      for (size_t q = 0; q < n_parts; ++q) { n_next += shared.frontierSizes()[q]; }
+      if (n_next == 0 || shared.header()->failed) {
+        shared.messagesSent()[part] = n_sent;
+        if (part == 0) { shared.header()->n_levels = level + 1; }
+        return;
+      }
+      frontier.swap(next);
+    }
+  }
+
+}  // namespace graph_sharded
+
+/**
+ * Level-synchronous BFS over the shards of a partitioned graph, with a
+ * process per shard
+ *
+ * The processes are forked from the calling process, and each one
+ * loads only its own snapshot. The result equals bfsDistance() on the
+ * whole graph.
+ *
+ * @param shard_paths: snapshot of each part, e.g. from
+ *                     graph_shards::writeShards()
+ * @param src: the source vertex (global id)
+ * @param stats: optional statistics of the communication on return
+ * @return: the hop distance of each vertex (kUnreachedDistance if it
+ *          cannot be reached from src)
+ * @throw: std::runtime_error if a process fails
+ *
+ * The children are reaped with waitpid(-1), so other children of the
+ * calling process which exit meanwhile are reaped too.
+ */
+template <class T>
+std::vector<size_t> shardedBfs(const std::vector<std::string>& shard_paths, size_t src,
+                               ShardedBfsStats* stats=nullptr) {
+  const size_t n_parts = shard_paths.size();
+  if (n_parts == 0) {
+    throw std::invalid_argument("Invalid argument: no shard");
+  }
+  size_t n_vertices = 0;
+  {
+    MappedFile file(shard_paths[0]);
+    n_vertices = graph_shards::readShardHeader<T>(file).size;
+  }
+  if (src >= n_vertices) {
+    throw std::out_of_range("Out of range: src");
+  }
+
+  graph_sharded::SharedMemory shared(n_vertices, n_parts);
+  std::fill(shared.distances(), shared.distances() + n_vertices, (uint64_t)kUnreachedDistance);
+
+  // the children must not flush the buffered output of the parent again
+  std::cout.flush();
+  std::vector<pid_t> children;
+  for (size_t p = 0; p < n_parts; ++p) {
+    pid_t pid = ::fork();
+    if (pid == 0) {
+      try {
+        graph_sharded::searchShard<T>(shard_paths[p], p, n_parts, src, shared);
+      } catch (...) {
+        ::_exit(1);
+      }
+      ::_exit(0);
+    }
+    if (pid < 0) {
+      // the children which are waiting for the missing one never finish
+      for (auto child : children) { ::kill(child, SIGKILL); }
+      for (auto child : children) { ::waitpid(child, nullptr, 0); }
+      shared.abandon();
+      throw std::runtime_error("fork failed for the sharded BFS");
+    }
+    children.push_back(pid);
+  }
+
+  // a process which dies (e.g. of an exception) never joins the barrier
+  // again, so the others are killed instead of waited for
+  bool failed = false;
+  while (!children.empty()) {
+    int status = 0;
+    pid_t pid = ::waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR) { continue; }
+      throw std::runtime_error("waitpid failed for the sharded BFS");
+    }
+    auto child = std::find(children.begin(), children.end(), pid);
+    if (child == children.end()) { continue; }
+    children.erase(child);
+
+    if (!failed && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+      failed = true;
+      for (auto other : children) { ::kill(other, SIGKILL); }
+      shared.abandon();
+    }
+  }
+  if (failed || shared.header()->failed) {
+    throw std::runtime_error("a process of the sharded BFS failed");
+  }
+
+  if (stats != nullptr) {
+    stats->n_levels = shared.header()->n_levels;
+    stats->n_messages = 0;
+    for (size_t p = 0; p < n_parts; ++p) { stats->n_messages += shared.messagesSent()[p]; }
+    stats->n_bytes = stats->n_messages*sizeof(uint32_t);
+  }
+
+  return std::vector<size_t>(shared.distances(), shared.distances() + n_vertices);
+}
+
+
+#endif //GRAPH_SHARDED_BFS_H
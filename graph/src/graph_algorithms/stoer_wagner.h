@@ -0,0 +1,137 @@
+#ifndef GRAPH_STOER_WAGNER_H
+#define GRAPH_STOER_WAGNER_H
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../indexed_heap.h"
+#include "../undirected_graph.h"
+
+
+//
+// Implementation of the Stoer-Wagner's global min cut algorithm
+//
+// Each phase adds the vertices to a set A in maximum adjacency order,
+// i.e. the next vertex is the one most tightly connected to A, which
+// is kept in an indexed max-heap. The weight of the edges between the
+// last vertex t and the others is a minimum s-t cut, where s is the
+// second last vertex. Then s and t are merged, because the global min
+// cut either separates them (and has been found) or does not.
+//
+// The merged vertices keep adjacency lists in which the parallel edges
+// are merged, so a phase takes O(ElogV) time and the algorithm
+// O(VElogV), without any randomness.
+//
+// @param graph: undirected graph with non-negative weights and at
+//               least 2 vertices
+//
+// @return: a pair in which the first element is the weight of a
+//          minimum cut while the second one is the vertices on one
+//          side of it in ascending order.
+//
+template <class T> std::pair<T, std::vector<size_t>>
+stoerWagner(const UndirectedGraph<T>& graph) {
+  const size_t n = graph.size();
+  if (n < 2) {
+    throw std::invalid_argument("Invalid argument: less than 2 vertices");
+  }
+
+  // <neighbor, weight> of each merged vertex
+  typedef std::vector<std::pair<size_t, T>> adjacency;
+  std::vector<adjacency> adjacencies(n);
+  for (size_t i = 0; i < n; ++i) {
+    graph::Edge<T>* current_edge = graph.getList(i);
+    while (current_edge != nullptr) {
+      if (current_edge->weight < 0) {
+        throw std::invalid_argument("Invalid argument: negative weight");
+      }
+      adjacencies[i].push_back(std::make_pair(current_edge->dst, current_edge->weight));
+      current_edge = current_edge->next;
+    }
+  }
+
+  // the merged vertex which a vertex has been merged into
+  std::vector<size_t> merged_into(n);
+  for (size_t v = 0; v < n; ++v) { merged_into[v] = v; }
+  auto find = [&merged_into](size_t v) {
+    while (merged_into[v] != v) {
+      merged_into[v] = merged_into[merged_into[v]];
+      v = merged_into[v];
+    }
+    return v;
+  };
+
+  std::vector<size_t> active(n);  // vertices not merged into others
+  for (size_t v = 0; v < n; ++v) { active[v] = v; }
+  std::vector<std::vector<size_t>> members(n);
+  for (size_t v = 0; v < n; ++v) { members[v].push_back(v); }
+
+  IndexedMinHeap<T, std::greater<T>> connectivity(n);
+  std::vector<bool> added(n);
+  std::vector<T> merged_weights(n);  // scratch for merging the lists
+  std::vector<bool> seen(n);
+
+  T min_cut = 0;
+  std::vector<size_t> min_side;
+  while (active.size() > 1) {
+    // maximum adjacency order from the first active vertex
+    for (auto v : active) {
+      added[v] = false;
+      connectivity.push(v, 0);
+    }
+    size_t s = active[0];
+    size_t t = active[0];
+    while (!connectivity.empty()) {
+      T cut_of_phase = connectivity.key(connectivity.top());
+      s = t;
+      t = connectivity.pop();
+      added[t] = true;
+      if (connectivity.empty()) {
+        if (min_side.empty() || cut_of_phase < min_cut) {
+          min_cut = cut_of_phase;
+          min_side = members[t];
+        }
+        break;
+      }
+
+      for (auto& e : adjacencies[t]) {
+        size_t v = find(e.first);
+        if (!added[v]) { connectivity.decreaseKey(v, connectivity.key(v) + e.second); }
+      }
+    }
+
+    // merge t into s and their edges between the same vertices
+    merged_into[t] = s;
+    members[s].insert(members[s].end(), members[t].begin(), members[t].end());
+    std::vector<size_t>().swap(members[t]);
+    adjacencies[s].insert(adjacencies[s].end(), adjacencies[t].begin(), adjacencies[t].end());
+    adjacency().swap(adjacencies[t]);
+    active.erase(std::find(active.begin(), active.end(), t));
+
+    adjacency merged;
+    for (auto& e : adjacencies[s]) {
+      size_t v = find(e.first);
+      if (v == s) { continue; }
+      if (!seen[v]) {
+        seen[v] = true;
+        merged_weights[v] = 0;
+        merged.push_back(std::make_pair(v, T(0)));
+      }
+      merged_weights[v] += e.second;
+    }
+    for (auto& e : merged) {
+      e.second = merged_weights[e.first];
+      seen[e.first] = false;
+    }
+    adjacencies[s].swap(merged);
+  }
+
+  std::sort(min_side.begin(), min_side.end());
+  return std::make_pair(min_cut, min_side);
+}
+
+
+#endif //GRAPH_STOER_WAGNER_H
@@ -0,0 +1,147 @@
+//
+// graphd: load a graph once and answer queries until stopped (see
+// graph_server.h for the protocol).
+//
+//   graphd <graph> [--socket path] [--threads n] [--batch n]
+//     <graph> is a snapshot of graph_generator::saveSnapshot() or
+//     "rmat:<scale>:<edges>" / "grid:<rows>:<cols>" to generate one.
+//     Without --socket the queries are read from stdin and the answers
+//     written to stdout; with it the server runs until SIGINT/SIGTERM.
+//
+//   graphd load <socket> <vertices> [clients] [requests] [pipeline] [sources]
+//     run the load generator against a running server
+//
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "graph_server.h"
+#include "graph_generators.h"
+#include "benchmarks/benchmark_query_server.h"
+
+
+namespace {
+
+  void usage() {
+    std::cerr << "usage: graphd <snapshot|rmat:<scale>:<edges>|grid:<rows>:<cols>> "
+              << "[--socket path] [--threads n] [--batch n]\n"
+              << "       graphd load <socket> <vertices> [clients] [requests] "
+              << "[pipeline] [sources]" << std::endl;
+  }
+
+  size_t toSize(const std::string& text) {
+    size_t consumed = 0;
+    unsigned long long value = std::stoull(text, &consumed);
+    if (consumed != text.size()) { throw std::invalid_argument("Invalid argument: " + text); }
+    return (size_t)value;
+  }
+
+  GeneratedGraph<long> loadGraph(const std::string& spec) {
+    std::uniform_int_distribution<long> weight(1, 100);
+    std::vector<std::string> fields;
+    std::istringstream iss(spec);
+    for (std::string field; std::getline(iss, field, ':');) { fields.push_back(field); }
+
+    if (fields.size() == 3 && fields[0] == "rmat") {
+      return graph_generator::rmat(toSize(fields[1]), toSize(fields[2]), weight, 0, true);
+    }
+    if (fields.size() == 3 && fields[0] == "grid") {
+      return graph_generator::grid(toSize(fields[1]), toSize(fields[2]), weight, 0);
+    }
+    return graph_generator::loadSnapshot<long>(spec);
+  }
+
+  int runLoad(int argc, char** argv) {
+    if (argc < 4) {
+      usage();
+      return 1;
+    }
+    size_t n_vertices = toSize(argv[3]);
+    size_t n_clients = argc > 4 ? toSize(argv[4]) : 4;
+    size_t n_requests = argc > 5 ? toSize(argv[5]) : 1000;
+    size_t pipeline = argc > 6 ? toSize(argv[6]) : 1;
+    size_t n_sources = argc > 7 ? toSize(argv[7]) : 0;
+    auto result = graph_benchmark::runLoadTest(argv[2], n_vertices, n_clients, n_requests,
+                                               pipeline, n_sources);
+    graph_benchmark::printLoadTest(std::cout, result);
+    return result.n_errors == 0 ? 0 : 1;
+  }
+
+  int runServer(int argc, char** argv) {
+    std::string socket_path;
+    size_t n_threads = 0;
+    size_t max_batch = 256;
+    for (int i = 2; i < argc; ++i) {
+      std::string option(argv[i]);
+      if (i + 1 == argc) {
+        usage();
+        return 1;
+      }
+      if (option == "--socket") {
+        socket_path = argv[++i];
+      } else if (option == "--threads") {
+        n_threads = toSize(argv[++i]);
+      } else if (option == "--batch") {
+        max_batch = toSize(argv[++i]);
+      } else {
+        usage();
+        return 1;
+      }
+    }
+
+    GeneratedGraph<long> generated = loadGraph(argv[1]);
+    // the server only needs the out-edges, so an undirected edge is
+    // stored as two directed ones
+    DirectedGraph<long> graph = graph_generator::toDirectedGraph(generated);
+    generated.edges.clear();
+    generated.edges.shrink_to_fit();
+    std::cerr << "graphd: " << graph.size() << " vertices, " << graph.countEdge()
+              << " edges" << std::endl;
+
+    if (socket_path.empty()) {
+      GraphQueryServer<long> server(graph, n_threads, max_batch);
+      server.serve(0, 1);
+      return 0;
+    }
+
+    // the signals are waited for here instead of interrupting the
+    // threads of the server, which inherit the mask
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    GraphQueryServer<long> server(graph, n_threads, max_batch);
+    server.listen(socket_path);
+    std::cerr << "graphd: listening on " << socket_path << std::endl;
+    int signal = 0;
+    sigwait(&signals, &signal);
+
+    server.stop();
+    QueryServerStats stats = server.stats();
+    std::cerr << "graphd: " << stats.n_requests << " requests in " << stats.n_batches
+              << " batches, " << stats.n_searches << " searches, " << stats.n_connections
+              << " connections" << std::endl;
+    return 0;
+  }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    usage();
+    return 1;
+  }
+  try {
+    if (std::string(argv[1]) == "load") { return runLoad(argc, argv); }
+    return runServer(argc, argv);
+  } catch (const std::exception& e) {
+    std::cerr << "graphd: " << e.what() << std::endl;
+    return 1;
+  }
+}
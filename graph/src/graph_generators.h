@@ -0,0 +1,522 @@
+//
+// Seeded generators of large synthetic graphs: R-MAT (Kronecker), 2D
+// grid (road-like), random geometric and Erdos-Renyi graphs.
+//
+// A generator produces a GeneratedGraph, i.e. a flat list of edges
+// without self-loops or duplicates, which is loaded into a graph in
+// O(1) per edge or saved as a binary snapshot. The edges are generated
+// in fixed chunks, each with its own random engine seeded from (seed,
+// chunk), so a seed gives the same graph for any No. of threads.
+//
+// The weights are drawn from a distribution of the standard library,
+// e.g. std::uniform_int_distribution<long>(1, 1000), which also gives
+// the weight type.
+//
+
+#ifndef GRAPH_GRAPH_GENERATORS_H
+#define GRAPH_GRAPH_GENERATORS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "directed_graph.h"
+#include "undirected_graph.h"
+#include "edge_list.h"
+#include "disjoint_set.h"
+#include "mapped_file.h"
+#include "parallel.h"
+
+
+template <class T>
+struct GeneratedGraph {
+  size_t size;  // No. of vertices
+  bool directed;
+  // each undirected edge is listed once with src < dst
+  std::vector<WeightedEdge<T>> edges;
+};
+
+namespace graph_generator {
+
+  // No. of vertices or edges generated by one random engine
+  const size_t kChunkSize = 1 << 16;
+
+  // random engine of a chunk
+  inline std::mt19937_64 chunkEngine(uint64_t seed, uint64_t chunk) {
+    std::seed_seq sequence{(uint32_t)seed, (uint32_t)(seed >> 32),
+                           (uint32_t)chunk, (uint32_t)(chunk >> 32)};
+    return std::mt19937_64(sequence);
+  }
+
+  inline void checkSize(size_t n) {
+    if (n > std::numeric_limits<uint32_t>::max()) {
+      throw std::invalid_argument("Invalid argument: too many vertices");
+    }
+  }
+
+  // join the edges of the chunks in the order of the chunks
+  template <class T>
+  std::vector<WeightedEdge<T>> concatenate(std::vector<std::vector<WeightedEdge<T>>>& chunks) {
+    size_t n_edges = 0;
+    for (const auto& chunk : chunks) { n_edges += chunk.size(); }
+    std::vector<WeightedEdge<T>> edges;
+    edges.reserve(n_edges);
+    for (auto& chunk : chunks) {
+      edges.insert(edges.end(), chunk.begin(), chunk.end());
+      std::vector<WeightedEdge<T>>().swap(chunk);
+    }
+    return edges;
+  }
+
+  //
+  // Generate an Erdos-Renyi graph G(n, p), in which each pair of
+  // vertices is connected with probability p
+  //
+  // The pairs which are not connected are skipped with geometric gaps
+  // (Batagelj and Brandes), so it takes O(n + E) time instead of
+  // O(n^2).
+  //
+  // @param n: No. of vertices
+  // @param p: probability of each edge, e.g. 2E/(n(n - 1)) for about E
+  //           undirected edges
+  // @param weight: distribution of the weights
+  // @param seed: seed of the random engines
+  // @param directed: whether (src, dst) and (dst, src) are different
+  //                  pairs
+  // @param n_threads: No. of threads (0 for the hardware default)
+  //
+  template <class Distribution>
+  GeneratedGraph<typename Distribution::result_type>
+  erdosRenyi(size_t n, double p, Distribution weight, uint64_t seed=0,
+             bool directed=false, size_t n_threads=0) {
+    typedef typename Distribution::result_type T;
+    checkSize(n);
+    if (p < 0 || p > 1) {
+      throw std::invalid_argument("Invalid argument: probability");
+    }
+
+    GeneratedGraph<T> graph{n, directed, {}};
+    if (p == 0 || n < 2) { return graph; }
+
+    const size_t n_chunks = (n + kChunkSize - 1)/kChunkSize;
+    std::vector<std::vector<WeightedEdge<T>>> chunks(n_chunks);
+    graph_parallel::parallelFor(n_chunks, n_threads, [&](size_t, size_t chunk) {
+      std::mt19937_64 engine = chunkEngine(seed, chunk);
+      Distribution chunk_weight = weight;
+      std::geometric_distribution<size_t> gap(p < 1 ? p : 0.5);
+      auto next_gap = [&]() { return p < 1 ? gap(engine) : 0; };
+
+      // the k-th pair in the row of src is (src, k) (skipping src
+      // itself) if directed and (src, src + 1 + k) otherwise
+      const size_t last = std::min(n, (chunk + 1)*kChunkSize);
+      size_t src = chunk*kChunkSize;
+      size_t k = next_gap();
+      while (src < last) {
+        size_t row_length = directed ? n - 1 : n - 1 - src;
+        if (k >= row_length) {
+          k -= row_length;
+          ++src;
+          continue;
+        }
+        size_t dst = directed ? (k < src ? k : k + 1) : src + 1 + k;
+        chunks[chunk].push_back({chunk_weight(engine), (uint32_t)src, (uint32_t)dst});
+        k += next_gap() + 1;
+      }
+    });
+
+    graph.edges = concatenate(chunks);
+    return graph;
+  }
+
+  //
+  // Generate an R-MAT graph (the Kronecker graph of Graph500)
+  //
+  // Each edge picks one quadrant of the adjacency matrix with the
+  // probabilities (a, b, c, 1 - a - b - c) recursively until a single
+  // entry is left, which gives a skewed (power-law like) degree
+  // distribution. The vertices are then relabeled by a random
+  // permutation, so that the vertices of high degree are not the
+  // first ones. Self-loops and duplicated edges are dropped, so the
+  // graph has somewhat less than n_edges edges.
+  //
+  // @param scale: the graph has 2^scale vertices
+  // @param n_edges: No. of edges to draw, e.g. 16*2^scale in Graph500
+  // @param weight: distribution of the weights
+  // @param seed: seed of the random engines
+  // @param directed: whether (src, dst) and (dst, src) are different
+  //                  edges
+  // @param n_threads: No. of threads (0 for the hardware default)
+  //
+  template <class Distribution>
+  GeneratedGraph<typename Distribution::result_type>
+  rmat(size_t scale, size_t n_edges, Distribution weight, uint64_t seed=0,
+       bool directed=false, size_t n_threads=0,
+       double a=0.57, double b=0.19, double c=0.19) {
+    typedef typename Distribution::result_type T;
+    if (scale >= 32) {
+      throw std::invalid_argument("Invalid argument: too many vertices");
+    }
+    if (a < 0 || b < 0 || c < 0 || a + b + c > 1) {
+      throw std::invalid_argument("Invalid argument: quadrant probabilities");
+    }
+    const size_t n = (size_t)1 << scale;
+
+    std::vector<uint32_t> labels(n);
+    for (size_t v = 0; v < n; ++v) { labels[v] = (uint32_t)v; }
+    std::mt19937_64 label_engine = chunkEngine(seed, std::numeric_limits<uint64_t>::max());
+    std::shuffle(labels.begin(), labels.end(), label_engine);
+
+    const size_t n_chunks = (n_edges + kChunkSize - 1)/kChunkSize;
+    std::vector<std::vector<WeightedEdge<T>>> chunks(n_chunks);
+    graph_parallel::parallelFor(n_chunks, n_threads, [&](size_t, size_t chunk) {
+      std::mt19937_64 engine = chunkEngine(seed, chunk);
+      Distribution chunk_weight = weight;
+      std::uniform_real_distribution<double> quadrant(0, 1);
+
+      const size_t last = std::min(n_edges, (chunk + 1)*kChunkSize);
+      chunks[chunk].reserve(last - chunk*kChunkSize);
+      for (size_t e = chunk*kChunkSize; e < last; ++e) {
+        uint32_t src = 0;
+        uint32_t dst = 0;
+        for (size_t bit = 0; bit < scale; ++bit) {
+          double r = quadrant(engine);
+          src = src << 1 | (r >= a + b ? 1 : 0);
+          dst = dst << 1 | ((r >= a && r < a + b) || r >= a + b + c ? 1 : 0);
+        }
+        src = labels[src];
+        dst = labels[dst];
+        if (src == dst) { continue; }
+        if (!directed && src > dst) { std::swap(src, dst); }
+        chunks[chunk].push_back({chunk_weight(engine), src, dst});
+      }
+    });
+
+    GeneratedGraph<T> graph{n, directed, concatenate(chunks)};
+
+    // keep the lightest copy of each edge
+    graph_parallel::parallelSort(graph.edges.begin(), graph.edges.end(), n_threads,
+                                 [](const WeightedEdge<T>& e1, const WeightedEdge<T>& e2) {
+      if (e1.src != e2.src) { return e1.src < e2.src; }
+      if (e1.dst != e2.dst) { return e1.dst < e2.dst; }
+      return e1.weight < e2.weight;
+    });
+    auto last = std::unique(graph.edges.begin(), graph.edges.end(),
+                            [](const WeightedEdge<T>& e1, const WeightedEdge<T>& e2) {
+      return e1.src == e2.src && e1.dst == e2.dst;
+    });
+    graph.edges.erase(last, graph.edges.end());
+    graph.edges.shrink_to_fit();
+
+    return graph;
+  }
+
+  //
+  // Generate an undirected 2D grid, which looks like a road network:
+  // the degrees are at most 4, and the diameter grows with sqrt(n).
+  //
+  // Vertex r*cols + c is connected to its right and lower neighbors,
+  // where each of the edges is kept with probability "keep", so some
+  // roads are missing at keep < 1.
+  //
+  // @param rows: No. of rows
+  // @param cols: No. of columns
+  // @param weight: distribution of the weights
+  // @param seed: seed of the random engines
+  // @param keep: probability of each edge of the grid
+  // @param n_threads: No. of threads (0 for the hardware default)
+  //
+  template <class Distribution>
+  GeneratedGraph<typename Distribution::result_type>
+  grid(size_t rows, size_t cols, Distribution weight, uint64_t seed=0,
+       double keep=1.0, size_t n_threads=0) {
+    typedef typename Distribution::result_type T;
+    const size_t n = rows*cols;
+    checkSize(n);
+    if (keep < 0 || keep > 1) {
+      throw std::invalid_argument("Invalid argument: probability");
+    }
+
+    const size_t n_chunks = (n + kChunkSize - 1)/kChunkSize;
+    std::vector<std::vector<WeightedEdge<T>>> chunks(n_chunks);
+    graph_parallel::parallelFor(n_chunks, n_threads, [&](size_t, size_t chunk) {
+      std::mt19937_64 engine = chunkEngine(seed, chunk);
+      Distribution chunk_weight = weight;
+      std::bernoulli_distribution kept(keep);
+
+      const size_t last = std::min(n, (chunk + 1)*kChunkSize);
+      chunks[chunk].reserve(2*(last - chunk*kChunkSize));
+      for (size_t v = chunk*kChunkSize; v < last; ++v) {
+        if ((v + 1)%cols != 0 && kept(engine)) {
+          chunks[chunk].push_back({chunk_weight(engine), (uint32_t)v, (uint32_t)(v + 1)});
+        }
+        if (v + cols < n && kept(engine)) {
+          chunks[chunk].push_back({chunk_weight(engine), (uint32_t)v, (uint32_t)(v + cols)});
+        }
+      }
+    });
+
+    return GeneratedGraph<T>{n, false, concatenate(chunks)};
+  }
+
+  //
+  // Generate an undirected random geometric graph, in which n points
+  // are placed uniformly in the unit square and the points closer than
+  // "radius" are connected
+  //
+  // The points are binned into cells of side >= radius, so only the
+  // neighboring cells are searched, which takes O(n + E) time. There
+  // are about pi*radius^2*n^2/2 edges.
+  //
+  // @param n: No. of vertices
+  // @param radius: distance within which two points are connected
+  // @param weight: distribution of the weights
+  // @param seed: seed of the random engines
+  // @param n_threads: No. of threads (0 for the hardware default)
+  //
+  template <class Distribution>
+  GeneratedGraph<typename Distribution::result_type>
+  randomGeometric(size_t n, double radius, Distribution weight, uint64_t seed=0,
+                  size_t n_threads=0) {
+    typedef typename Distribution::result_type T;
+    checkSize(n);
+    if (radius <= 0) {
+      throw std::invalid_argument("Invalid argument: radius");
+    }
+
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    std::mt19937_64 point_engine = chunkEngine(seed, std::numeric_limits<uint64_t>::max());
+    std::uniform_real_distribution<double> coordinate(0, 1);
+    for (size_t v = 0; v < n; ++v) {
+      x[v] = coordinate(point_engine);
+      y[v] = coordinate(point_engine);
+    }
+
+    // cells of the points (counting sort), no more cells than points
+    size_t side = std::max<size_t>(1, (size_t)(1/radius));
+    side = std::min(side, std::max<size_t>(1, (size_t)std::sqrt((double)n)));
+    auto cellOf = [&](size_t v) {
+      size_t cx = std::min(side - 1, (size_t)(x[v]*side));
+      size_t cy = std::min(side - 1, (size_t)(y[v]*side));
+      return cy*side + cx;
+    };
+    std::vector<size_t> cell_begin(side*side + 1, 0);
+    for (size_t v = 0; v < n; ++v) { ++cell_begin[cellOf(v) + 1]; }
+    for (size_t c = 0; c < side*side; ++c) { cell_begin[c + 1] += cell_begin[c]; }
+    std::vector<uint32_t> points(n);
+    {
+      std::vector<size_t> fill(cell_begin.begin(), cell_begin.end() - 1);
+      for (size_t v = 0; v < n; ++v) { points[fill[cellOf(v)]++] = (uint32_t)v; }
+    }
+
+    // one chunk per row of cells
+    const double radius2 = radius*radius;
+    std::vector<std::vector<WeightedEdge<T>>> chunks(side);
+    graph_parallel::parallelFor(side, n_threads, [&](size_t, size_t cy) {
+      std::mt19937_64 engine = chunkEngine(seed, cy);
+      Distribution chunk_weight = weight;
+      for (size_t cx = 0; cx < side; ++cx) {
+        for (size_t i = cell_begin[cy*side + cx]; i < cell_begin[cy*side + cx + 1]; ++i) {
+          uint32_t u = points[i];
+          for (size_t ny = (cy > 0 ? cy - 1 : 0); ny <= std::min(side - 1, cy + 1); ++ny) {
+            for (size_t nx = (cx > 0 ? cx - 1 : 0); nx <= std::min(side - 1, cx + 1); ++nx) {
+              for (size_t j = cell_begin[ny*side + nx]; j < cell_begin[ny*side + nx + 1]; ++j) {
+                uint32_t v = points[j];
+                double dx = x[u] - x[v];
+                double dy = y[u] - y[v];
+                if (u < v && dx*dx + dy*dy < radius2) {
+                  chunks[cy].push_back({chunk_weight(engine), u, v});
+                }
+              }
+            }
+          }
+        }
+      }
+    });
+
+    return GeneratedGraph<T>{n, false, concatenate(chunks)};
+  }
+
+  //
+  // Connect the components of a generated graph by a path through one
+  // vertex of each component, so that the algorithms which need a
+  // connected graph (e.g. the minimum spanning tree) can run on it
+  //
+  // @return: No. of edges added
+  //
+  template <class T, class Distribution>
+  size_t connectComponents(GeneratedGraph<T>& graph, Distribution weight,
+                           uint64_t seed=0) {
+    DisjointSet components(graph.size);
+    for (const auto& e : graph.edges) { components.unite(e.src, e.dst); }
+
+    std::mt19937_64 engine = chunkEngine(seed, std::numeric_limits<uint64_t>::max() - 1);
+    size_t n_added = 0;
+    size_t previous = 0;
+    for (size_t v = 1; v < graph.size; ++v) {
+      if (components.unite(previous, v)) {
+        graph.edges.push_back({weight(engine), (uint32_t)previous, (uint32_t)v});
+        if (graph.directed) {
+          graph.edges.push_back({weight(engine), (uint32_t)v, (uint32_t)previous});
+        }
+        previous = v;
+        ++n_added;
+      }
+    }
+
+    return n_added;
+  }
+
+  //
+  // Split each edge of a generated graph into a path through up to
+  // max_inner new vertices (e.g. the shape points of a road), whose
+  // weights add up to the weight of the edge, so the distances between
+  // the old vertices do not change
+  //
+  // @return: No. of vertices added
+  //
+  template <class T>
+  size_t subdivideEdges(GeneratedGraph<T>& graph, size_t max_inner, uint64_t seed=0) {
+    std::mt19937_64 engine = chunkEngine(seed, std::numeric_limits<uint64_t>::max() - 2);
+    std::uniform_int_distribution<size_t> n_inner(0, max_inner);
+
+    std::vector<WeightedEdge<T>> edges;
+    edges.reserve(graph.edges.size()*(max_inner + 2)/2);
+    size_t n = graph.size;
+    for (const auto& e : graph.edges) {
+      size_t k = n_inner(engine);
+      checkSize(n + k);
+      T piece = e.weight/(T)(k + 1);
+      uint32_t src = e.src;
+      for (size_t i = 0; i < k; ++i) {
+        edges.push_back({piece, src, (uint32_t)n});
+        src = (uint32_t)n++;
+      }
+      edges.push_back({e.weight - piece*(T)k, src, e.dst});
+    }
+
+    // an undirected edge is listed with src < dst
+    if (!graph.directed) {
+      for (auto& e : edges) {
+        if (e.src > e.dst) { std::swap(e.src, e.dst); }
+      }
+    }
+    size_t n_added = n - graph.size;
+    graph.size = n;
+    graph.edges.swap(edges);
+    return n_added;
+  }
+
+  //
+  // Load a generated graph into a directed graph, where an undirected
+  // edge gives the edges in both directions
+  //
+  template <class T>
+  DirectedGraph<T> toDirectedGraph(const GeneratedGraph<T>& generated) {
+    DirectedGraph<T> graph(generated.size);
+    for (const auto& e : generated.edges) {
+      graph.connectNew(e.src, e.dst, e.weight);
+      if (!generated.directed) { graph.connectNew(e.dst, e.src, e.weight); }
+    }
+    return graph;
+  }
+
+  //
+  // Load an undirected generated graph into an undirected graph
+  //
+  template <class T>
+  UndirectedGraph<T> toUndirectedGraph(const GeneratedGraph<T>& generated) {
+    if (generated.directed) {
+      throw std::invalid_argument("Invalid argument: the graph is directed");
+    }
+    UndirectedGraph<T> graph(generated.size);
+    for (const auto& e : generated.edges) { graph.connectNew(e.src, e.dst, e.weight); }
+    return graph;
+  }
+
+  //
+  // Binary snapshot of a generated graph: the header below and then the
+  // edges as they are in memory, so a snapshot is only read on
+  // machines with the same byte order.
+  //
+  struct SnapshotHeader {
+    char magic[8];
+    uint32_t weight_size;  // sizeof(T)
+    uint32_t directed;
+    uint64_t size;         // No. of vertices
+    uint64_t n_edges;
+  };
+
+  const char kSnapshotMagic[8] = {'G', 'R', 'A', 'P', 'H', 'E', 'L', '1'};
+
+  /**
+   * Write a generated graph to a binary snapshot
+   *
+   * @param graph: generated graph
+   * @param path: file path, which is truncated if it exists
+   */
+  template <class T>
+  void saveSnapshot(const GeneratedGraph<T>& graph, const std::string& path) {
+    const size_t bytes = sizeof(SnapshotHeader) + graph.edges.size()*sizeof(WeightedEdge<T>);
+    MappedFile file(path, bytes);
+    SnapshotHeader header;
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+    header.weight_size = sizeof(T);
+    header.directed = graph.directed ? 1 : 0;
+    header.size = graph.size;
+    header.n_edges = graph.edges.size();
+
+    char* data = static_cast<char*>(file.data());
+    std::memcpy(data, &header, sizeof(header));
+    if (!graph.edges.empty()) {
+      std::memcpy(data + sizeof(header), graph.edges.data(),
+                  graph.edges.size()*sizeof(WeightedEdge<T>));
+    }
+    file.sync();
+  }
+
+  /**
+   * Read a binary snapshot written by saveSnapshot()
+   *
+   * @param path: file path
+   * @return: the generated graph
+   * @throw: std::invalid_argument if the file is not a snapshot with
+   *         weights of type T
+   */
+  template <class T>
+  GeneratedGraph<T> loadSnapshot(const std::string& path) {
+    MappedFile file(path);
+    SnapshotHeader header;
+    if (file.size() < sizeof(header)) {
+      throw std::invalid_argument("Invalid argument: not a graph snapshot");
+    }
+    const char* data = static_cast<const char*>(file.data());
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) != 0) {
+      throw std::invalid_argument("Invalid argument: not a graph snapshot");
+    }
+    if (header.weight_size != sizeof(T)) {
+      throw std::invalid_argument("Invalid argument: different weight type");
+    }
+    if (file.size() != sizeof(header) + header.n_edges*sizeof(WeightedEdge<T>)) {
+      throw std::invalid_argument("Invalid argument: truncated graph snapshot");
+    }
+
+    GeneratedGraph<T> graph{(size_t)header.size, header.directed != 0,
+                            std::vector<WeightedEdge<T>>((size_t)header.n_edges)};
+    if (header.n_edges > 0) {
+      std::memcpy(graph.edges.data(), data + sizeof(header),
+                  graph.edges.size()*sizeof(WeightedEdge<T>));
+    }
+    return graph;
+  }
+
+}  // namespace graph_generator
+
+#endif //GRAPH_GRAPH_GENERATORS_H
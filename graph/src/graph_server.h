@@ -0,0 +1,567 @@
+//
+// A resident query server which keeps a graph in memory and answers
+// shortest path, BFS distance and component queries sent as lines of
+// text over a stream (stdin/stdout or the connections of a Unix
+// socket).
+//
+// Protocol: one query per line and one answer per line, in the order
+// of the queries of each connection.
+//
+//   dist <src> <dst>       smallest cost, or "inf" if not reachable
+//   hops <src> <dst>       No. of edges on the shortest unweighted path
+//   component <v>          the smallest vertex in the (weakly connected)
+//                          component of v
+//   connected <u> <v>      1 if u and v are in the same component, else 0
+//   stats                  counters of the server
+//   quit                   close the connection
+//
+// An invalid query is answered with "error <message>".
+//
+// The reader of each connection parses its lines into a shared queue.
+// Each worker thread takes all the queued queries (up to a batch size)
+// at once, and runs one search per distinct (kind, source) of the
+// batch, which stops when all the destinations of that source are
+// found. The workers own their search workspaces, so a search only
+// touches the vertices it visits.
+//
+
+#ifndef GRAPH_GRAPH_SERVER_H
+#define GRAPH_GRAPH_SERVER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "graph.h"
+#include "disjoint_set.h"
+#include "parallel.h"
+#include "graph_algorithms/dijkstra.h"
+#include "graph_algorithms/search_workspace.h"
+
+
+struct QueryServerStats {
+  uint64_t n_requests;     // No. of queries received
+  uint64_t n_batches;      // No. of batches taken by the workers
+  uint64_t n_searches;     // No. of searches, i.e. distinct sources of the batches
+  uint64_t n_connections;  // No. of connections accepted
+};
+
+namespace graph_server {
+
+  enum class QueryKind { kDistance, kHops, kComponent, kConnected, kStats, kInvalid };
+
+  struct Query {
+    QueryKind kind;
+    size_t src;
+    size_t dst;
+    std::string error;  // the reason of an invalid query
+  };
+
+  /**
+   * Parse a line of the protocol
+   *
+   * @param line: a query without the line break
+   * @param size: No. of vertices of the graph
+   * @return: the query, whose kind is kInvalid with a message if the
+   *          line cannot be answered
+   */
+  inline Query parseQuery(const std::string& line, size_t size) {
+    Query query {QueryKind::kInvalid, 0, 0, ""};
+    std::istringstream iss(line);
+    std::string command;
+    iss >> command;
+
+    size_t n_vertices = 0;
+    if (command == "dist") {
+      query.kind = QueryKind::kDistance;
+      n_vertices = 2;
+    } else if (command == "hops") {
+      query.kind = QueryKind::kHops;
+      n_vertices = 2;
+    } else if (command == "component") {
+      query.kind = QueryKind::kComponent;
+      n_vertices = 1;
+    } else if (command == "connected") {
+      query.kind = QueryKind::kConnected;
+      n_vertices = 2;
+    } else if (command == "stats") {
+      query.kind = QueryKind::kStats;
+    } else {
+      query.error = "unknown command";
+      return query;
+    }
+
+    size_t vertices[2] = {0, 0};
+    for (size_t i = 0; i < n_vertices; ++i) {
+      long long v = -1;
+      if (!(iss >> v) || v < 0) {
+        query.kind = QueryKind::kInvalid;
+        query.error = "expected " + std::to_string(n_vertices) + " vertices";
+        return query;
+      }
+      if ((unsigned long long)v >= size) {
+        query.kind = QueryKind::kInvalid;
+        query.error = "vertex out of range";
+        return query;
+      }
+      vertices[i] = (size_t)v;
+    }
+    std::string extra;
+    if (iss >> extra) {
+      query.kind = QueryKind::kInvalid;
+      query.error = "too many arguments";
+      return query;
+    }
+
+    query.src = vertices[0];
+    query.dst = vertices[1];
+    return query;
+  }
+
+  // write all the bytes, where a broken connection is ignored
+  inline void writeAll(int fd, bool is_socket, const std::string& text) {
+    size_t written = 0;
+    while (written < text.size()) {
+      ssize_t n = is_socket
+                  ? ::send(fd, text.data() + written, text.size() - written, MSG_NOSIGNAL)
+                  : ::write(fd, text.data() + written, text.size() - written);
+      if (n < 0 && errno == EINTR) { continue; }
+      if (n <= 0) { return; }
+      written += (size_t)n;
+    }
+  }
+
+}  // namespace graph_server
+
+template <class T>
+class GraphQueryServer {
+public:
+  /**
+   * constructor, which starts the workers
+   *
+   * @param graph: a directed/undirected graph with non-negative weights,
+   *               which must outlive the server
+   * @param n_threads: No. of worker threads (0 for the hardware default)
+   * @param max_batch: max No. of queries which a worker takes at once
+   */
+  explicit GraphQueryServer(const Graph<T>& graph, size_t n_threads=0, size_t max_batch=256)
+      : graph_(graph), max_batch_(std::max<size_t>(max_batch, 1)), stopped_(false),
+        workers_stopping_(false), listen_fd_(-1), n_readers_(0), n_requests_(0),
+        n_batches_(0), n_searches_(0), n_connections_(0) {
+    // the weakly connected components, labeled by their smallest vertex
+    DisjointSet components(graph.size());
+    for (size_t u = 0; u < graph.size(); ++u) {
+      for (graph::Edge<T>* e = graph.getList(u); e != nullptr; e = e->next) {
+        if (e->weight < 0) {
+          throw std::invalid_argument("Invalid argument: negative weight");
+        }
+        components.unite(u, e->dst);
+      }
+    }
+    const uint32_t kNone = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> smallest(graph.size(), kNone);
+    components_.resize(graph.size());
+    for (size_t v = 0; v < graph.size(); ++v) {
+      size_t root = components.find(v);
+      if (smallest[root] == kNone) { smallest[root] = (uint32_t)v; }
+      components_[v] = smallest[root];
+    }
+
+    if (n_threads == 0) { n_threads = graph_parallel::defaultThreadCount(); }
+    for (size_t i = 0; i < n_threads; ++i) {
+      workers_.emplace_back([this]() { work(); });
+    }
+  }
+
+  GraphQueryServer(const GraphQueryServer&) = delete;
+  GraphQueryServer& operator=(const GraphQueryServer&) = delete;
+
+  ~GraphQueryServer() { stop(); }
+
+  /**
+   * Answer one line right away on the calling thread, e.g. for tests,
+   * which counts in stats() as a request and a batch of one
+   *
+   * @param line: a query of the protocol
+   * @return: the answer without the line break
+   */
+  std::string answer(const std::string& line) {
+    SearchWorkspace<T> workspace(graph_.size());
+    std::vector<size_t> frontier;
+    std::vector<graph_server::Query> queries {graph_server::parseQuery(line, graph_.size())};
+    ++n_requests_;
+    ++n_batches_;
+    return answerBatch(queries, workspace, frontier)[0];
+  }
+
+  /**
+   * Serve a stream, e.g. stdin and stdout, until its end or "quit"
+   *
+   * It returns after all the answers are written.
+   *
+   * @param in_fd: file descriptor of the queries
+   * @param out_fd: file descriptor of the answers
+   */
+  void serve(int in_fd, int out_fd) {
+    std::shared_ptr<Connection> connection(new Connection(in_fd, out_fd, false, false));
+    read(connection);
+
+    std::unique_lock<std::mutex> lock(connection->mutex);
+    connection->drained.wait(lock, [&connection]() {
+      return connection->n_sent == connection->n_received;
+    });
+  }
+
+  /**
+   * Accept connections on a Unix socket in the background until stop()
+   *
+   * @param path: path of the socket, which is replaced if it exists
+   * @throw: std::runtime_error if the socket cannot be created
+   */
+  void listen(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+      throw std::invalid_argument("Invalid argument: socket path");
+    }
+    if (listen_fd_ >= 0) {
+      throw std::invalid_argument("Invalid operation: already listening");
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) { fail("socket", path); }
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, 128) != 0) {
+      int error = errno;
+      ::close(fd);
+      errno = error;
+      fail("bind", path);
+    }
+
+    listen_fd_ = fd;
+    socket_path_ = path;
+    accept_thread_ = std::thread([this]() { accept(); });
+  }
+
+  /**
+   * Stop accepting, close the connections, answer the queued queries
+   * and stop the workers
+   */
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(connections_mutex_);
+      if (stopped_) { return; }
+      stopped_ = true;
+    }
+
+    if (listen_fd_ >= 0) {
+      ::shutdown(listen_fd_, SHUT_RDWR);
+      accept_thread_.join();
+      ::close(listen_fd_);
+      ::unlink(socket_path_.c_str());
+      listen_fd_ = -1;
+    }
+
+    // a reader blocked in read() returns when its socket is shut down
+    {
+      std::unique_lock<std::mutex> lock(connections_mutex_);
+      for (auto& weak : connections_) {
+        if (auto connection = weak.lock()) { ::shutdown(connection->in_fd, SHUT_RDWR); }
+      }
+      readers_done_.wait(lock, [this]() { return n_readers_ == 0; });
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      workers_stopping_ = true;
+    }
+    queue_ready_.notify_all();
+    for (auto& worker : workers_) { worker.join(); }
+    workers_.clear();
+  }
+
+  QueryServerStats stats() const {
+    return {n_requests_.load(), n_batches_.load(), n_searches_.load(), n_connections_.load()};
+  }
+
+private:
+  // the answers of a connection are written in the order of its queries
+  struct Connection {
+    int in_fd;
+    int out_fd;
+    bool owns_fd;    // close the file descriptor at the end
+    bool is_socket;
+    std::mutex mutex;
+    std::condition_variable drained;  // all the answers are written
+    uint64_t n_received = 0;
+    uint64_t n_sent = 0;
+    std::map<uint64_t, std::string> ready;  // answers which wait for earlier ones
+
+    Connection(int in, int out, bool owns, bool socket)
+        : in_fd(in), out_fd(out), owns_fd(owns), is_socket(socket) {}
+
+    ~Connection() {
+      if (owns_fd) { ::close(in_fd); }
+    }
+  };
+
+  struct Request {
+    std::shared_ptr<Connection> connection;
+    uint64_t sequence;
+    graph_server::Query query;
+  };
+
+  const Graph<T>& graph_;
+  std::vector<uint32_t> components_;
+  const size_t max_batch_;
+
+  std::mutex queue_mutex_;
+  std::condition_variable queue_ready_;
+  std::deque<Request> queue_;
+  std::vector<std::thread> workers_;
+  bool stopped_;
+  bool workers_stopping_;
+
+  int listen_fd_;
+  std::string socket_path_;
+  std::thread accept_thread_;
+  std::mutex connections_mutex_;
+  std::condition_variable readers_done_;
+  std::vector<std::weak_ptr<Connection>> connections_;
+  size_t n_readers_;
+
+  std::atomic<uint64_t> n_requests_;
+  std::atomic<uint64_t> n_batches_;
+  std::atomic<uint64_t> n_searches_;
+  std::atomic<uint64_t> n_connections_;
+
+  static void fail(const char* call, const std::string& path) {
+    throw std::runtime_error(std::string(call) + " failed for " + path + ": " +
+                             std::strerror(errno));
+  }
+
+  void accept() {
+    while (true) {
+      int fd = ::accept(listen_fd_, nullptr, nullptr);
+      if (fd < 0) {
+        if (errno == EINTR || errno == ECONNABORTED) { continue; }
+        return;  // shut down by stop()
+      }
+
+      std::shared_ptr<Connection> connection(new Connection(fd, fd, true, true));
+      {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        if (stopped_) { return; }
+        // forget the closed connections
+        connections_.erase(std::remove_if(connections_.begin(), connections_.end(),
+                                          [](const std::weak_ptr<Connection>& weak) {
+          return weak.expired();
+        }), connections_.end());
+        connections_.push_back(connection);
+        ++n_readers_;
+      }
+      ++n_connections_;
+
+      std::thread([this, connection]() {
+        read(connection);
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        --n_readers_;
+        readers_done_.notify_all();
+      }).detach();
+    }
+  }
+
+  // parse the lines of a connection into the queue
+  void read(const std::shared_ptr<Connection>& connection) {
+    std::string buffer;
+    char chunk[4096];
+    while (true) {
+      ssize_t n = ::read(connection->in_fd, chunk, sizeof(chunk));
+      if (n < 0 && errno == EINTR) { continue; }
+      if (n <= 0) { return; }
+      buffer.append(chunk, (size_t)n);
+
+      size_t begin = 0;
+      size_t end;
+      while ((end = buffer.find('\n', begin)) != std::string::npos) {
+        std::string line = buffer.substr(begin, end - begin);
+        begin = end + 1;
+        if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+        if (line == "quit") { return; }
+        if (!line.empty()) { submit(connection, line); }
+      }
+      buffer.erase(0, begin);
+    }
+  }
+
+  void submit(const std::shared_ptr<Connection>& connection, const std::string& line) {
+    Request request {connection, 0, graph_server::parseQuery(line, graph_.size())};
+    {
+      std::lock_guard<std::mutex> lock(connection->mutex);
+      request.sequence = connection->n_received++;
+    }
+    ++n_requests_;
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      queue_.push_back(std::move(request));
+    }
+    queue_ready_.notify_one();
+  }
+
+  void work() {
+    SearchWorkspace<T> workspace(graph_.size());
+    std::vector<size_t> frontier;
+    std::vector<Request> batch;
+    std::vector<graph_server::Query> queries;
+    while (true) {
+      batch.clear();
+      {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        queue_ready_.wait(lock, [this]() { return !queue_.empty() || workers_stopping_; });
+        if (queue_.empty()) { return; }
+        size_t n = std::min(queue_.size(), max_batch_);
+        for (size_t i = 0; i < n; ++i) {
+          batch.push_back(std::move(queue_.front()));
+          queue_.pop_front();
+        }
+      }
+      ++n_batches_;
+
+      queries.clear();
+      for (const auto& request : batch) { queries.push_back(request.query); }
+      std::vector<std::string> answers = answerBatch(queries, workspace, frontier);
+      for (size_t i = 0; i < batch.size(); ++i) { respond(batch[i], answers[i]); }
+    }
+  }
+
+  void respond(const Request& request, const std::string& answer) {
+    Connection& connection = *request.connection;
+    std::lock_guard<std::mutex> lock(connection.mutex);
+    connection.ready[request.sequence] = answer;
+
+    std::string text;
+    auto next = connection.ready.begin();
+    while (next != connection.ready.end() && next->first == connection.n_sent) {
+      text += next->second;
+      text += '\n';
+      next = connection.ready.erase(next);
+      ++connection.n_sent;
+    }
+    graph_server::writeAll(connection.out_fd, connection.is_socket, text);
+    connection.drained.notify_all();
+  }
+
+  // BFS from src which stops when the marked targets are all reached;
+  // the hops are the costs of the workspace
+  void hopSearch(size_t src, size_t n_targets, SearchWorkspace<T>& workspace,
+                 std::vector<size_t>& frontier) {
+    workspace.reset(graph_.size());
+    workspace.set(src, 0, src);
+    if (workspace.isTarget(src) && --n_targets == 0) { return; }
+    frontier.assign(1, src);
+    for (size_t head = 0; head < frontier.size(); ++head) {
+      size_t u = frontier[head];
+      for (graph::Edge<T>* e = graph_.getList(u); e != nullptr; e = e->next) {
+        if (workspace.reached(e->dst)) { continue; }
+        workspace.set(e->dst, workspace.cost(u) + 1, u);
+        if (workspace.isTarget(e->dst) && --n_targets == 0) { return; }
+        frontier.push_back(e->dst);
+      }
+    }
+  }
+
+  std::vector<std::string> answerBatch(const std::vector<graph_server::Query>& queries,
+                                       SearchWorkspace<T>& workspace,
+                                       std::vector<size_t>& frontier) {
+    using graph_server::QueryKind;
+    std::vector<std::string> answers(queries.size());
+
+    // the searches, grouped by kind and source
+    std::vector<size_t> order;
+    for (size_t q = 0; q < queries.size(); ++q) {
+      const graph_server::Query& query = queries[q];
+      switch (query.kind) {
+        case QueryKind::kDistance:
+        case QueryKind::kHops:
+          order.push_back(q);
+          break;
+        case QueryKind::kComponent:
+          answers[q] = std::to_string(components_[query.src]);
+          break;
+        case QueryKind::kConnected:
+          answers[q] = components_[query.src] == components_[query.dst] ? "1" : "0";
+          break;
+        case QueryKind::kStats: {
+          QueryServerStats s = stats();
+          answers[q] = "requests " + std::to_string(s.n_requests) + " batches " +
+                       std::to_string(s.n_batches) + " searches " +
+                       std::to_string(s.n_searches) + " connections " +
+                       std::to_string(s.n_connections);
+          break;
+        }
+        case QueryKind::kInvalid:
+          answers[q] = "error " + query.error;
+          break;
+      }
+    }
+    std::sort(order.begin(), order.end(), [&queries](size_t a, size_t b) {
+      if (queries[a].kind != queries[b].kind) { return queries[a].kind < queries[b].kind; }
+      return queries[a].src < queries[b].src;
+    });
+
+    for (size_t begin = 0, end = 0; begin < order.size(); begin = end) {
+      const graph_server::Query& first = queries[order[begin]];
+      size_t n_targets = 0;
+      workspace.clearTargets(graph_.size());
+      for (end = begin; end < order.size() && queries[order[end]].kind == first.kind &&
+                        queries[order[end]].src == first.src; ++end) {
+        if (workspace.markTarget(queries[order[end]].dst)) { ++n_targets; }
+      }
+      ++n_searches_;
+
+      if (first.kind == QueryKind::kDistance) {
+        dijkstraSearch(graph_, first.src, workspace, [&](size_t v, T) {
+          return !workspace.isTarget(v) || --n_targets > 0;
+        });
+      } else {
+        hopSearch(first.src, n_targets, workspace, frontier);
+      }
+
+      // either all the targets are found or every reachable vertex is
+      for (size_t i = begin; i < end; ++i) {
+        size_t dst = queries[order[i]].dst;
+        if (!workspace.reached(dst)) {
+          answers[order[i]] = "inf";
+        } else if (first.kind == QueryKind::kDistance) {
+          answers[order[i]] = std::to_string(workspace.cost(dst));
+        } else {
+          answers[order[i]] = std::to_string((size_t)workspace.cost(dst));
+        }
+      }
+    }
+
+    return answers;
+  }
+};
+
+
+#endif //GRAPH_GRAPH_SERVER_H
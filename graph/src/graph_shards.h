@@ -0,0 +1,270 @@
+//
+// Subgraphs of the parts of a partitioned graph, which are written to
+// and read from binary snapshots so that each process of a sharded
+// algorithm only loads its own part.
+//
+
+#ifndef GRAPH_GRAPH_SHARDS_H
+#define GRAPH_GRAPH_SHARDS_H
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "graph.h"
+#include "mapped_file.h"
+#include "graph_algorithms/partition.h"
+
+
+//
+// The vertices of one part (the owned vertices), their out-edges, and
+// the vertices of the other parts which the edges lead to (the ghosts).
+//
+// The local ids are 0, ..., n_owned - 1 for the owned vertices in
+// ascending order of their global ids, followed by n_owned, ... for the
+// ghosts. A ghost also keeps its local id in the part which owns it,
+// so a message about a ghost can be read by its owner without any
+// lookup of global ids.
+//
+template <class T>
+struct GraphShard {
+  uint32_t part;
+  uint32_t n_parts;
+  uint64_t size;                          // No. of vertices of the whole graph
+  std::vector<uint32_t> owned;            // global id of each owned vertex
+  std::vector<uint32_t> ghosts;           // global id of each ghost
+  std::vector<uint32_t> ghost_owners;     // part which owns each ghost
+  std::vector<uint32_t> ghost_owner_ids;  // local id of each ghost in its owner
+  // the out-edges of owned vertex v are [offsets[v], offsets[v + 1])
+  std::vector<uint64_t> offsets;
+  std::vector<uint32_t> targets;          // local id of the dst of each edge
+  std::vector<T> weights;
+
+  size_t countOwned() const { return owned.size(); }
+  size_t countGhosts() const { return ghosts.size(); }
+  size_t countEdge() const { return targets.size(); }
+
+  // global id of a local vertex
+  uint32_t globalId(size_t local) const {
+    return local < owned.size() ? owned[local] : ghosts[local - owned.size()];
+  }
+};
+
+namespace graph_shards {
+
+  struct ShardHeader {
+    char magic[8];
+    uint32_t weight_size;  // sizeof(T)
+    uint32_t part;
+    uint32_t n_parts;
+    uint32_t reserved;
+    uint64_t size;         // No. of vertices of the whole graph
+    uint64_t n_owned;
+    uint64_t n_ghosts;
+    uint64_t n_edges;
+  };
+
+  const char kShardMagic[8] = {'G', 'R', 'A', 'P', 'H', 'S', 'H', '1'};
+
+  // file of a part
+  inline std::string shardPath(const std::string& prefix, size_t part) {
+    return prefix + "." + std::to_string(part) + ".shard";
+  }
+
+  /**
+   * Split a graph into the shards of its parts
+   *
+   * Time complexity O(V + E): each vertex and edge is visited by its own
+   * part only, and only the ghosts of a part are reset after it
+   *
+   * @param graph: directed/undirected graph with less than 2^32 vertices
+   * @param partition: the parts of the vertices
+   * @return: a shard for each part
+   */
+  template <class T>
+  std::vector<GraphShard<T>> makeShards(const Graph<T>& graph,
+                                        const GraphPartition& partition) {
+    const size_t n = graph.size();
+    const size_t n_parts = partition.sizes.size();
+    if (partition.parts.size() != n) {
+      throw std::invalid_argument("Invalid argument: different sizes of graph and parts");
+    }
+    if (n > std::numeric_limits<uint32_t>::max()) {
+      throw std::invalid_argument("Invalid argument: too many vertices");
+    }
+
+    // the local id of each vertex in its own part
+    std::vector<GraphShard<T>> shards(n_parts);
+    std::vector<uint32_t> local_ids(n);
+    for (size_t v = 0; v < n; ++v) {
+      GraphShard<T>& shard = shards[partition.parts[v]];
+      local_ids[v] = (uint32_t)shard.owned.size();
+      shard.owned.push_back((uint32_t)v);
+    }
+
+    // the ghost id of each vertex in the current part, which is reset
+    // after the part
+    const uint32_t kNoGhost = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> ghost_ids(n, kNoGhost);
+    for (size_t p = 0; p < n_parts; ++p) {
+      GraphShard<T>& shard = shards[p];
+      shard.part = (uint32_t)p;
+      shard.n_parts = (uint32_t)n_parts;
+      shard.size = n;
+      shard.offsets.reserve(shard.owned.size() + 1);
+      shard.offsets.push_back(0);
+
+      const size_t n_owned = shard.owned.size();
+      for (auto u : shard.owned) {
+        for (graph::Edge<T>* e = graph.getList(u); e != nullptr; e = e->next) {
+          size_t v = e->dst;
+          uint32_t target = local_ids[v];
+          if (partition.parts[v] != p) {
+            if (ghost_ids[v] == kNoGhost) {
+              ghost_ids[v] = (uint32_t)shard.ghosts.size();
+              shard.ghosts.push_back((uint32_t)v);
+              shard.ghost_owners.push_back(partition.parts[v]);
+              shard.ghost_owner_ids.push_back(local_ids[v]);
+            }
+            target = (uint32_t)(n_owned + ghost_ids[v]);
+          }
+          shard.targets.push_back(target);
+          shard.weights.push_back(e->weight);
+        }
+        shard.offsets.push_back(shard.targets.size());
+      }
+
+      for (auto v : shard.ghosts) { ghost_ids[v] = kNoGhost; }
+    }
+
+    return shards;
+  }
+
+  // copy an array to a file and move past it
+  template <class V>
+  void writeArray(char*& out, const std::vector<V>& values) {
+    if (!values.empty()) { std::memcpy(out, values.data(), values.size()*sizeof(V)); }
+    out += values.size()*sizeof(V);
+  }
+
+  template <class V>
+  void readArray(const char*& in, std::vector<V>& values, size_t size) {
+    values.resize(size);
+    if (size > 0) { std::memcpy(&values[0], in, size*sizeof(V)); }
+    in += size*sizeof(V);
+  }
+
+  template <class T>
+  size_t shardBytes(const ShardHeader& header) {
+    return sizeof(ShardHeader) + header.n_owned*sizeof(uint32_t) +
+           3*header.n_ghosts*sizeof(uint32_t) + (header.n_owned + 1)*sizeof(uint64_t) +
+           header.n_edges*(sizeof(uint32_t) + sizeof(T));
+  }
+
+  /**
+   * Write a shard to a binary snapshot: the header and then the arrays
+   * as they are in memory
+   *
+   * @param shard: shard of a part
+   * @param path: file path, which is truncated if it exists
+   */
+  template <class T>
+  void saveShard(const GraphShard<T>& shard, const std::string& path) {
+    ShardHeader header;
+    std::memcpy(header.magic, kShardMagic, sizeof(header.magic));
+    header.weight_size = sizeof(T);
+    header.part = shard.part;
+    header.n_parts = shard.n_parts;
+    header.reserved = 0;
+    header.size = shard.size;
+    header.n_owned = shard.owned.size();
+    header.n_ghosts = shard.ghosts.size();
+    header.n_edges = shard.targets.size();
+
+    MappedFile file(path, shardBytes<T>(header));
+    char* out = static_cast<char*>(file.data());
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    writeArray(out, shard.owned);
+    writeArray(out, shard.ghosts);
+    writeArray(out, shard.ghost_owners);
+    writeArray(out, shard.ghost_owner_ids);
+    writeArray(out, shard.offsets);
+    writeArray(out, shard.targets);
+    writeArray(out, shard.weights);
+    file.sync();
+  }
+
+  /**
+   * Read the header of a shard snapshot
+   *
+   * @throw: std::invalid_argument if the file is not a shard with
+   *         weights of type T
+   */
+  template <class T>
+  ShardHeader readShardHeader(const MappedFile& file) {
+    ShardHeader header;
+    if (file.size() < sizeof(header)) {
+      throw std::invalid_argument("Invalid argument: not a graph shard");
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, kShardMagic, sizeof(header.magic)) != 0) {
+      throw std::invalid_argument("Invalid argument: not a graph shard");
+    }
+    if (header.weight_size != sizeof(T)) {
+      throw std::invalid_argument("Invalid argument: different weight type");
+    }
+    if (file.size() != shardBytes<T>(header)) {
+      throw std::invalid_argument("Invalid argument: truncated graph shard");
+    }
+    return header;
+  }
+
+  // read a shard snapshot written by saveShard()
+  template <class T>
+  GraphShard<T> loadShard(const std::string& path) {
+    MappedFile file(path);
+    ShardHeader header = readShardHeader<T>(file);
+
+    GraphShard<T> shard;
+    shard.part = header.part;
+    shard.n_parts = header.n_parts;
+    shard.size = header.size;
+    const char* in = static_cast<const char*>(file.data()) + sizeof(header);
+    readArray(in, shard.owned, header.n_owned);
+    readArray(in, shard.ghosts, header.n_ghosts);
+    readArray(in, shard.ghost_owners, header.n_ghosts);
+    readArray(in, shard.ghost_owner_ids, header.n_ghosts);
+    readArray(in, shard.offsets, header.n_owned + 1);
+    readArray(in, shard.targets, header.n_edges);
+    readArray(in, shard.weights, header.n_edges);
+    return shard;
+  }
+
+  /**
+   * Split a graph by a partition and write a snapshot per part
+   *
+   * @param graph: directed/undirected graph
+   * @param partition: the parts of the vertices
+   * @param prefix: the snapshot of part p is shardPath(prefix, p)
+   * @return: path of the snapshot of each part
+   */
+  template <class T>
+  std::vector<std::string> writeShards(const Graph<T>& graph,
+                                       const GraphPartition& partition,
+                                       const std::string& prefix) {
+    std::vector<GraphShard<T>> shards = makeShards(graph, partition);
+    std::vector<std::string> paths;
+    for (size_t p = 0; p < shards.size(); ++p) {
+      paths.push_back(shardPath(prefix, p));
+      saveShard(shards[p], paths.back());
+    }
+    return paths;
+  }
+
+}  // namespace graph_shards
+
+#endif //GRAPH_GRAPH_SHARDS_H
@@ -0,0 +1,101 @@
+//
+// Counters of the work done in the hot loops of the shortest path
+// algorithms, to explain why a run is slow rather than only how slow.
+//
+// The counters only exist if GRAPH_ENABLE_STATS is defined (the CMake
+// option of the same name). Otherwise graph_stats::count() is an empty
+// inline function and costs nothing. Each thread has its own counters,
+// so the counting needs no synchronization; collect() gets the counts
+// of the calling thread during one run.
+//
+
+#ifndef GRAPH_GRAPH_STATS_H
+#define GRAPH_GRAPH_STATS_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+
+struct SearchStats {
+  uint64_t relaxations = 0;  // edges tried to lower the cost of their dst
+  uint64_t updates = 0;      // relaxations which lowered a cost
+  uint64_t pushes = 0;       // entries added to the heap (queue)
+  uint64_t pops = 0;         // entries removed from the heap (queue)
+  uint64_t stale = 0;        // popped entries skipped for an old cost
+  uint64_t settled = 0;      // vertices whose cost became final
+  uint64_t rounds = 0;       // passes over all the edges
+
+  SearchStats& operator-=(const SearchStats& other) {
+    relaxations -= other.relaxations;
+    updates -= other.updates;
+    pushes -= other.pushes;
+    pops -= other.pops;
+    stale -= other.stale;
+    settled -= other.settled;
+    rounds -= other.rounds;
+    return *this;
+  }
+};
+
+namespace graph_stats {
+
+#if defined(GRAPH_ENABLE_STATS)
+  const bool kEnabled = true;
+
+  // the counters of this thread
+  inline SearchStats& counters() {
+    static thread_local SearchStats stats;
+    return stats;
+  }
+#else
+  const bool kEnabled = false;
+#endif
+
+  /**
+   * Add to a counter of this thread, e.g.
+   * graph_stats::count(&SearchStats::pushes)
+   */
+  inline void count(uint64_t SearchStats::* counter, uint64_t n=1) {
+#if defined(GRAPH_ENABLE_STATS)
+    counters().*counter += n;
+#else
+    (void)counter;
+    (void)n;
+#endif
+  }
+
+  /**
+   * Run f() and get the counts of the calling thread during the run
+   * (all zero if the stats are disabled)
+   *
+   * The threads of a multithreaded algorithm count in their own
+   * counters, which are not included.
+   */
+  template <class F>
+  SearchStats collect(F f) {
+#if defined(GRAPH_ENABLE_STATS)
+    SearchStats before = counters();
+    f();
+    SearchStats stats = counters();
+    stats -= before;
+    return stats;
+#else
+    f();
+    return SearchStats();
+#endif
+  }
+
+  // print the counts of a run in one line, only if the stats are enabled
+  inline void report(std::ostream& os, const SearchStats& stats,
+                     const std::string& indent="  ") {
+    if (!kEnabled) { return; }
+    os << indent << stats.relaxations << " relaxations, " << stats.updates << " updates, "
+       << stats.pushes << " pushes, " << stats.pops << " pops, " << stats.stale
+       << " stale, " << stats.settled << " settled, " << stats.rounds << " rounds"
+       << std::endl;
+  }
+
+}  // namespace graph_stats
+
+#endif //GRAPH_GRAPH_STATS_H
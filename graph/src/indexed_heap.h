@@ -0,0 +1,157 @@
+//
+// A binary heap over the ids 0, 1, ..., n - 1 which supports
+// decrease-key.
+//
+
+#ifndef GRAPH_INDEXED_HEAP_H
+#define GRAPH_INDEXED_HEAP_H
+
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+//
+// Min-heap of ids keyed by values of type K
+//
+// Each id is in the heap at most once, and its position in the heap is
+// tracked, so the key of an id in the heap can be lowered in O(logn)
+// time. Hence the heap never holds more than n entries, unlike a
+// std::priority_queue in which an old copy is left behind for every
+// lowered key.
+//
+// The keys are compared with Compare, so IndexedMinHeap<K, std::greater<K>>
+// is a max-heap, whose decreaseKey() raises a key.
+//
+template <class K, class Compare = std::less<K>>
+class IndexedMinHeap {
+public:
+  /**
+   * constructor
+   *
+   * @param capacity: ids are in [0, capacity)
+   */
+  explicit IndexedMinHeap(size_t capacity=0) { reset(capacity); }
+
+  // remove all the ids and set the capacity
+  void reset(size_t capacity) {
+    heap_.clear();
+    heap_.reserve(capacity);
+    positions_.assign(capacity, kNotInHeap);
+    keys_.resize(capacity);
+  }
+
+  // get No. of ids in the heap
+  size_t size() const { return heap_.size(); }
+
+  bool empty() const { return heap_.empty(); }
+
+  // whether an id is in the heap
+  bool contains(size_t id) const {
+    return positions_.at(id) != kNotInHeap;
+  }
+
+  // get the last key of an id which has been pushed
+  const K& key(size_t id) const { return keys_.at(id); }
+
+  // get the id with the smallest key
+  size_t top() const {
+    if (heap_.empty()) { throw std::out_of_range("Out of range: empty heap"); }
+    return heap_[0];
+  }
+
+  // add an id which is not in the heap
+  void push(size_t id, const K& key) {
+    if (contains(id)) {
+      throw std::invalid_argument("Invalid argument: id is in the heap");
+    }
+    keys_[id] = key;
+    positions_[id] = heap_.size();
+    heap_.push_back(id);
+    siftUp(heap_.size() - 1);
+  }
+
+  // lower the key of an id in the heap
+  void decreaseKey(size_t id, const K& key) {
+    if (!contains(id)) {
+      throw std::invalid_argument("Invalid argument: id is not in the heap");
+    }
+    if (compare_(keys_[id], key)) {
+      throw std::invalid_argument("Invalid argument: key is larger");
+    }
+    keys_[id] = key;
+    siftUp(positions_[id]);
+  }
+
+  /**
+   * Add an id, or lower its key if it is in the heap
+   *
+   * @return: false if the id is in the heap with a key not larger
+   *          than "key" (nothing is changed)
+   */
+  bool pushOrDecrease(size_t id, const K& key) {
+    if (!contains(id)) {
+      push(id, key);
+      return true;
+    }
+    if (!compare_(key, keys_[id])) { return false; }
+    keys_[id] = key;
+    siftUp(positions_[id]);
+    return true;
+  }
+
+  // remove and return the id with the smallest key
+  size_t pop() {
+    size_t id = top();
+    swapEntries(0, heap_.size() - 1);
+    heap_.pop_back();
+    positions_[id] = kNotInHeap;
+    if (!heap_.empty()) { siftDown(0); }
+    return id;
+  }
+
+private:
+  static const size_t kNotInHeap = std::numeric_limits<size_t>::max();
+
+  std::vector<size_t> heap_;       // ids
+  std::vector<size_t> positions_;  // position of each id in heap_
+  std::vector<K> keys_;
+  Compare compare_;
+
+  bool less(size_t i, size_t j) const {
+    return compare_(keys_[heap_[i]], keys_[heap_[j]]);
+  }
+
+  void swapEntries(size_t i, size_t j) {
+    std::swap(heap_[i], heap_[j]);
+    positions_[heap_[i]] = i;
+    positions_[heap_[j]] = j;
+  }
+
+  void siftUp(size_t i) {
+    while (i > 0 && less(i, (i - 1)/2)) {
+      swapEntries(i, (i - 1)/2);
+      i = (i - 1)/2;
+    }
+  }
+
+  void siftDown(size_t i) {
+    while (true) {
+      size_t smallest = i;
+      size_t left = 2*i + 1;
+      size_t right = left + 1;
+      if (left < heap_.size() && less(left, smallest)) { smallest = left; }
+      if (right < heap_.size() && less(right, smallest)) { smallest = right; }
+      if (smallest == i) { return; }
+      swapEntries(i, smallest);
+      i = smallest;
+    }
+  }
+};
+
+template <class K, class Compare>
+const size_t IndexedMinHeap<K, Compare>::kNotInHeap;
+
+#endif //GRAPH_INDEXED_HEAP_H
@@ -6,18 +6,79 @@
 #include "test/test_bfs.h"
 #include "test/test_dijkstra.h"
 #include "test/test_kosaraju.h"
+#include "test/test_indexed_heap.h"
 #include "test/test_prim.h"
+#include "test/test_disjoint_set.h"
 #include "test/test_kruskal.h"
+#include "test/test_boruvka.h"
+#include "test/test_incremental_mst.h"
 #include "test/test_bellman_ford.h"
 #include "test/test_floyd_warshall.h"
 #include "test/test_johnson.h"
+#include "test/test_apsp_matrix.h"
+#include "test/test_next_hop_table.h"
+#include "test/test_min_plus.h"
+#include "test/test_batch_shortest_path.h"
+#include "test/test_dynamic_shortest_path.h"
+#include "test/test_karger.h"
+#include "test/test_stoer_wagner.h"
+#include "test/test_versioned_graph.h"
+#include "test/test_graph_generators.h"
+#include "test/test_partition.h"
+#include "test/test_compressed_graph.h"
+#include "test/test_graph_stats.h"
+#include "test/test_graph_server.h"
+#include "test/test_chain_contraction.h"
 #include "assignments/assignment_shortest_path.h"
 #include "assignments/assignment_MST.h"
+#include "assignments/assignment_karger.h"
 #include "assignments/assignment_SCC.h"
 #include "assignments/assignment_all_pair_shortest_path.h"
+#include "benchmarks/benchmark_apsp.h"
+#include "benchmarks/benchmark_mst.h"
+#include "benchmarks/benchmark_min_cut.h"
+#include "benchmarks/benchmark_scaling.h"
+#include "benchmarks/benchmark_partition.h"
+#include "benchmarks/benchmark_compressed_graph.h"
+#include "benchmarks/benchmark_query_server.h"
+#include "benchmarks/benchmark_chain_contraction.h"
 
+#include <string>
 
-int main() {
+
+int main(int argc, char* argv[]) {
+
+  // "run benchmark [apsp|mst|mincut|scaling [max_edges]|partition|
+  // compressed|server|chains]" only runs the benchmarks (all of them by default)
+  if (argc > 1 && std::string(argv[1]) == "benchmark") {
+    std::string name = argc > 2 ? argv[2] : "";
+    if (name.empty() || name == "apsp") {
+      graph_benchmark::runAllPairShortestPathBenchmark();
+    }
+    if (name.empty() || name == "mst") {
+      graph_benchmark::runMinimumSpanningTreeBenchmark();
+    }
+    if (name.empty() || name == "mincut") {
+      graph_benchmark::runMinCutBenchmark();
+    }
+    if (name.empty() || name == "scaling") {
+      size_t max_edges = argc > 3 ? std::stoull(argv[3]) : 1000000;
+      graph_benchmark::runScalingBenchmark(max_edges);
+    }
+    if (name.empty() || name == "partition") {
+      graph_benchmark::runPartitionBenchmark();
+    }
+    if (name.empty() || name == "compressed") {
+      graph_benchmark::runCompressedGraphBenchmark();
+    }
+    if (name.empty() || name == "server") {
+      graph_benchmark::runQueryServerBenchmark();
+    }
+    if (name.empty() || name == "chains") {
+      graph_benchmark::runChainContractionBenchmark();
+    }
+    return 0;
+  }
 
   graph_test::simpleUdGraph();
   graph_test::simpleGraph();
@@ -29,19 +90,39 @@ int main() {
   graph_test::testBreathFirstSearch();
   graph_test::testDepthFirstSearch();
   graph_test::testDijkstra();
+  graph_test::testDijkstraBatch();
+  graph_test::testGraphStats();
+  graph_test::testDynamicShortestPath();
   graph_test::testKosaraju();
+  graph_test::testIndexedHeap();
   graph_test::testPrim();
+  graph_test::testDisjointSet();
   graph_test::testKruskal();
+  graph_test::testBoruvka();
+  graph_test::testIncrementalMinimumSpanningForest();
   graph_test::testBellmanFord();
+  graph_test::testChainContraction();
   graph_test::testFloydWarshall();
+  graph_test::testFloydWarshallBlocked();
   graph_test::testJohnson();
-//  graph_test::testKarger();
+  graph_test::testJohnsonMultithreaded();
+  graph_test::testApspMatrix();
+  graph_test::testNextHopTable();
+  graph_test::testMinPlusShortestPath();
+  graph_test::testKarger();
+  graph_test::testStoerWagner();
+  graph_test::testVersionedGraph();
+  graph_test::testGraphGenerators();
+  graph_test::testPartition();
+  graph_test::testShardedBfs();
+  graph_test::testCompressedGraph();
+  graph_test::testQueryServer();
 
   runShortestPathAssignment();
   runPrimAssignment();
   runSccAssignment();
   runAllPairShortestPathAssignment();
-//  assignment::runKargerAssignment();
+  runKargerAssignment();
 
   return 0;
 }
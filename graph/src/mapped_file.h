@@ -0,0 +1,110 @@
+//
+// A file mapped into memory (POSIX mmap), used to store results which
+// do not fit in RAM or need to be persisted.
+//
+
+#ifndef GRAPH_MAPPED_FILE_H
+#define GRAPH_MAPPED_FILE_H
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+class MappedFile {
+public:
+  /**
+   * Create (or truncate) a file with the given size and map it for
+   * reading and writing.
+   *
+   * @param path: file path
+   * @param size: file size in bytes
+   */
+  MappedFile(const std::string& path, size_t size)
+      : data_(nullptr), size_(size), writable_(true) {
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) { fail("open", path, errno); }
+    if (::ftruncate(fd, (off_t)size) != 0) {
+      int error = errno;
+      ::close(fd);
+      fail("ftruncate", path, error);
+    }
+    map(fd, path);
+  }
+
+  /**
+   * Map an existing file for reading only.
+   *
+   * @param path: file path
+   */
+  explicit MappedFile(const std::string& path)
+      : data_(nullptr), size_(0), writable_(false) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { fail("open", path, errno); }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      int error = errno;
+      ::close(fd);
+      fail("fstat", path, error);
+    }
+    size_ = (size_t)st.st_size;
+    map(fd, path);
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other)
+      : data_(other.data_), size_(other.size_), writable_(other.writable_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  ~MappedFile() {
+    if (data_ != nullptr) { ::munmap(data_, size_); }
+  }
+
+  void* data() { return data_; }
+  const void* data() const { return data_; }
+
+  // get the size of the file in bytes
+  size_t size() const { return size_; }
+
+  // flush the modified pages to the file
+  void sync() {
+    if (data_ != nullptr && writable_) { ::msync(data_, size_, MS_SYNC); }
+  }
+
+private:
+  void* data_;
+  size_t size_;
+  bool writable_;
+
+  void map(int fd, const std::string& path) {
+    // mmap() does not accept an empty mapping
+    if (size_ > 0) {
+      int protection = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+      void* p = ::mmap(nullptr, size_, protection, MAP_SHARED, fd, 0);
+      if (p == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        fail("mmap", path, error);
+      }
+      data_ = p;
+    }
+    ::close(fd);
+  }
+
+  static void fail(const char* call, const std::string& path, int error) {
+    throw std::runtime_error(std::string(call) + " failed for " + path +
+                             ": " + std::strerror(error));
+  }
+};
+
+#endif //GRAPH_MAPPED_FILE_H
@@ -0,0 +1,152 @@
+//
+// Minimal helpers for running independent tasks on several threads.
+//
+
+#ifndef GRAPH_PARALLEL_H
+#define GRAPH_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace graph_parallel {
+  //
+  // get the No. of threads supported by the hardware (at least 1)
+  //
+  inline size_t defaultThreadCount() {
+    size_t n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+  }
+
+  //
+  // Run f(thread_id, i) for i in [0, n) on a pool of n_threads worker
+  // threads.
+  //
+  // The tasks are handed out one at a time from a shared counter, so
+  // tasks with very different costs are still balanced. Each worker
+  // owns a thread_id in [0, n_threads), which can be used to index
+  // per-thread scratch memory. The first exception thrown by a task is
+  // re-thrown in the calling thread after all the workers finish.
+  //
+  // @param n: No. of tasks
+  // @param n_threads: No. of worker threads (0 for the hardware default)
+  // @param f: callable with the signature void(size_t, size_t)
+  //
+  template <class F>
+  void parallelFor(size_t n, size_t n_threads, F f) {
+    if (n_threads == 0) { n_threads = defaultThreadCount(); }
+    if (n_threads > n) { n_threads = n; }
+
+    // run in the calling thread to avoid the cost of creating threads
+    if (n_threads <= 1) {
+      for (size_t i = 0; i < n; ++i) { f(0, i); }
+      return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto worker = [&](size_t thread_id) {
+      try {
+        size_t i;
+        while (!failed && (i = next++) < n) { f(thread_id, i); }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) { error = std::current_exception(); }
+        failed = true;
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < n_threads; ++t) { threads.emplace_back(worker, t); }
+    worker(0);
+    for (auto& t : threads) { t.join(); }
+
+    if (error) { std::rethrow_exception(error); }
+  }
+
+  //
+  // Run f(thread_id, begin, end) over the ranges which cover [0, n) on
+  // a pool of n_threads worker threads.
+  //
+  // Unlike parallelFor(), which hands out one index at a time, each
+  // task is a contiguous range, so cheap loop bodies over millions of
+  // elements do not pay for the shared counter. There are a few ranges
+  // per thread to balance the load.
+  //
+  // @param n: No. of elements
+  // @param n_threads: No. of worker threads (0 for the hardware default)
+  // @param f: callable with the signature void(size_t, size_t, size_t)
+  //
+  template <class F>
+  void parallelForRange(size_t n, size_t n_threads, F f) {
+    if (n_threads == 0) { n_threads = defaultThreadCount(); }
+    const size_t n_ranges = std::min(n, 4*n_threads);
+    parallelFor(n_ranges, n_threads, [&](size_t thread_id, size_t k) {
+      f(thread_id, n*k/n_ranges, n*(k + 1)/n_ranges);
+    });
+  }
+
+  // a thread of parallelSort() sorts at least this many elements
+  const size_t kMinSortChunk = 1 << 14;
+
+  //
+  // Sort [first, last) on a pool of n_threads worker threads.
+  //
+  // The range is split into one chunk per thread and the chunks are
+  // sorted in parallel. The sorted chunks are then merged pairwise in
+  // log2(n_threads) rounds, where the merges of a round run in
+  // parallel. Small ranges are sorted in the calling thread.
+  //
+  // @param n_threads: No. of worker threads (0 for the hardware default)
+  // @param comp: comparator as in std::sort()
+  //
+  template <class RandomIt, class Compare>
+  void parallelSort(RandomIt first, RandomIt last, size_t n_threads,
+                    Compare comp) {
+    if (n_threads == 0) { n_threads = defaultThreadCount(); }
+    const size_t n = (size_t)(last - first);
+    const size_t n_chunks = std::min(n_threads, n / kMinSortChunk);
+    if (n_chunks <= 1) {
+      std::sort(first, last, comp);
+      return;
+    }
+
+    std::vector<RandomIt> bounds(n_chunks + 1);
+    for (size_t k = 0; k <= n_chunks; ++k) { bounds[k] = first + n*k/n_chunks; }
+
+    parallelFor(n_chunks, n_threads, [&](size_t, size_t k) {
+      std::sort(bounds[k], bounds[k + 1], comp);
+    });
+
+    // merge the runs [lo, mid) and [mid, hi) of chunks
+    for (size_t width = 1; width < n_chunks; width *= 2) {
+      parallelFor((n_chunks + 2*width - 1) / (2*width), n_threads,
+                  [&](size_t, size_t p) {
+        size_t lo = 2*p*width;
+        size_t mid = std::min(lo + width, n_chunks);
+        size_t hi = std::min(lo + 2*width, n_chunks);
+        if (mid < hi) {
+          std::inplace_merge(bounds[lo], bounds[mid], bounds[hi], comp);
+        }
+      });
+    }
+  }
+
+  template <class RandomIt>
+  void parallelSort(RandomIt first, RandomIt last, size_t n_threads=0) {
+    typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+    parallelSort(first, last, n_threads, std::less<value_type>());
+  }
+
+}  // namespace graph_parallel
+
+#endif //GRAPH_PARALLEL_H
@@ -0,0 +1,92 @@
+#ifndef GRAPH_TEST_APSP_MATRIX_H
+#define GRAPH_TEST_APSP_MATRIX_H
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "unittest_graph.h"
+#include "../graph_algorithms/apsp_matrix.h"
+#include "../graph_algorithms/floyd_warshall.h"
+#include "../graph_algorithms/johnson.h"
+
+
+namespace graph_test {
+
+  void testApspMatrix() {
+    std::cout << "\nTesting all-pair shortest path matrix..." << std::endl;
+
+    const auto graph = graph_test::negativeWeightedGraph();
+    const size_t n = graph.size();
+    auto expected = floydWarshall(graph).first;
+
+    // the same costs from both algorithms, in RAM and in a file
+    const std::string path = "apsp_matrix_test.bin";
+    ApspMatrix<int> fw = floydWarshallMatrix(graph);
+    ApspMatrix<int> js = johnsonMatrix(graph, 2);
+    {
+      ApspMatrix<int> js_file = johnsonMatrix(graph, 3, path);
+    }
+    ApspMatrix<int> loaded = ApspMatrix<int>::open(path);
+    int expected_min = ApspMatrix<int>::infinity();
+    int expected_max = std::numeric_limits<int>::lowest();
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        if (fw.dist(i, j) != expected[i][j] || js.dist(i, j) != expected[i][j] ||
+            loaded.dist(i, j) != expected[i][j] ||
+            fw.reachable(i, j) != (expected[i][j] < ApspMatrix<int>::infinity()) ||
+            fw.row(i)[j] != expected[i][j]) {
+          std::cout << "Failed!!!" << std::endl;
+          return;
+        }
+        expected_min = std::min(expected_min, expected[i][j]);
+        if (fw.reachable(i, j)) { expected_max = std::max(expected_max, expected[i][j]); }
+      }
+    }
+    if (fw.row(1).size() != n || !std::equal(fw.row(1).begin(), fw.row(1).end(), expected[1].begin()) ||
+        fw.min() != -9 || fw.min() != expected_min || loaded.min() != expected_min ||
+        fw.max() != expected_max || js.max() != expected_max) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // a mapped file is read-only and out-of-range vertices are rejected
+    bool read_only = false;
+    try { loaded.data(); } catch (const std::invalid_argument&) { read_only = true; }
+    bool out_of_range = false;
+    try { fw.dist(0, n); } catch (const std::out_of_range&) { out_of_range = true; }
+    std::remove(path.c_str());
+    if (!read_only || !out_of_range) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // the threaded reductions on a large matrix
+    ApspMatrix<long> large(1500);
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<long> cost(-1000000, 1000000);
+    std::bernoulli_distribution connected(0.9);
+    long smallest = ApspMatrix<long>::infinity();
+    long largest = std::numeric_limits<long>::lowest();
+    long* data = large.data();
+    for (size_t k = 0; k < 1500*1500; ++k) {
+      if (connected(generator)) {
+        data[k] = cost(generator);
+        smallest = std::min(smallest, data[k]);
+        largest = std::max(largest, data[k]);
+      }
+    }
+    if (large.min(1) != smallest || large.min(4) != smallest ||
+        large.max(1) != largest || large.max(3) != largest) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}  // namespace graph_test
+
+#endif //GRAPH_TEST_APSP_MATRIX_H
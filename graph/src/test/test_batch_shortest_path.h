@@ -0,0 +1,63 @@
+#ifndef GRAPH_TEST_BATCH_SHORTEST_PATH_H
+#define GRAPH_TEST_BATCH_SHORTEST_PATH_H
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "unittest_graph.h"
+#include "../graph_algorithms/batch_shortest_path.h"
+
+
+namespace graph_test {
+
+  void testDijkstraBatch() {
+    std::cout << "\nTesting batched point-to-point Dijkstra's algorithm..." << std::endl;
+
+    auto graph = graph_test::distanceGraph();
+    const auto kINF = SearchWorkspace<unsigned int>::infinity();
+
+    // repeated sources and destinations in no particular order, a
+    // query to itself and the isolated vertex 6
+    std::vector<std::pair<size_t, size_t>> queries = {
+        {2, 5}, {0, 5}, {0, 1}, {2, 4}, {0, 5}, {6, 0}, {3, 3}, {0, 6}, {2, 0}};
+    std::vector<unsigned int> expected = {4, 7, 1, 2, 7, kINF, 0, kINF, kINF};
+
+    for (size_t n_threads : {1, 3}) {
+      BatchQueryStats stats;
+      std::vector<unsigned int> costs = dijkstraBatch(graph, queries, n_threads, &stats);
+      assert(costs == expected);
+      assert(stats.n_queries == queries.size());
+      assert(stats.n_sources == 4);
+    }
+
+    // every pair gives the same costs as the full searches
+    std::vector<std::pair<size_t, size_t>> all_pairs;
+    for (size_t src = 0; src < graph.size(); ++src) {
+      for (size_t dst = 0; dst < graph.size(); ++dst) {
+        all_pairs.push_back(std::make_pair(src, dst));
+      }
+    }
+    std::vector<unsigned int> costs = dijkstraBatch(graph, all_pairs, 2);
+    for (size_t q = 0; q < all_pairs.size(); ++q) {
+      auto path = dijkstra(graph, all_pairs[q].first);
+      assert(costs[q] == path.first[all_pairs[q].second]);
+    }
+
+    // only the vertices up to the farthest destination are settled
+    BatchQueryStats stats;
+    dijkstraBatch(graph, {{0, 1}, {0, 0}}, 1, &stats);
+    assert(stats.n_settled == 2);
+
+    try {
+      dijkstraBatch(graph, {{0, 7}});
+      std::cerr << "Failed to detect invalid destination!" << std::endl;
+      exit (EXIT_FAILURE);
+    } catch (const std::out_of_range&) {
+      std::cout << "Passed!" << std::endl;
+    }
+  }
+
+}
+
+#endif //GRAPH_TEST_BATCH_SHORTEST_PATH_H
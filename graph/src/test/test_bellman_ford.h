@@ -6,12 +6,33 @@
 #define GRAPH_TEST_BELLMAN_FORD_H_H
 
 
+#include <cassert>
+#include <deque>
+
 #include "unittest_graph.h"
 #include "../graph_algorithms/bellman_ford.h"
 
 
 namespace graph_test {
 
+  //
+  // get the total weight of a cycle, which must consist of graph edges
+  //
+  template <class T>
+  T cycleWeight(const DirectedGraph<T>& graph, const std::deque<size_t>& cycle) {
+    T weight = 0;
+    for (size_t i = 0; i < cycle.size(); ++i) {
+      size_t dst = cycle[(i + 1) % cycle.size()];
+      graph::Edge<T>* current_edge = graph.getList(cycle[i]);
+      while (current_edge != nullptr && current_edge->dst != dst) {
+        current_edge = current_edge->next;
+      }
+      assert(current_edge != nullptr);
+      weight += current_edge->weight;
+    }
+    return weight;
+  }
+
   void testBellmanFord() {
     std::cout << "\nTesting Bellman-Ford's algorithm..." << std::endl;
 
@@ -38,6 +59,11 @@ namespace graph_test {
       graph_utilities::printContainer(expected_came_from);
     }
 
+    // the queue-based implementation gives the same result
+    auto path_queue = bellmanFordQueue(graph, src);
+    assert(path_queue.first == expected_cost);
+    assert(findNegativeCycle(graph).empty());
+
     graph.connect(3, 0, 2);
     try
     {
@@ -45,11 +71,29 @@ namespace graph_test {
       std::cerr << "Failed to detect negative cycle!" << std::endl;
       exit (EXIT_FAILURE);
     }
-    catch (const std::exception& ia)
+    catch (const NegativeCycleError& ia)
     {
 //      std::cout << ia.what() << "\n";
+      assert(cycleWeight(graph, ia.cycle()) < 0);
       std::cout << "Passed!" << std::endl;
     }
+
+    try
+    {
+      bellmanFordQueue(graph, src);
+      std::cerr << "Failed to detect negative cycle!" << std::endl;
+      exit (EXIT_FAILURE);
+    }
+    catch (const NegativeCycleError& ia)
+    {
+      assert(cycleWeight(graph, ia.cycle()) < 0);
+      std::cout << "Passed!" << std::endl;
+    }
+
+    // 0 -> 1 -> 3 -> 0 is the only negative cycle
+    std::deque<size_t> cycle = findNegativeCycle(graph);
+    assert(cycle.size() == 3 && cycleWeight(graph, cycle) == -3);
+    std::cout << "Passed!" << std::endl;
   }
 
 }
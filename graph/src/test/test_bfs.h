@@ -42,6 +42,17 @@ namespace graph_test {
       std::cout << "The correct result is: " << std::endl;
       graph_utilities::printContainer(expected_result_ud);
     }
+
+    // test the hop distances
+    const size_t inf = kUnreachedDistance;
+    std::vector<size_t> expected_distance {0, 2, 4, 1, 3, 5, 2, 3, 6, inf, inf, inf};
+    std::vector<size_t> expected_distance_ud {0, 1, 1, 1, 2, 3, 3, 2};
+    if ( bfsDistance(graph, 0) == expected_distance &&
+         bfsDistance(ud_graph, 0) == expected_distance_ud ) {
+      std::cout << "Passed!" << std::endl;
+    } else {
+      std::cout << "Failed!!!" << std::endl;
+    }
   }
 
 }  // namespace graph_test
@@ -0,0 +1,69 @@
+#ifndef GRAPH_TEST_BORUVKA_H
+#define GRAPH_TEST_BORUVKA_H
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "unittest_graph.h"
+#include "../graph_algorithms/boruvka.h"
+#include "../graph_algorithms/kruskal.h"
+
+
+namespace graph_test {
+
+  void testBoruvka() {
+    std::cout << "\nTesting Boruvka's algorithm..." << std::endl;
+
+    auto graph = graph_test::negativeWeightedUdGraph();
+
+    typedef std::pair<int, std::vector<std::pair<size_t, size_t>>> mst_tree;
+
+    mst_tree mst = boruvka(graph);
+    mst_tree expected_mst = kruskal(graph);
+    if (mst != expected_mst) {
+      std::cout << "Failed!!!" << std::endl;
+      std::cout << "The output is: (total cost = "
+                << mst.first << ")" << std::endl;
+      graph_utilities::printContainer(mst.second);
+      std::cout << "The correct result is: (total cost = "
+                << expected_mst.first << ")" << std::endl;
+      graph_utilities::printContainer(expected_mst.second);
+      return;
+    }
+
+    // a larger random graph with many equal weights
+    const size_t n = 2000;
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<size_t> vertex(0, n - 1);
+    std::uniform_int_distribution<int> weight(-5, 5);
+    UndirectedGraph<int> random_graph(n);
+    for (size_t v = 1; v < n; ++v) { random_graph.connect(v - 1, v, weight(generator)); }
+    for (size_t e = 0; e < 10*n; ++e) {
+      random_graph.connect(vertex(generator), vertex(generator), weight(generator));
+    }
+
+    expected_mst = kruskal(random_graph);
+    for (size_t n_threads : {1, 4}) {
+      if (boruvka(random_graph, n_threads) != expected_mst) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    // two components
+    UndirectedGraph<int> disconnected(4);
+    disconnected.connect(0, 1, 1);
+    disconnected.connect(2, 3, 1);
+    try {
+      boruvka(disconnected);
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    } catch (std::invalid_argument&) {}
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}
+
+#endif //GRAPH_TEST_BORUVKA_H
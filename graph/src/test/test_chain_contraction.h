@@ -0,0 +1,165 @@
+#ifndef GRAPH_TEST_CHAIN_CONTRACTION_H
+#define GRAPH_TEST_CHAIN_CONTRACTION_H
+
+#include <random>
+#include <vector>
+
+#include "test_graph_generators.h"
+#include "../graph_generators.h"
+#include "../graph_algorithms/chain_contraction.h"
+#include "../graph_algorithms/dijkstra.h"
+#include "../graph_algorithms/bellman_ford.h"
+
+
+namespace graph_test {
+
+  // the costs agree with the ones of the original graph, and each path
+  // follows the edges of the graph with the cost of its end
+  template <class T>
+  bool sameShortestPaths(const DirectedGraph<T>& graph,
+                         const std::pair<std::deque<T>, std::deque<size_t>>& expected,
+                         const std::pair<std::deque<T>, std::deque<size_t>>& contracted,
+                         size_t src) {
+    for (size_t v = 0; v < graph.size(); ++v) {
+      if (contracted.first[v] != expected.first[v]) { return false; }
+      if (v == src || contracted.first[v] >= ChainContraction<T>::infinity()) { continue; }
+
+      std::deque<size_t> path = reconstructPath(contracted.second, src, v);
+      if (path.front() != src || path.back() != v) { return false; }
+      T cost = 0;
+      for (size_t i = 0; i + 1 < path.size(); ++i) {
+        bool found = false;
+        T weight = 0;
+        for (graph::Edge<T>* e = graph.getList(path[i]); e != nullptr; e = e->next) {
+          if (e->dst == path[i + 1] && (!found || e->weight < weight)) {
+            found = true;
+            weight = e->weight;
+          }
+        }
+        if (!found) { return false; }
+        cost += weight;
+      }
+      if (cost != contracted.first[v]) { return false; }
+    }
+    return true;
+  }
+
+  void testChainContraction() {
+    std::cout << "\nTesting chain contraction..." << std::endl;
+
+    // a triangle 0-1-2, the chain 1-3-4-2, the one-way chain 0 -> 5 -> 2
+    // and the tree 6-7, 6-8 hanging from 4
+    DirectedGraph<long> small(9);
+    for (auto e : std::vector<std::vector<long>>{{0, 1, 4}, {1, 2, 4}, {2, 0, 4}, {1, 3, 1},
+                                                 {3, 4, 1}, {4, 2, 1}, {0, 5, 1}, {5, 2, 1},
+                                                 {4, 6, 2}, {6, 7, 3}, {6, 8, 5}}) {
+      small.connectNew(e[0], e[1], e[2]);
+      if (e[0] != 0 && e[0] != 5) { small.connectNew(e[1], e[0], e[2] + 1); }
+    }
+    small.connectNew(1, 0, 4);
+    small.connectNew(2, 1, 4);
+    ChainContraction<long> contraction(small);
+    if (contraction.core().size() != 3 || contraction.countChain() != 2 ||
+        contraction.countTreeVertex() != 3 || contraction.isCore(3) || !contraction.isCore(2) ||
+        contraction.coreVertex(contraction.coreId(2)) != 2) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+    for (size_t src = 0; src < small.size(); ++src) {
+      if (!sameShortestPaths(small, dijkstra(small, src), dijkstra(contraction, src), src)) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    // a sparse grid with one-way roads, and long roads through many
+    // shape points
+    std::uniform_int_distribution<long> weight(1, 100);
+    std::mt19937_64 engine(3);
+    auto grid = graph_generator::grid(40, 40, weight, 3, 0.6);
+    GeneratedGraph<long> roads {grid.size, true, {}};
+    for (const auto& e : grid.edges) {
+      size_t direction = engine()%4;
+      if (direction != 1) { roads.edges.push_back({e.weight, e.src, e.dst}); }
+      if (direction != 2) { roads.edges.push_back({weight(engine), e.dst, e.src}); }
+    }
+    auto graph = graph_generator::toDirectedGraph(roads);
+    ChainContraction<long> contracted(graph);
+    if (contracted.core().size() >= graph.size()/2) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+    for (size_t src = 0; src < graph.size(); src += 37) {
+      if (!sameShortestPaths(graph, dijkstra(graph, src), dijkstra(contracted, src), src)) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    // negative weights (reweighted by potentials, so without negative
+    // cycles) for Bellman-Ford
+    std::vector<long> potentials(graph.size());
+    for (auto& p : potentials) { p = weight(engine); }
+    DirectedGraph<long> reweighted(graph.size());
+    for (const auto& e : roads.edges) {
+      reweighted.connectNew(e.src, e.dst, e.weight + potentials[e.src] - potentials[e.dst]);
+    }
+    ChainContraction<long> reweighted_contracted(reweighted);
+    for (size_t src = 0; src < graph.size(); src += 101) {
+      if (!sameShortestPaths(reweighted, bellmanFord(reweighted, src),
+                             bellmanFord(reweighted_contracted, src), src)) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    // the shape points keep the distances between the old vertices
+    auto subdivided = grid;
+    size_t n_added = graph_generator::subdivideEdges(subdivided, 6, 4);
+    auto subdivided_graph = graph_generator::toDirectedGraph(subdivided);
+    auto grid_graph = graph_generator::toDirectedGraph(grid);
+    ChainContraction<long> subdivided_contracted(subdivided_graph);
+    auto expected = dijkstra(grid_graph, 0);
+    auto costs = dijkstra(subdivided_contracted, 0);
+    if (!isSimpleGraph(subdivided) || subdivided.size != grid.size + n_added ||
+        subdivided_contracted.core().size() > grid.size ||
+        !std::equal(expected.first.begin(), expected.first.end(), costs.first.begin()) ||
+        !sameShortestPaths(subdivided_graph, dijkstra(subdivided_graph, 0), costs, 0)) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // a cycle keeps one vertex in the core, a tree only its root, and a
+    // negative pair of edges cannot be contracted
+    DirectedGraph<long> cycle(5);
+    DirectedGraph<long> tree(5);
+    for (size_t v = 0; v < 5; ++v) {
+      cycle.connectNew(v, (v + 1)%5, (long)v + 1);
+      if (v > 0) { tree.connectNew((v - 1)/2, v, (long)v); }
+    }
+    ChainContraction<long> contracted_cycle(cycle);
+    ChainContraction<long> contracted_tree(tree);
+    if (contracted_cycle.core().size() != 1 || contracted_tree.core().size() != 1 ||
+        !sameShortestPaths(cycle, dijkstra(cycle, 3), dijkstra(contracted_cycle, 3), 3) ||
+        !sameShortestPaths(tree, dijkstra(tree, 1), dijkstra(contracted_tree, 1), 1)) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+    cycle.connectNew(2, 1, -3);
+    try {
+      ChainContraction<long> negative(cycle);
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    } catch (const NegativeCycleError& e) {
+      if (e.cycle().size() != 2) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}  // namespace graph_test
+
+#endif //GRAPH_TEST_CHAIN_CONTRACTION_H
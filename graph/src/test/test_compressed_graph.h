@@ -0,0 +1,173 @@
+#ifndef GRAPH_TEST_COMPRESSED_GRAPH_H
+#define GRAPH_TEST_COMPRESSED_GRAPH_H
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "unittest_graph.h"
+#include "../compressed_graph.h"
+#include "../graph_generators.h"
+#include "../graph_algorithms/breath_first_search.h"
+#include "../graph_algorithms/depth_first_search.h"
+#include "../graph_algorithms/kosaraju.h"
+
+
+namespace graph_test {
+
+  // the components with their vertices in ascending order, in
+  // ascending order
+  std::vector<std::vector<size_t>> sortedComponents(const std::deque<std::deque<size_t>>& scc) {
+    std::vector<std::vector<size_t>> components;
+    for (const auto& component : scc) {
+      components.emplace_back(component.begin(), component.end());
+      std::sort(components.back().begin(), components.back().end());
+    }
+    std::sort(components.begin(), components.end());
+    return components;
+  }
+
+  // the compressed lists hold the same neighbors as the linked lists
+  template <class T>
+  bool sameNeighbors(const Graph<T>& graph, const CompressedGraph& compressed) {
+    if (graph.size() != compressed.size()) { return false; }
+    std::vector<uint32_t> scalar;
+    for (size_t u = 0; u < graph.size(); ++u) {
+      std::vector<uint32_t> expected;
+      for (graph::Edge<T>* e = graph.getList(u); e != nullptr; e = e->next) {
+        expected.push_back((uint32_t)e->dst);
+      }
+      std::sort(expected.begin(), expected.end());
+      scalar.assign(expected.size(), 0);
+      if (!expected.empty()) { compressed.decodeNeighbors(u, &scalar[0], false); }
+      if (compressed.neighbors(u) != expected || scalar != expected ||
+          compressed.degree(u) != expected.size()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void testCompressedGraph() {
+    std::cout << "\nTesting compressed graph..." << std::endl;
+
+    // the codecs, with values of all the lengths and partial groups
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<unsigned> bits(0, 32);
+    for (size_t n = 0; n < 40; ++n) {
+      std::vector<uint32_t> gaps(n);
+      for (auto& gap : gaps) { gap = (uint32_t)(generator() & ((1ull << bits(generator)) - 1)); }
+      std::vector<uint8_t> bytes(graph_codec::maxStreamVByteBytes(n) + graph_codec::kDecodePadding);
+      size_t n_bytes = graph_codec::encodeStreamVByte(gaps.data(), n, bytes.data());
+
+      std::vector<uint32_t> expected(n);
+      uint32_t value = 7;
+      for (size_t i = 0; i < n; ++i) { expected[i] = value += gaps[i]; }
+      std::vector<uint32_t> scalar(n + 1), fast(n + 1);
+      if (graph_codec::decodeDeltaScalar(bytes.data(), n, 7, scalar.data()) != bytes.data() + n_bytes ||
+          graph_codec::decodeDelta(bytes.data(), n, 7, fast.data()) != bytes.data() + n_bytes ||
+          !std::equal(expected.begin(), expected.end(), scalar.begin()) ||
+          !std::equal(expected.begin(), expected.end(), fast.begin())) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+    for (uint64_t value : {0ull, 127ull, 128ull, 300ull, 1ull << 35}) {
+      uint8_t bytes[10];
+      uint64_t decoded = 0;
+      size_t n_bytes = graph_codec::encodeVarint(value, bytes);
+      if (graph_codec::decodeVarint(bytes, decoded) != bytes + n_bytes || decoded != value) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    // the searches find the same vertices as on the linked lists
+    auto graph = graph_test::simpleGraph();
+    CompressedGraph compressed(graph);
+    std::vector<size_t> bfs = breathFirstSearch(compressed, 0);
+    std::vector<size_t> expected_bfs = breathFirstSearch(graph, 0);
+    std::sort(bfs.begin(), bfs.end());
+    std::sort(expected_bfs.begin(), expected_bfs.end());
+    std::vector<size_t> dfs = depthFirstSearch(compressed, 0);
+    std::vector<size_t> expected_dfs = depthFirstSearch(graph, 0);
+    std::sort(dfs.begin(), dfs.end());
+    std::sort(expected_dfs.begin(), expected_dfs.end());
+    if (!sameNeighbors(graph, compressed) || compressed.countEdge() != graph.countEdge() ||
+        bfs != expected_bfs || dfs != expected_dfs ||
+        bfsDistance(compressed, 0) != bfsDistance(graph, 0) ||
+        sortedComponents(kosaraju(compressed)) != sortedComponents(kosaraju(graph))) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // a large generated graph, compressed from the edges, from the
+    // linked lists, reversed and mapped from a file
+    std::uniform_int_distribution<long> weight(1, 100);
+    auto generated = graph_generator::rmat(14, 100000, weight, 5, true);
+    auto directed = graph_generator::toDirectedGraph(generated);
+    CompressedGraph from_edges(generated.size, generated.edges, true);
+    CompressedGraph from_graph(directed);
+    const std::string path = "compressed_graph_test.bin";
+    from_edges.save(path);
+    CompressedGraph loaded = CompressedGraph::open(path);
+    CompressedGraph twice = from_edges.reversed().reversed();
+    // many passes, some of which hold a single vertex of a large in-degree
+    CompressedGraph twice_in_passes = from_edges.reversed(100).reversed(7);
+    if (!sameNeighbors(directed, from_edges) || !sameNeighbors(directed, from_graph) ||
+        !sameNeighbors(directed, loaded) || !sameNeighbors(directed, twice) ||
+        !sameNeighbors(directed, twice_in_passes) ||
+        from_edges.countEdge() != generated.edges.size() ||
+        loaded.bytes() != from_edges.bytes() || from_edges.bytes() >= 4*generated.edges.size()) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+    std::remove(path.c_str());
+
+    for (size_t src : {0, 1000, 16383}) {
+      if (bfsDistance(loaded, src) != bfsDistance(directed, src)) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+    if (sortedComponents(kosaraju(loaded)) != sortedComponents(kosaraju(directed))) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // a deep DFS along a path, whose vertices have a few more neighbors
+    // each, in the same order as the DFS on the linked lists
+    const size_t n_path = 100000;
+    DirectedGraph<long> chain(n_path);
+    for (size_t v = 0; v < n_path; ++v) {
+      // prepended in descending order, so the lists are sorted as the
+      // compressed ones
+      std::vector<size_t> targets {(v + 2)%n_path, (v + 3)%n_path, (v + 7)%n_path};
+      if (v + 1 < n_path) { targets.push_back(v + 1); }
+      std::sort(targets.rbegin(), targets.rend());
+      for (size_t dst : targets) { chain.connectNew(v, dst, 1); }
+    }
+    CompressedGraph compressed_chain(chain);
+    if (depthFirstSearch(compressed_chain, 0) != depthFirstSearch(chain, 0) ||
+        sortedComponents(kosaraju(compressed_chain)) != sortedComponents(kosaraju(chain))) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // an undirected edge is stored in both directions
+    auto grid = graph_generator::grid(30, 30, weight, 6);
+    CompressedGraph compressed_grid(grid.size, grid.edges, false);
+    if (!sameNeighbors(graph_generator::toUndirectedGraph(grid), compressed_grid) ||
+        compressed_grid.countEdge() != 2*grid.edges.size()) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}  // namespace graph_test
+
+#endif //GRAPH_TEST_COMPRESSED_GRAPH_H
@@ -7,6 +7,8 @@
 
 #include <iostream>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 #include "unittest_graph.h"
 #include "../graph_algorithms/dijkstra.h"
@@ -131,6 +133,81 @@ namespace graph_test {
     }
   }
 
+  void testDijkstraWorkspace() {
+    auto graph = graph_test::distanceGraph();
+    SearchWorkspace<unsigned int> workspace;
+
+    // a short query followed by full searches from every source should
+    // give the same result as using fresh containers for each search
+    bool passed = dijkstra(graph, 0, 1, workspace) && workspace.cost(1) == 1;
+    for (size_t src = 0; src < graph.size(); ++src) {
+      dijkstra(graph, src, workspace);
+      auto path = dijkstra(graph, src);
+      for (size_t v = 0; v < graph.size(); ++v) {
+        if (workspace.cost(v) != path.first[v]) { passed = false; }
+        if (workspace.reached(v) && workspace.cameFrom(v) != path.second[v]) {
+          passed = false;
+        }
+      }
+    }
+
+    // the last source (6) is isolated
+    if (workspace.touched().size() != 1) { passed = false; }
+
+    if (passed) {
+      std::cout << "Passed!" << std::endl;
+    } else {
+      std::cout << "Failed!!!" << std::endl;
+    }
+  }
+
+  void testDijkstraNearestTargets() {
+    auto graph = graph_test::distanceGraph();
+    SearchWorkspace<unsigned int> workspace;
+    typedef std::vector<std::pair<size_t, unsigned int>> sparse_costs;
+
+    // the isolated vertex 6 is never found
+    std::vector<size_t> targets {5, 3, 6, 4, 3};
+    bool passed =
+        dijkstraNearestTargets(graph, 0, targets, 2, workspace) ==
+            sparse_costs({{4, 5}, {3, 6}}) &&
+        dijkstraNearestTargets(graph, 0, targets, 10, workspace) ==
+            sparse_costs({{4, 5}, {3, 6}, {5, 7}}) &&
+        dijkstraNearestTargets(graph, 0, targets, 0).empty();
+
+    // the search stops at the nearest target
+    dijkstraNearestTargets(graph, 0, {1}, 1, workspace);
+    if (workspace.settled().size() != 2) { passed = false; }
+
+    if (passed) {
+      std::cout << "Passed!" << std::endl;
+    } else {
+      std::cout << "Failed!!!" << std::endl;
+    }
+  }
+
+  void testDijkstraWithinRadius() {
+    auto graph = graph_test::distanceGraph();
+    SearchWorkspace<unsigned int> workspace;
+    typedef std::vector<std::pair<size_t, unsigned int>> sparse_costs;
+
+    bool passed =
+        dijkstraWithinRadius(graph, 0, 4u, workspace) ==
+            sparse_costs({{0, 0}, {1, 1}, {2, 3}}) &&
+        dijkstraWithinRadius(graph, 2, 0u) == sparse_costs({{2, 0}}) &&
+        dijkstraWithinRadius(graph, 0, 100u).size() == 6;
+
+    // only the first vertex beyond the radius is settled
+    dijkstraWithinRadius(graph, 0, 3u, workspace);
+    if (workspace.settled().size() != 4) { passed = false; }
+
+    if (passed) {
+      std::cout << "Passed!" << std::endl;
+    } else {
+      std::cout << "Failed!!!" << std::endl;
+    }
+  }
+
   void testDijkstra() {
     std::cout << "\nTesting Dijkstra's algorithm..." << std::endl;
 
@@ -139,6 +216,9 @@ namespace graph_test {
     testDijkstraUnDirectedGraph();
     testDijkstraOriginalDirectedGraph();
     testDijkstraTreeBasedDirectedGraph();
+    testDijkstraWorkspace();
+    testDijkstraNearestTargets();
+    testDijkstraWithinRadius();
   }
 
 } // namespace graph_test
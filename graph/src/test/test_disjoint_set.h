@@ -0,0 +1,58 @@
+#ifndef GRAPH_TEST_DISJOINT_SET_H
+#define GRAPH_TEST_DISJOINT_SET_H
+
+#include <cassert>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../disjoint_set.h"
+#include "../parallel.h"
+
+
+namespace graph_test {
+
+  void testDisjointSet() {
+    std::cout << "\nTesting disjoint sets..." << std::endl;
+
+    DisjointSet sets(5);
+    assert(sets.countSets() == 5);
+    assert(sets.unite(0, 1) && sets.unite(3, 4) && sets.unite(1, 4));
+    assert(!sets.unite(0, 3));
+    assert(sets.sameSet(0, 4) && !sets.sameSet(2, 4));
+    assert(sets.countSets() == 2);
+
+    // random unions, checked against a naive labelling
+    const size_t n = 1000;
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<size_t> element(0, n - 1);
+    std::vector<std::pair<size_t, size_t>> pairs(800);
+    for (auto& p : pairs) { p = std::make_pair(element(generator), element(generator)); }
+
+    std::vector<size_t> labels(n);
+    for (size_t i = 0; i < n; ++i) { labels[i] = i; }
+    sets.reset(n);
+    for (const auto& p : pairs) {
+      size_t from = labels[p.first], to = labels[p.second];
+      assert(sets.unite(p.first, p.second) == (from != to));
+      for (auto& label : labels) { if (label == from) { label = to; } }
+    }
+
+    // the same unions made concurrently
+    ConcurrentDisjointSet concurrent_sets(n);
+    graph_parallel::parallelFor(pairs.size(), 4, [&](size_t, size_t k) {
+      concurrent_sets.unite(pairs[k].first, pairs[k].second);
+    });
+
+    for (size_t k = 0; k < 5000; ++k) {
+      size_t u = element(generator), v = element(generator);
+      assert(sets.sameSet(u, v) == (labels[u] == labels[v]));
+      assert(concurrent_sets.sameSet(u, v) == (labels[u] == labels[v]));
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}
+
+#endif //GRAPH_TEST_DISJOINT_SET_H
@@ -0,0 +1,103 @@
+#ifndef GRAPH_TEST_DYNAMIC_SHORTEST_PATH_H
+#define GRAPH_TEST_DYNAMIC_SHORTEST_PATH_H
+
+#include <cassert>
+#include <random>
+
+#include "unittest_graph.h"
+#include "../graph_algorithms/dijkstra.h"
+#include "../graph_algorithms/dynamic_shortest_path.h"
+
+
+namespace graph_test {
+
+  //
+  // check the costs and the shortest path tree against a search from
+  // scratch
+  //
+  template <class T>
+  bool checkDynamicShortestPath(const DirectedGraph<T>& graph,
+                                const DynamicShortestPath<T>& dynamic) {
+    auto expected = dijkstra(graph, dynamic.source());
+    for (size_t v = 0; v < graph.size(); ++v) {
+      if (dynamic.cost(v) != expected.first[v]) { return false; }
+      if (!dynamic.reached(v)) { continue; }
+
+      // each tree edge must lead to the cost of the vertex
+      size_t u = dynamic.cameFrom(v);
+      if (v == dynamic.source()) {
+        if (u != v) { return false; }
+        continue;
+      }
+      graph::Edge<T>* edge = graph.getList(u);
+      while (edge != nullptr && edge->dst != v) { edge = edge->next; }
+      if (edge == nullptr || dynamic.cost(u) + edge->weight != dynamic.cost(v)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void testDynamicShortestPath() {
+    std::cout << "\nTesting dynamic shortest path..." << std::endl;
+
+    auto graph = graph_test::distanceGraph();
+    DynamicShortestPath<unsigned int> dynamic(graph, 0);
+    assert(dynamic.cost(5) == 7);
+    assert((dynamic.path(5) == std::deque<size_t>{0, 1, 2, 4, 5}));
+    assert(dynamic.path(6).empty());
+
+    // a tree edge becomes longer
+    assert(dynamic.updateWeight(1, 2, 10));
+    assert(dynamic.cost(5) == 8);
+    assert((dynamic.path(5) == std::deque<size_t>{0, 2, 4, 5}));
+    // a shortcut to the isolated vertex
+    assert(dynamic.insertEdge(4, 6, 1));
+    assert(dynamic.cost(6) == 7 && dynamic.countAffected() == 1);
+    // a non-tree edge does not affect any vertex
+    assert(dynamic.deleteEdge(3, 4) == 3);
+    assert(dynamic.countAffected() == 0);
+    // a tree edge is removed and the subtree is reached through 1
+    assert(dynamic.deleteEdge(0, 2) == 4);
+    assert(dynamic.cost(2) == 11 && dynamic.cost(6) == 14);
+    // the last edge to 2 is removed
+    assert(dynamic.deleteEdge(1, 2) == 10);
+    assert(!dynamic.reached(2) && !dynamic.reached(6) && dynamic.cost(3) == 7);
+    assert(checkDynamicShortestPath(graph, dynamic));
+
+    // random updates of a random graph
+    const size_t n = 60;
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<size_t> vertex(0, n - 1);
+    std::uniform_int_distribution<int> weight(0, 20);
+    std::uniform_int_distribution<int> operation(0, 3);
+
+    DirectedGraph<int> random_graph(n);
+    for (size_t e = 0; e < 3*n; ++e) {
+      random_graph.connect(vertex(generator), vertex(generator), weight(generator));
+    }
+
+    DynamicShortestPath<int> random_dynamic(random_graph, 0);
+    assert(checkDynamicShortestPath(random_graph, random_dynamic));
+    for (size_t update = 0; update < 500; ++update) {
+      size_t src = vertex(generator);
+      size_t dst = vertex(generator);
+      switch (operation(generator)) {
+        case 0: random_dynamic.insertEdge(src, dst, weight(generator)); break;
+        case 1: random_dynamic.deleteEdge(src, dst); break;
+        default: random_dynamic.updateWeight(src, dst, weight(generator));
+      }
+      // update the existing edges more often
+      graph::Edge<int>* edge = random_graph.getList(src);
+      if (edge != nullptr) {
+        random_dynamic.updateWeight(src, edge->dst, weight(generator));
+      }
+      assert(checkDynamicShortestPath(random_graph, random_dynamic));
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}
+
+#endif //GRAPH_TEST_DYNAMIC_SHORTEST_PATH_H
@@ -5,8 +5,11 @@
 #ifndef GRAPH_TEST_FLOYD_WARSHALL_H
 #define GRAPH_TEST_FLOYD_WARSHALL_H
 
+#include <vector>
+
 #include "unittest_graph.h"
 #include "../graph_algorithms/floyd_warshall.h"
+#include "../graph_algorithms/johnson.h"
 
 
 namespace graph_test {
@@ -37,6 +40,36 @@ namespace graph_test {
     std::cout << "Passed!" << std::endl;
   }
 
+  void testFloydWarshallBlocked() {
+    std::cout << "\nTesting blocked Floyd-Warshall's algorithm..." << std::endl;
+
+    const size_t n = 50;
+    DirectedGraph<int> graph = randomNegativeWeightedGraph(n, 4*n);
+
+    auto expected = johnson(graph);
+    // tiles that do not divide V, one to several threads
+    for (size_t block_size : {1, 7, 16, 64}) {
+      for (size_t n_threads : {1, 3}) {
+        std::vector<int> costs = floydWarshallBlocked(graph, n_threads, block_size);
+        for (size_t i = 0; i < n; ++i) {
+          for (size_t j = 0; j < n; ++j) {
+            assert(costs[i*n + j] == expected.first[i][j]);
+          }
+        }
+      }
+    }
+
+    graph.connect(0, 1, -100);
+    graph.connect(1, 0, -100);
+    try {
+      floydWarshallBlocked(graph, 2, 7);
+      std::cerr << "Failed to detect negative cycle!" << std::endl;
+      exit (EXIT_FAILURE);
+    } catch (const std::invalid_argument&) {
+      std::cout << "Passed!" << std::endl;
+    }
+  }
+
 }
 
 #endif //GRAPH_TEST_FLOYD_WARSHALL_H
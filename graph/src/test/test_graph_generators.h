@@ -0,0 +1,137 @@
+#ifndef GRAPH_TEST_GRAPH_GENERATORS_H
+#define GRAPH_TEST_GRAPH_GENERATORS_H
+
+#include <cstdio>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../graph_generators.h"
+#include "../graph_algorithms/breath_first_search.h"
+
+
+namespace graph_test {
+
+  // no self-loop, no duplicate, vertices in range and src < dst if
+  // undirected
+  template <class T>
+  bool isSimpleGraph(const GeneratedGraph<T>& graph) {
+    std::set<std::pair<uint32_t, uint32_t>> pairs;
+    for (const auto& e : graph.edges) {
+      if (e.src == e.dst || e.src >= graph.size || e.dst >= graph.size) { return false; }
+      if (!graph.directed && e.src > e.dst) { return false; }
+      if (!pairs.insert(std::make_pair(e.src, e.dst)).second) { return false; }
+    }
+    return true;
+  }
+
+  template <class T>
+  bool sameEdges(const GeneratedGraph<T>& g1, const GeneratedGraph<T>& g2) {
+    if (g1.size != g2.size || g1.directed != g2.directed ||
+        g1.edges.size() != g2.edges.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < g1.edges.size(); ++i) {
+      if (g1.edges[i].src != g2.edges[i].src || g1.edges[i].dst != g2.edges[i].dst ||
+          g1.edges[i].weight != g2.edges[i].weight) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void testGraphGenerators() {
+    std::cout << "\nTesting graph generators..." << std::endl;
+
+    std::uniform_int_distribution<long> weight(1, 100);
+
+    // the same seed gives the same graph for any No. of threads
+    auto rmat1 = graph_generator::rmat(12, 40000, weight, 7, false, 1);
+    auto rmat4 = graph_generator::rmat(12, 40000, weight, 7, false, 4);
+    auto rmat_directed = graph_generator::rmat(12, 40000, weight, 7, true, 2);
+    if (!sameEdges(rmat1, rmat4) || !isSimpleGraph(rmat1) || !isSimpleGraph(rmat_directed) ||
+        rmat1.size != 4096 || rmat1.edges.size() < 20000 || rmat1.edges.size() >= 40000) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // about p*n(n - 1)/2 edges
+    auto er1 = graph_generator::erdosRenyi(200000, 1e-4, weight, 3, false, 1);
+    auto er3 = graph_generator::erdosRenyi(200000, 1e-4, weight, 3, false, 3);
+    auto er_directed = graph_generator::erdosRenyi(1000, 0.01, weight, 3, true);
+    auto complete = graph_generator::erdosRenyi(50, 1.0, weight, 3, true);
+    if (!sameEdges(er1, er3) || !isSimpleGraph(er1) || !isSimpleGraph(er_directed) ||
+        er1.edges.size() < 1990000 || er1.edges.size() > 2010000 ||
+        er_directed.edges.size() < 9000 || er_directed.edges.size() > 11000 ||
+        complete.edges.size() != 50*49 || !isSimpleGraph(complete)) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // all the edges of a full grid, and about half of them at keep = 0.5
+    auto full_grid = graph_generator::grid(300, 500, weight, 5);
+    auto half_grid = graph_generator::grid(300, 500, weight, 5, 0.5, 2);
+    const size_t n_grid_edges = 300*499 + 299*500;
+    if (!isSimpleGraph(full_grid) || full_grid.edges.size() != n_grid_edges ||
+        half_grid.edges.size() < 0.48*n_grid_edges || half_grid.edges.size() > 0.52*n_grid_edges) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+    for (const auto& e : full_grid.edges) {
+      if (e.dst != e.src + 1 && e.dst != e.src + 500) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    // about pi*r^2*n^2/2 edges (less at the border)
+    auto geometric1 = graph_generator::randomGeometric(20000, 0.01, weight, 9, 1);
+    auto geometric2 = graph_generator::randomGeometric(20000, 0.01, weight, 9, 2);
+    if (!sameEdges(geometric1, geometric2) || !isSimpleGraph(geometric1) ||
+        geometric1.edges.size() < 0.9*62832 || geometric1.edges.size() > 1.05*62832) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // connect the components and load into the graphs
+    auto sparse = graph_generator::erdosRenyi(5000, 1e-4, weight, 1);
+    size_t n_added = graph_generator::connectComponents(sparse, weight, 1);
+    UndirectedGraph<long> undirected = graph_generator::toUndirectedGraph(sparse);
+    DirectedGraph<long> directed = graph_generator::toDirectedGraph(sparse);
+    if (n_added == 0 || !isSimpleGraph(sparse) ||
+        undirected.countEdge() != sparse.edges.size() ||
+        directed.countEdge() != 2*sparse.edges.size() ||
+        breathFirstSearch(undirected, 0).size() != 5000 ||
+        breathFirstSearch(directed, 4999).size() != 5000) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+    try {
+      graph_generator::toUndirectedGraph(rmat_directed);
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    } catch (const std::invalid_argument&) {}
+
+    // round trip of a snapshot
+    const std::string path = "test_graph_generators.bin";
+    graph_generator::saveSnapshot(rmat_directed, path);
+    auto loaded = graph_generator::loadSnapshot<long>(path);
+    bool rejected = false;
+    try {
+      graph_generator::loadSnapshot<int>(path);
+    } catch (const std::invalid_argument&) {
+      rejected = true;
+    }
+    std::remove(path.c_str());
+    if (!sameEdges(loaded, rmat_directed) || !rejected) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}  // namespace graph_test
+
+#endif //GRAPH_TEST_GRAPH_GENERATORS_H
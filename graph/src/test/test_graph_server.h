@@ -0,0 +1,118 @@
+#ifndef GRAPH_TEST_GRAPH_SERVER_H
+#define GRAPH_TEST_GRAPH_SERVER_H
+
+#include <atomic>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../graph_server.h"
+#include "../graph_generators.h"
+#include "../benchmarks/benchmark_query_server.h"
+#include "../graph_algorithms/dijkstra.h"
+#include "../graph_algorithms/breath_first_search.h"
+
+
+namespace graph_test {
+
+  // the expected answer of a query, from the single source algorithms
+  std::string expectedAnswer(const DirectedGraph<long>& graph, const std::string& query) {
+    std::istringstream iss(query);
+    std::string command;
+    size_t u, v;
+    iss >> command >> u >> v;
+    if (command == "dist") {
+      SearchWorkspace<long> workspace(graph.size());
+      dijkstra(graph, u, workspace);
+      return workspace.reached(v) ? std::to_string(workspace.cost(v)) : "inf";
+    }
+    size_t hops = bfsDistance(graph, u)[v];
+    return hops == kUnreachedDistance ? "inf" : std::to_string(hops);
+  }
+
+  void testQueryServer() {
+    std::cout << "\nTesting query server..." << std::endl;
+
+    // two components: a random graph and a path 300 -> 301 -> ... -> 309
+    std::uniform_int_distribution<long> weight(1, 100);
+    auto generated = graph_generator::rmat(8, 1500, weight, 4, true);
+    generated.size = 310;
+    for (uint32_t v = 300; v + 1 < 310; ++v) { generated.edges.push_back({2, v, v + 1}); }
+    auto graph = graph_generator::toDirectedGraph(generated);
+
+    GraphQueryServer<long> server(graph, 2, 8);
+    if (server.answer("dist 300 309") != "18" || server.answer("dist 309 300") != "inf" ||
+        server.answer("hops 300 309") != "9" || server.answer("component 305") != "300" ||
+        server.answer("connected 300 0") != "0" || server.answer("connected 309 300") != "1" ||
+        server.answer("dist 0 310").compare(0, 6, "error ") != 0 ||
+        server.answer("hops 1").compare(0, 6, "error ") != 0 ||
+        server.answer("dist 1 2 3").compare(0, 6, "error ") != 0 ||
+        server.answer("route 1 2").compare(0, 6, "error ") != 0) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+    // each of them is a request and a batch, and the searches of the
+    // three valid ones which need one
+    QueryServerStats answered = server.stats();
+    if (answered.n_requests != 10 || answered.n_batches != 10 || answered.n_searches != 3) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // pipelined queries on concurrent connections are answered in order,
+    // where the queries of a batch share their sources
+    const std::string path = "graph_server_test.sock";
+    server.listen(path);
+    std::atomic<bool> passed(true);
+    std::atomic<size_t> n_answered(0);
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < 3; ++c) {
+      clients.emplace_back([&, c]() {
+        std::mt19937_64 engine(c);
+        std::vector<std::string> queries;
+        std::string text;
+        for (size_t i = 0; i < 200; ++i) {
+          queries.push_back(graph_benchmark::randomQuery(engine, 256, 4));
+          text += queries.back() + "\n";
+        }
+        int fd = graph_benchmark::connectSocket(path);
+        graph_server::writeAll(fd, true, text + "quit\n");
+
+        graph_benchmark::LineReader reader(fd);
+        std::string line;
+        for (const auto& query : queries) {
+          std::string command = query.substr(0, query.find(' '));
+          size_t u = std::stoul(query.substr(query.find(' ') + 1));
+          if (!reader.next(line) ||
+              ((command == "dist" || command == "hops") && line != expectedAnswer(graph, query)) ||
+              (command == "component" && line != server.answer("component " + std::to_string(u)))) {
+            passed = false;
+          }
+          if (command == "component") { ++n_answered; }
+        }
+        // the server closes the connection after "quit"
+        if (reader.next(line)) { passed = false; }
+        ::close(fd);
+      });
+    }
+    for (auto& client : clients) { client.join(); }
+
+    auto load = graph_benchmark::runLoadTest(path, graph.size(), 2, 100, 4);
+    server.stop();
+    QueryServerStats stats = server.stats();
+    if (!passed || load.n_requests != 200 || load.n_errors != 0 || stats.n_connections != 5 ||
+        stats.n_requests != 810 + n_answered || stats.n_batches == 0 ||
+        stats.n_batches > stats.n_requests ||
+        stats.n_searches > stats.n_requests) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}  // namespace graph_test
+
+#endif //GRAPH_TEST_GRAPH_SERVER_H
@@ -0,0 +1,82 @@
+#ifndef GRAPH_TEST_GRAPH_STATS_H
+#define GRAPH_TEST_GRAPH_STATS_H
+
+#include <random>
+#include <thread>
+
+#include "../graph_stats.h"
+#include "../graph_generators.h"
+#include "../graph_algorithms/dijkstra.h"
+#include "../graph_algorithms/bellman_ford.h"
+
+
+namespace graph_test {
+
+  bool isZero(const SearchStats& stats) {
+    return stats.relaxations == 0 && stats.updates == 0 && stats.pushes == 0 &&
+           stats.pops == 0 && stats.stale == 0 && stats.settled == 0 && stats.rounds == 0;
+  }
+
+  void testGraphStats() {
+    std::cout << "\nTesting search statistics..." << std::endl;
+
+    std::uniform_int_distribution<long> weight(1, 100);
+    auto graph = graph_generator::toDirectedGraph(graph_generator::rmat(10, 6000, weight, 3, true));
+    const size_t src = 1;
+
+    SearchWorkspace<long> workspace(graph.size());
+    SearchStats dijkstra_stats = graph_stats::collect([&]() { dijkstra(graph, src, workspace); });
+    SearchStats bf_stats = graph_stats::collect([&]() { bellmanFord(graph, src); });
+    SearchStats spfa_stats = graph_stats::collect([&]() { bellmanFordQueue(graph, src); });
+    SearchStats tree_stats = graph_stats::collect([&]() { dijkstraTreeBase(graph, src, src); });
+
+    // the counts of another thread are not collected
+    SearchStats other_stats = graph_stats::collect([&]() {
+      std::thread thread([&]() { dijkstra(graph, src); });
+      thread.join();
+    });
+
+    if (!graph_stats::kEnabled) {
+      if (!isZero(dijkstra_stats) || !isZero(bf_stats) || !isZero(spfa_stats) ||
+          !isZero(tree_stats)) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+      std::cout << "Passed!" << std::endl;
+      return;
+    }
+
+    // every settled vertex relaxes its out-edges once, every update is
+    // pushed, and every popped entry is either settled or stale
+    size_t n_out_edges = 0;
+    for (auto v : workspace.settled()) {
+      for (graph::Edge<long>* e = graph.getList(v); e != nullptr; e = e->next) { ++n_out_edges; }
+    }
+    if (dijkstra_stats.settled != workspace.settled().size() ||
+        dijkstra_stats.settled != workspace.touched().size() ||
+        dijkstra_stats.relaxations != n_out_edges ||
+        dijkstra_stats.pushes != dijkstra_stats.updates + 1 ||
+        dijkstra_stats.pops != dijkstra_stats.pushes ||
+        dijkstra_stats.pops != dijkstra_stats.settled + dijkstra_stats.stale ||
+        dijkstra_stats.rounds != 0 || !isZero(other_stats)) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // Bellman-Ford makes V - 1 rounds, while SPFA only scans the
+    // vertices whose cost changed
+    if (bf_stats.rounds != graph.size() - 1 || bf_stats.updates < dijkstra_stats.settled - 1 ||
+        spfa_stats.pushes != spfa_stats.pops || spfa_stats.rounds != 0 ||
+        spfa_stats.relaxations >= bf_stats.relaxations ||
+        tree_stats.settled != dijkstra_stats.settled ||
+        tree_stats.relaxations != dijkstra_stats.relaxations) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}  // namespace graph_test
+
+#endif //GRAPH_TEST_GRAPH_STATS_H
@@ -0,0 +1,78 @@
+#ifndef GRAPH_TEST_INCREMENTAL_MST_H
+#define GRAPH_TEST_INCREMENTAL_MST_H
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "unittest_graph.h"
+#include "../graph_algorithms/incremental_mst.h"
+#include "../graph_algorithms/kruskal.h"
+
+
+namespace graph_test {
+
+  void testIncrementalMinimumSpanningForest() {
+    std::cout << "\nTesting incremental minimum spanning forest..." << std::endl;
+
+    auto graph = graph_test::negativeWeightedUdGraph();
+    IncrementalMinimumSpanningForest<int> msf(graph);
+    if (msf.cost() != kruskal(graph).first || msf.countTrees() != 1) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // a stream of random edges with many equal weights in batches of
+    // different sizes, checked against the forest of all the edges so far
+    const size_t n = 300;
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<uint32_t> vertex(0, n - 1);
+    std::uniform_int_distribution<int> weight(-20, 20);
+
+    IncrementalMinimumSpanningForest<int> stream(n, 2);
+    std::vector<WeightedEdge<int>> all_edges;
+    for (size_t batch_size : {1, 1, 10, 50, 200, 1000, 3000}) {
+      std::vector<WeightedEdge<int>> batch;
+      for (size_t k = 0; k < batch_size; ++k) {
+        batch.push_back({weight(generator), vertex(generator), vertex(generator)});
+        const auto& e = batch.back();
+        if (e.src != e.dst) {
+          all_edges.push_back({e.weight, std::min(e.src, e.dst), std::max(e.src, e.dst)});
+        }
+      }
+      stream.insertEdges(batch);
+
+      std::sort(all_edges.begin(), all_edges.end());
+      DisjointSet unions(n);
+      std::vector<WeightedEdge<int>> forest;
+      int cost = 0;
+      for (const auto& e : all_edges) {
+        if (unions.unite(e.src, e.dst)) {
+          forest.push_back(e);
+          cost += e.weight;
+        }
+      }
+
+      bool same = stream.cost() == cost && stream.edges().size() == forest.size() &&
+                  stream.countTrees() == unions.countSets();
+      for (size_t k = 0; same && k < forest.size(); ++k) {
+        same = !(forest[k] < stream.edges()[k]) && !(stream.edges()[k] < forest[k]);
+      }
+      if (!same) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    // 4262 random edges connect 300 vertices
+    if (stream.countTrees() != 1 || !stream.connected(0, n - 1)) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}
+
+#endif //GRAPH_TEST_INCREMENTAL_MST_H
@@ -0,0 +1,69 @@
+#ifndef GRAPH_TEST_INDEXED_HEAP_H
+#define GRAPH_TEST_INDEXED_HEAP_H
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../indexed_heap.h"
+
+
+namespace graph_test {
+
+  void testIndexedHeap() {
+    std::cout << "\nTesting indexed heap..." << std::endl;
+
+    // push every id, lower half of the keys at random, and the ids must
+    // come out in the order of their final keys
+    const size_t n = 1000;
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> key(0, 1000000);
+    std::bernoulli_distribution lower(0.5);
+
+    IndexedMinHeap<int> heap(n);
+    std::vector<int> keys(n);
+    for (size_t id = 0; id < n; ++id) {
+      keys[id] = key(generator);
+      heap.push(id, keys[id]);
+    }
+    for (size_t id = 0; id < n; ++id) {
+      if (lower(generator)) {
+        keys[id] -= key(generator);
+        heap.decreaseKey(id, keys[id]);
+      }
+      // not lowered
+      if (heap.pushOrDecrease(id, keys[id] + 1)) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    std::vector<int> popped;
+    while (!heap.empty()) {
+      size_t id = heap.pop();
+      if (heap.contains(id) || heap.key(id) != keys[id]) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+      popped.push_back(keys[id]);
+    }
+
+    std::sort(keys.begin(), keys.end());
+    if (popped != keys) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // an id can be pushed again after it is popped
+    if (!heap.pushOrDecrease(0, 1) || heap.pop() != 0 || !heap.empty()) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}  // namespace graph_test
+
+#endif //GRAPH_TEST_INDEXED_HEAP_H
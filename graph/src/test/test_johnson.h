@@ -5,6 +5,8 @@
 #ifndef GRAPH_TEST_JOHNSON_H
 #define GRAPH_TEST_JOHNSON_H
 
+#include <cstdio>
+
 #include "unittest_graph.h"
 #include "../graph_algorithms/johnson.h"
 
@@ -36,6 +38,36 @@ void testJohnson() {
   std::cout << "Passed!" << std::endl;
 }
 
+void testJohnsonMultithreaded() {
+  std::cout << "\nTesting multithreaded Johnson's algorithm..." << std::endl;
+
+  const auto graph = graph_test::negativeWeightedGraph();
+  auto expected = johnson(graph, 1);
+
+  // the input graph is not modified
+  assert(graph.countEdge() == 10 && graph.countWeight() == 2);
+
+  auto result = johnson(graph, 4);
+  assert(result.first == expected.first);
+
+  // stream the rows to a memory-mapped file and read them back
+  std::string path = "johnson_test.bin";
+  johnsonToFile(graph, path, 3);
+  {
+    MappedFile file(path);
+    assert(file.size() == graph.size()*graph.size()*sizeof(int));
+    const int* costs = static_cast<const int*>(file.data());
+    for (size_t i=0; i<graph.size(); ++i) {
+      for (size_t j=0; j<graph.size(); ++j) {
+        assert(costs[i*graph.size() + j] == expected.first[i][j]);
+      }
+    }
+  }
+  std::remove(path.c_str());
+
+  std::cout << "Passed!" << std::endl;
+}
+
 }
 
 #endif //GRAPH_TEST_JOHNSON_H
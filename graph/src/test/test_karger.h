@@ -5,6 +5,8 @@
 #ifndef GRAPH_TEST_KARGER_H
 #define GRAPH_TEST_KARGER_H
 
+#include <random>
+
 #include "unittest_graph.h"
 #include "../graph_algorithms/karger.h"
 
@@ -19,13 +21,52 @@ namespace graph_test {
 
     size_t min_cut = karger(graph, 1000);
 
-    if (min_cut == 2) {
-      std::cout << "Passed!" << std::endl;
-    } else {
+    if (min_cut != 2) {
       std::cout << "Failed!!!" << std::endl;
       std::cout << "The output is " << min_cut << std::endl;
       std::cout << "The correct result is 2" << std::endl;
+      return;
+    }
+
+    // two random clusters of 30 vertices joined by 3 edges
+    const size_t n = 60;
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<size_t> vertex(0, n/2 - 1);
+    UndirectedGraph<int> clusters(n);
+    for (size_t e = 0; e < 300; ++e) {
+      size_t u = vertex(generator);
+      size_t v = vertex(generator);
+      clusters.connect(u, v);
+      clusters.connect(u + n/2, v + n/2);
+    }
+    for (size_t v = 0; v < n/2; ++v) {
+      clusters.connect(v, (v + 1)%(n/2));
+      clusters.connect(v + n/2, (v + 1)%(n/2) + n/2);
+    }
+    clusters.connect(0, n/2);
+    clusters.connect(1, n/2 + 1);
+    clusters.connect(2, n/2 + 2);
+
+    // the same seed gives the same result on any No. of threads
+    for (size_t n_threads : {1, 3}) {
+      if (karger(clusters, 2000, n_threads, 1) != 3 ||
+          kargerStein(clusters, 20, n_threads, 1) != 3 ||
+          kargerStein(graph, 10, n_threads, 1) != 2) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
     }
+
+    // disconnected
+    clusters.disconnect(0, n/2);
+    clusters.disconnect(1, n/2 + 1);
+    clusters.disconnect(2, n/2 + 2);
+    if (karger(clusters, 1) != 0 || kargerStein(clusters, 1) != 0) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
   }
 
 } // namespace graph_test
@@ -5,6 +5,10 @@
 #ifndef GRAPH_TEST_KRUSKAL_H
 #define GRAPH_TEST_KRUSKAL_H
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 #include "unittest_graph.h"
 #include "../graph_algorithms/kruskal.h"
 
@@ -20,11 +24,10 @@ namespace graph_test {
 
     // starting from an appointing vertex
     mst_tree mst = kruskal(graph);
-    mst_tree expected_mst = {-13, {{1, 3}, {4, 0}, {4, 3}, {4, 2}, {4, 5}}};
+    mst_tree expected_mst = {-13, {{1, 3}, {0, 4}, {3, 4}, {2, 4}, {4, 5}}};
 
-    if (mst == expected_mst) {
-      std::cout << "Passed!" << std::endl;
-    } else {
+    // each edge is reported as <smaller vertex, larger vertex>
+    if (mst != expected_mst || filterKruskal(graph) != expected_mst) {
       std::cout << "Failed!!!" << std::endl;
       std::cout << "The output is: (total cost = "
                 << mst.first << ")" << std::endl;
@@ -32,7 +35,56 @@ namespace graph_test {
       std::cout << "The correct result is: (total cost = "
                 << expected_mst.first << ")" << std::endl;
       graph_utilities::printContainer(expected_mst.second);
+      return;
+    }
+
+    // a larger random graph with many equal weights, which is
+    // partitioned several times
+    const size_t n = 2000;
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<size_t> vertex(0, n - 1);
+    std::uniform_int_distribution<int> weight(-50, 50);
+    UndirectedGraph<int> random_graph(n);
+    for (size_t v = 1; v < n; ++v) { random_graph.connect(v - 1, v, weight(generator)); }
+    for (size_t e = 0; e < 20*n; ++e) {
+      random_graph.connect(vertex(generator), vertex(generator), weight(generator));
+    }
+
+    mst = kruskal(random_graph);
+    for (size_t n_threads : {1, 3}) {
+      if (filterKruskal(random_graph, n_threads) != mst) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    // the parts are sorted once the partitions are too deep, e.g. after
+    // bad pivots
+    for (size_t depth_limit : {0, 1, 3}) {
+      std::vector<WeightedEdge<int>> limited_edges = edgeList(random_graph);
+      DisjointSet unions(n);
+      std::vector<std::pair<size_t, size_t>> limited_mst;
+      int cost = 0;
+      filterKruskalRecursion(limited_edges.begin(), limited_edges.end(), unions, limited_mst,
+                             cost, n, 1, depth_limit);
+      if (std::make_pair(cost, limited_mst) != mst) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    // parallel sort of several chunks
+    std::vector<WeightedEdge<int>> edges = edgeList(random_graph);
+    std::vector<WeightedEdge<int>> sorted_edges(edges);
+    std::sort(sorted_edges.begin(), sorted_edges.end());
+    graph_parallel::parallelSort(edges.begin(), edges.end(), 3);
+    for (size_t k = 0; k < edges.size(); ++k) {
+      if (edges[k] < sorted_edges[k] || sorted_edges[k] < edges[k]) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
     }
+    std::cout << "Passed!" << std::endl;
   }
 
 }
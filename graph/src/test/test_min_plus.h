@@ -0,0 +1,58 @@
+#ifndef GRAPH_TEST_MIN_PLUS_H
+#define GRAPH_TEST_MIN_PLUS_H
+
+#include <cassert>
+#include <limits>
+#include <vector>
+
+#include "unittest_graph.h"
+#include "../graph_algorithms/min_plus.h"
+#include "../graph_algorithms/floyd_warshall.h"
+
+
+namespace graph_test {
+
+  void testMinPlusShortestPath() {
+    std::cout << "\nTesting min-plus all-pair shortest path..." << std::endl;
+
+    // c = min(c, a * b) of two 2 x 2 matrices
+    const int kINF = std::numeric_limits<int>::max()/2;
+    std::vector<int> a = {0, 1, kINF, 0};
+    std::vector<int> b = {0, kINF, 2, 0};
+    std::vector<int> c = {5, 5, 5, 5};
+    minPlusProduct(a.data(), b.data(), c.data(), 2, 1, 1, kINF/2);
+    assert((c == std::vector<int>{0, 1, 2, 0}));
+
+    auto graph = graph_test::negativeWeightedGraph();
+    graph.disconnect(0, 1);
+    std::vector<int> costs = minPlusShortestPath(graph);
+    assert(costs[0*6 + 3] == 7 &&
+           costs[0*6 + 5] == -2 &&
+           costs[1*6 + 4] == -9 &&
+           costs[3*6 + 5] == -1 &&
+           costs[5*6 + 0] == kINF);
+
+    // tiles that do not divide V, one to several threads
+    const size_t n = 50;
+    DirectedGraph<int> random_graph = randomNegativeWeightedGraph(n, 4*n, 1);
+    std::vector<int> expected = floydWarshallBlocked(random_graph);
+    for (size_t block_size : {1, 7, 64}) {
+      for (size_t n_threads : {1, 3}) {
+        assert(minPlusShortestPath(random_graph, n_threads, block_size) == expected);
+      }
+    }
+
+    random_graph.connect(0, 1, -100);
+    random_graph.connect(1, 0, -100);
+    try {
+      minPlusShortestPath(random_graph, 2, 7);
+      std::cerr << "Failed to detect negative cycle!" << std::endl;
+      exit (EXIT_FAILURE);
+    } catch (const std::invalid_argument&) {
+      std::cout << "Passed!" << std::endl;
+    }
+  }
+
+}
+
+#endif //GRAPH_TEST_MIN_PLUS_H
@@ -0,0 +1,90 @@
+#ifndef GRAPH_TEST_NEXT_HOP_TABLE_H
+#define GRAPH_TEST_NEXT_HOP_TABLE_H
+
+#include <cassert>
+#include <cstdio>
+#include <deque>
+
+#include "unittest_graph.h"
+#include "../graph_algorithms/next_hop_table.h"
+#include "../graph_algorithms/floyd_warshall.h"
+#include "../graph_algorithms/johnson.h"
+
+
+namespace graph_test {
+
+  //
+  // check that every path in the table is made of graph edges and its
+  // total weight equals the smallest cost
+  //
+  template <class T>
+  bool checkNextHopPaths(const DirectedGraph<T>& graph,
+                         const NextHopTable& next_hops,
+                         const std::deque<std::deque<T>>& costs) {
+    const auto kINF = (T)(std::numeric_limits<T>::max()/2.0);
+
+    for (size_t i = 0; i < graph.size(); ++i) {
+      for (size_t j = 0; j < graph.size(); ++j) {
+        std::deque<size_t> path = reconstructPath(next_hops, i, j);
+        if (path.empty()) {
+          if (costs[i][j] != kINF) { return false; }
+          continue;
+        }
+        if (path.front() != i || path.back() != j) { return false; }
+
+        T weight = 0;
+        for (size_t k = 0; k + 1 < path.size(); ++k) {
+          graph::Edge<T>* current_edge = graph.getList(path[k]);
+          while (current_edge != nullptr && current_edge->dst != path[k + 1]) {
+            current_edge = current_edge->next;
+          }
+          if (current_edge == nullptr) { return false; }
+          weight += current_edge->weight;
+        }
+        if (weight != costs[i][j]) { return false; }
+      }
+    }
+
+    return true;
+  }
+
+  void testNextHopTable() {
+    std::cout << "\nTesting next-hop table..." << std::endl;
+
+    assert(NextHopTable::widthFor(254) == 1);
+    assert(NextHopTable::widthFor(255) == 2);
+    assert(NextHopTable::widthFor(1000) == 2);
+    assert(NextHopTable::widthFor(70000) == 4);
+
+    // vertex 0 cannot be reached from the others
+    auto graph = graph_test::negativeWeightedGraph();
+
+    NextHopTable fw_next_hops(graph.size());
+    std::vector<int> flat_costs = floydWarshallBlocked(graph, 2, 4, &fw_next_hops);
+    std::deque<std::deque<int>> fw_costs(graph.size());
+    for (size_t i = 0; i < graph.size(); ++i) {
+      fw_costs[i].assign(flat_costs.begin() + i*graph.size(),
+                         flat_costs.begin() + (i + 1)*graph.size());
+    }
+    assert(checkNextHopPaths(graph, fw_next_hops, fw_costs));
+    assert(reconstructPath(fw_next_hops, 0, 5) == std::deque<size_t>({0, 1, 3, 4, 5}));
+    assert(fw_next_hops.path(3, 0).empty());
+
+    // the next hops of Johnson's algorithm in a memory-mapped file
+    std::string path = "next_hop_test.bin";
+    {
+      NextHopTable js_next_hops(graph.size(), path);
+      auto js = johnson(graph, 2);
+      johnsonToFile(graph, "johnson_test.bin", 2, &js_next_hops);
+      assert(checkNextHopPaths(graph, js_next_hops, js.first));
+      assert(js.second == fw_next_hops.toDeque());
+    }
+    std::remove(path.c_str());
+    std::remove("johnson_test.bin");
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}  // namespace graph_test
+
+#endif //GRAPH_TEST_NEXT_HOP_TABLE_H
@@ -0,0 +1,174 @@
+#ifndef GRAPH_TEST_PARTITION_H
+#define GRAPH_TEST_PARTITION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../graph_generators.h"
+#include "../graph_shards.h"
+#include "../graph_algorithms/breath_first_search.h"
+#include "../graph_algorithms/partition.h"
+#include "../graph_algorithms/sharded_bfs.h"
+
+
+namespace graph_test {
+
+  // every vertex in a part, the sizes match and no part is over capacity
+  template <class T>
+  bool isBalancedPartition(const Graph<T>& graph, const GraphPartition& partition,
+                           size_t n_parts, double imbalance) {
+    if (partition.parts.size() != graph.size() || partition.sizes.size() != n_parts) {
+      return false;
+    }
+    std::vector<size_t> sizes(n_parts, 0);
+    for (auto part : partition.parts) {
+      if (part >= n_parts) { return false; }
+      ++sizes[part];
+    }
+    const size_t capacity = (size_t)std::ceil((1 + imbalance)*graph.size()/n_parts);
+    for (size_t p = 0; p < n_parts; ++p) {
+      if (sizes[p] != partition.sizes[p] || sizes[p] > capacity) { return false; }
+    }
+    return partition.edge_cut == countEdgeCut(graph, partition.parts);
+  }
+
+  void testPartition() {
+    std::cout << "\nTesting graph partition..." << std::endl;
+
+    std::uniform_int_distribution<int> weight(1, 10);
+    auto grid = graph_generator::toUndirectedGraph(graph_generator::grid(60, 60, weight, 1));
+    auto rmat = graph_generator::toDirectedGraph(
+        graph_generator::rmat(12, 30000, weight, 2, true));
+
+    // a random balanced partition of the grid cuts about (k - 1)/k of
+    // the edges, while 4 blocks of the grid cut only 2*60 of them
+    std::vector<uint32_t> random_parts(grid.size());
+    for (size_t v = 0; v < grid.size(); ++v) { random_parts[v] = (uint32_t)(v*7919%4); }
+    const size_t random_cut = countEdgeCut(grid, random_parts);
+
+    GraphPartition grid4 = labelPropagationPartition(grid, 4);
+    GraphPartition grid1 = labelPropagationPartition(grid, 1);
+    GraphPartition rmat5 = labelPropagationPartition(rmat, 5, 0.1);
+    if (!isBalancedPartition(grid, grid4, 4, 0.03) || !isBalancedPartition(grid, grid1, 1, 0.03) ||
+        !isBalancedPartition(rmat, rmat5, 5, 0.1) ||
+        grid1.edge_cut != 0 || grid4.edge_cut*10 > random_cut ||
+        random_cut < grid.countEdge()/2) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // the same seed gives the same partition
+    if (labelPropagationPartition(rmat, 5, 0.1).parts != rmat5.parts) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    bool caught = false;
+    try { labelPropagationPartition(grid, 0); } catch (const std::invalid_argument&) { caught = true; }
+    if (!caught) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+  void testShardedBfs() {
+    std::cout << "\nTesting sharded BFS..." << std::endl;
+
+    std::uniform_int_distribution<long> weight(1, 100);
+    auto geometric = graph_generator::toUndirectedGraph(
+        graph_generator::randomGeometric(3000, 0.03, weight, 3));
+    auto rmat = graph_generator::toDirectedGraph(
+        graph_generator::rmat(11, 12000, weight, 4, true));
+
+    // the shards keep every edge, with the ghosts mapped to their owners
+    GraphPartition partition = labelPropagationPartition(rmat, 3);
+    const std::string prefix = "sharded_bfs_test";
+    std::vector<std::string> paths = graph_shards::writeShards(rmat, partition, prefix);
+    size_t n_edges = 0;
+    for (size_t p = 0; p < paths.size(); ++p) {
+      GraphShard<long> shard = graph_shards::loadShard<long>(paths[p]);
+      GraphShard<long> owner = graph_shards::loadShard<long>(paths[(p + 1)%paths.size()]);
+      n_edges += shard.countEdge();
+      if (shard.part != p || shard.n_parts != 3 || shard.countOwned() != partition.sizes[p] ||
+          shard.offsets.back() != shard.countEdge()) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+      for (size_t g = 0; g < shard.countGhosts(); ++g) {
+        if (partition.parts[shard.ghosts[g]] != shard.ghost_owners[g] ||
+            (shard.ghost_owners[g] == owner.part &&
+             owner.owned[shard.ghost_owner_ids[g]] != shard.ghosts[g])) {
+          std::cout << "Failed!!!" << std::endl;
+          return;
+        }
+      }
+    }
+    if (n_edges != rmat.countEdge()) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // the same distances as the BFS on the whole graph, and the messages
+    // are counted
+    ShardedBfsStats stats;
+    for (size_t src : {0, 100, 2047}) {
+      if (shardedBfs<long>(paths, src, &stats) != bfsDistance(rmat, src) ||
+          stats.n_levels == 0) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+    for (auto& path : paths) { std::remove(path.c_str()); }
+
+    for (size_t n_parts : {1, 4}) {
+      paths = graph_shards::writeShards(geometric, labelPropagationPartition(geometric, n_parts),
+                                        prefix);
+      if (shardedBfs<long>(paths, 5, &stats) != bfsDistance(geometric, 5) ||
+          (n_parts == 1) != (stats.n_messages == 0) ||
+          stats.n_bytes != stats.n_messages*sizeof(uint32_t)) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+      for (auto& path : paths) { std::remove(path.c_str()); }
+    }
+
+    // a missing shard fails the search instead of blocking it
+    paths = graph_shards::writeShards(geometric, labelPropagationPartition(geometric, 2), prefix);
+    std::remove(paths[1].c_str());
+    bool caught = false;
+    try { shardedBfs<long>(paths, 0); } catch (const std::runtime_error&) { caught = true; }
+    std::remove(paths[0].c_str());
+    if (!caught) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // so does a process which throws after loading its shard, while the
+    // others wait for it at the barrier
+    paths = graph_shards::writeShards(geometric, labelPropagationPartition(geometric, 3), prefix);
+    graph_sharded::levelHook() = [](size_t part, size_t level) {
+      if (part == 1 && level == 2) { throw std::bad_alloc(); }
+    };
+    caught = false;
+    try { shardedBfs<long>(paths, 0); } catch (const std::runtime_error&) { caught = true; }
+    graph_sharded::levelHook() = nullptr;
+    bool recovered = shardedBfs<long>(paths, 0) == bfsDistance(geometric, 0);
+    for (auto& path : paths) { std::remove(path.c_str()); }
+    if (!caught || !recovered) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}  // namespace graph_test
+
+#endif //GRAPH_TEST_PARTITION_H
@@ -6,7 +6,12 @@
 #define GRAPH_TEST_PRIM_H
 
 
+#include <random>
+#include <stdexcept>
+
 #include "unittest_graph.h"
+#include "../graph_algorithms/kruskal.h"
+#include "../graph_algorithms/minimum_spanning_tree.h"
 #include "../graph_algorithms/prim.h"
 
 
@@ -17,15 +22,13 @@ namespace graph_test {
 
     auto graph = graph_test::negativeWeightedUdGraph();
 
-    typedef std::pair<double, std::vector<std::pair<size_t, size_t>>> mst_tree;
+    typedef std::pair<int, std::vector<std::pair<size_t, size_t>>> mst_tree;
 
     size_t src = 0;
     mst_tree mst = prim(graph, src);
     mst_tree expected_mst = {-13, {{0, 4}, {4, 3}, {3, 1}, {4, 2}, {4, 5}}};
 
-    if (mst == expected_mst) {
-      std::cout << "Passed!" << std::endl;
-    } else {
+    if (mst != expected_mst || prim_dense(graph, src) != expected_mst) {
       std::cout << "Failed!!!" << std::endl;
       std::cout << "The output is: (total cost = "
                 << mst.first << ")" << std::endl;
@@ -33,7 +36,57 @@ namespace graph_test {
       std::cout << "The correct result is: (total cost = "
                 << expected_mst.first << ")" << std::endl;
       graph_utilities::printContainer(expected_mst.second);
+      return;
+    }
+
+    // the cost of a random graph from sparse to complete, where the
+    // front end picks either Prim
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> weight(-100, 100);
+    for (size_t n_edges : {200, 2000, 20000}) {
+      const size_t n = 200;
+      std::uniform_int_distribution<size_t> vertex(0, n - 1);
+      UndirectedGraph<int> random_graph(n);
+      for (size_t v = 1; v < n; ++v) { random_graph.connect(v - 1, v, weight(generator)); }
+      for (size_t e = 0; e < n_edges; ++e) {
+        random_graph.connect(vertex(generator), vertex(generator), weight(generator));
+      }
+
+      int expected_cost = kruskal(random_graph).first;
+      for (size_t root : {(size_t)0, n/2}) {
+        if (prim(random_graph, root).first != expected_cost ||
+            prim_dense(random_graph, root).first != expected_cost) {
+          std::cout << "Failed!!!" << std::endl;
+          return;
+        }
+      }
+      if (minimumSpanningTree(random_graph).first != expected_cost) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    // an empty graph has an empty tree, whichever algorithm is picked
+    UndirectedGraph<int> empty(0);
+    if (minimumSpanningTree(empty) != mst_tree {0, {}} || kruskal(empty) != mst_tree {0, {}} ||
+        filterKruskal(empty) != mst_tree {0, {}}) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
     }
+
+    // two components
+    UndirectedGraph<int> disconnected(4);
+    disconnected.connect(0, 1, 1);
+    disconnected.connect(2, 3, 1);
+    for (bool dense : {false, true}) {
+      try {
+        dense ? prim_dense(disconnected, 0) : prim(disconnected, 0);
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      } catch (std::invalid_argument&) {}
+    }
+
+    std::cout << "Passed!" << std::endl;
   }
 
 } // namespace graph_test
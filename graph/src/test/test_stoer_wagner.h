@@ -0,0 +1,103 @@
+#ifndef GRAPH_TEST_STOER_WAGNER_H
+#define GRAPH_TEST_STOER_WAGNER_H
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "unittest_graph.h"
+#include "../graph_algorithms/stoer_wagner.h"
+
+
+namespace graph_test {
+
+  void testStoerWagner() {
+    std::cout << "\nTesting Stoer-Wagner's algorithm..." << std::endl;
+
+    auto graph = graph_test::simpleUdGraph();
+    auto min_cut = stoerWagner(graph);
+    if (min_cut.first != 2 ||
+        (min_cut.second != std::vector<size_t>({0, 1, 2, 3}) &&
+         min_cut.second != std::vector<size_t>({4, 5, 6, 7}))) {
+      std::cout << "Failed!!!" << std::endl;
+      std::cout << "The output is " << min_cut.first << std::endl;
+      graph_utilities::printContainer(min_cut.second);
+      std::cout << "The correct result is 2" << std::endl;
+      return;
+    }
+
+    // the example in the paper of Stoer and Wagner
+    UndirectedGraph<int> paper_graph(8);
+    paper_graph.connect(0, 1, 2);
+    paper_graph.connect(0, 4, 3);
+    paper_graph.connect(1, 2, 3);
+    paper_graph.connect(1, 4, 2);
+    paper_graph.connect(1, 5, 2);
+    paper_graph.connect(2, 3, 4);
+    paper_graph.connect(2, 6, 2);
+    paper_graph.connect(3, 6, 2);
+    paper_graph.connect(3, 7, 2);
+    paper_graph.connect(4, 5, 3);
+    paper_graph.connect(5, 6, 1);
+    paper_graph.connect(6, 7, 3);
+    auto paper_cut = stoerWagner(paper_graph);
+    if (paper_cut.first != 4 ||
+        (paper_cut.second != std::vector<size_t>({2, 3, 6, 7}) &&
+         paper_cut.second != std::vector<size_t>({0, 1, 4, 5}))) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // random weighted graphs (some disconnected) against trying each
+    // partition
+    std::mt19937 generator(0);
+    std::uniform_int_distribution<int> weight(0, 9);
+    for (size_t trial = 0; trial < 50; ++trial) {
+      const size_t n = 2 + trial%10;
+      std::uniform_int_distribution<size_t> vertex(0, n - 1);
+      UndirectedGraph<int> random_graph(n);
+      for (size_t e = 0; e < 2*n; ++e) {
+        random_graph.connect(vertex(generator), vertex(generator), weight(generator));
+      }
+
+      std::vector<std::vector<int>> weights(n, std::vector<int>(n));
+      for (size_t u = 0; u < n; ++u) {
+        graph::Edge<int>* current_edge = random_graph.getList(u);
+        while (current_edge != nullptr) {
+          weights[u][current_edge->dst] = current_edge->weight;
+          current_edge = current_edge->next;
+        }
+      }
+      auto cutWeight = [&](const std::vector<bool>& in_side) {
+        int cut = 0;
+        for (size_t u = 0; u < n; ++u) {
+          for (size_t v = u + 1; v < n; ++v) {
+            if (in_side[u] != in_side[v]) { cut += weights[u][v]; }
+          }
+        }
+        return cut;
+      };
+
+      int expected = std::numeric_limits<int>::max();
+      for (size_t mask = 1; mask + 1 < (1u << n); ++mask) {
+        std::vector<bool> in_side(n);
+        for (size_t v = 0; v < n; ++v) { in_side[v] = (mask >> v) & 1u; }
+        expected = std::min(expected, cutWeight(in_side));
+      }
+
+      auto cut = stoerWagner(random_graph);
+      std::vector<bool> in_side(n);
+      for (auto v : cut.second) { in_side[v] = true; }
+      if (cut.first != expected || cut.second.empty() || cut.second.size() == n ||
+          cutWeight(in_side) != expected) {
+        std::cout << "Failed!!!" << std::endl;
+        return;
+      }
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+} // namespace graph_test
+
+#endif //GRAPH_TEST_STOER_WAGNER_H
@@ -0,0 +1,99 @@
+#ifndef GRAPH_TEST_VERSIONED_GRAPH_H
+#define GRAPH_TEST_VERSIONED_GRAPH_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "unittest_graph.h"
+#include "../versioned_graph.h"
+#include "../graph_algorithms/breath_first_search.h"
+#include "../graph_algorithms/dijkstra.h"
+
+
+namespace graph_test {
+
+  void testVersionedGraph() {
+    std::cout << "\nTesting versioned graph..." << std::endl;
+
+    // a snapshot keeps its version while the writer publishes
+    VersionedGraph<int> graph(graph_test::negativeWeightedUdGraph());
+    auto old_snapshot = graph.snapshot();
+    graph.disconnect(0, 4);
+    graph.connect(0, 5, 7);
+    if (graph.snapshot().graph().countEdge() != 10 || graph.version() != 0) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+    graph.publish();
+
+    auto new_snapshot = graph.snapshot();
+    if (graph.version() != 1 || old_snapshot.graph().number() != 0 ||
+        old_snapshot.graph().countWeight() != 2 ||
+        new_snapshot.graph().countWeight() != 2 + 4 + 7 ||
+        new_snapshot.graph().getList(1) != old_snapshot.graph().getList(1)) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // the old version is freed once its snapshot is gone
+    {
+      auto moved(std::move(old_snapshot));
+    }
+    graph.reclaim();
+    if (graph.countRetired() != 0) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    // a ring whose weights are moved around by the writer, so the total
+    // weight and the No. of edges of every version are the same
+    const size_t n = 200;
+    const size_t n_readers = 3;
+    DirectedGraph<long> ring(n);
+    for (size_t v = 0; v < n; ++v) { ring.connect(v, (v + 1)%n, 10); }
+    VersionedGraph<long> versioned(ring);
+
+    std::atomic<bool> done(false);
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < n_readers; ++r) {
+      readers.emplace_back([&]() {
+        while (!done) {
+          auto snapshot = versioned.snapshot();
+          const Graph<long>& g = snapshot.graph();
+          if (g.countEdge() != n || g.countWeight() != 10*(long)n ||
+              breathFirstSearch(g, 0).size() != n ||
+              dijkstra(g, 0).second.size() != n) {
+            failed = true;
+          }
+        }
+      });
+    }
+
+    for (size_t batch = 0; batch < 300; ++batch) {
+      size_t u = batch%n;
+      size_t v = (u + 1)%n;
+      size_t w = (v + 1)%n;
+      long moved = 1 + batch%5;
+      long weight_uv = versioned.disconnect(u, v);
+      long weight_vw = versioned.disconnect(v, w);
+      versioned.connect(u, v, weight_uv - moved);
+      versioned.connect(v, w, weight_vw + moved);
+      versioned.publish();
+    }
+    done = true;
+    for (auto& t : readers) { t.join(); }
+    versioned.reclaim();
+
+    if (failed || versioned.version() != 300 || versioned.countRetired() != 0) {
+      std::cout << "Failed!!!" << std::endl;
+      return;
+    }
+
+    std::cout << "Passed!" << std::endl;
+  }
+
+}  // namespace graph_test
+
+#endif //GRAPH_TEST_VERSIONED_GRAPH_H
@@ -7,7 +7,9 @@
 #define GRAPH_UNITTEST_GRAPH_H
 
 #include <cassert>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "../directed_graph.h"
 #include "../undirected_graph.h"
@@ -237,6 +239,37 @@ namespace graph_test {
     return graph;
   }
 
+  //
+  // a random directed graph with negative weights but no negative cycle
+  //
+  // The weight of (u, v) is w + p[v] - p[u] for a random non-negative w
+  // and random vertex potentials p, so the weight of a cycle is the sum
+  // of the non-negative w's.
+  //
+  // @param n: No. of vertices
+  // @param n_edges: No. of random edges tried, where the loops and the
+  //                 duplicates are dropped, so the graph may have fewer
+  // @param seed: seed of the random number generator
+  // @param return: a directed graph
+  //
+  DirectedGraph<int> randomNegativeWeightedGraph(size_t n, size_t n_edges,
+                                                 unsigned seed=0) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> weight(0, 20);
+    std::vector<int> potentials(n);
+    for (auto& p : potentials) { p = weight(generator); }
+
+    DirectedGraph<int> graph(n);
+    std::uniform_int_distribution<size_t> vertex(0, n - 1);
+    for (size_t e = 0; e < n_edges; ++e) {
+      size_t src = vertex(generator);
+      size_t dst = vertex(generator);
+      graph.connect(src, dst, weight(generator) + potentials[dst] - potentials[src]);
+    }
+
+    return graph;
+  }
+
   //
   // test the copy constructor
   //
@@ -67,6 +67,13 @@ public:
     return weight1;
   }
 
+  // connect two vertices which are known not to be connected, in O(1)
+  // time, e.g. to load the edges of a generated graph
+  void connectNew(size_t src, size_t dst, T weight) {
+    this->prependEdge(src, dst, weight);
+    this->prependEdge(dst, src, weight);
+  }
+
   //void UdGraph::collapse(int src, int dst) {
 //  if ( src == dst ) { return; }
 //
@@ -0,0 +1,405 @@
+//
+// A graph which is read by many threads while a writer updates it, in
+// which the readers never block and never see a partial update.
+//
+
+#ifndef GRAPH_VERSIONED_GRAPH_H
+#define GRAPH_VERSIONED_GRAPH_H
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "directed_graph.h"
+#include "undirected_graph.h"
+
+
+template <class T> class VersionedGraph;
+
+//
+// An immutable version of a VersionedGraph
+//
+// It is a Graph, so all the algorithms run on it, but the linked lists
+// are shared with the other versions and are not owned by it.
+//
+template <class T>
+class GraphVersion : public Graph<T> {
+  friend class VersionedGraph<T>;
+
+protected:
+  using Graph<T>::vertices_;
+
+public:
+  GraphVersion(size_t size, bool undirected)
+      : Graph<T>(size), undirected_(undirected), number_(0) {}
+
+  GraphVersion(const GraphVersion&) = delete;
+  GraphVersion& operator=(const GraphVersion&) = delete;
+
+  // the lists are freed by the VersionedGraph
+  ~GraphVersion() override {
+    for (auto& v : vertices_) { v = nullptr; }
+  }
+
+  // get No. of the version, which starts at 0 and increases by 1 per
+  // publish
+  uint64_t number() const { return number_; }
+
+  bool undirected() const { return undirected_; }
+
+  size_t countEdge() const override {
+    size_t count = 0;
+    for (const auto& v : vertices_) {
+      for (graph::Edge<T>* e = v; e != nullptr; e = e->next) { ++count; }
+    }
+    return undirected_ ? count/2 : count;
+  }
+
+  T countWeight() const override {
+    T sum = 0;
+    for (const auto& v : vertices_) {
+      for (graph::Edge<T>* e = v; e != nullptr; e = e->next) { sum += e->weight; }
+    }
+    return undirected_ ? sum/2 : sum;
+  }
+
+  bool connect(size_t, size_t) override { throw readOnly(); }
+  bool connect(size_t, size_t, T) override { throw readOnly(); }
+  T disconnect(size_t, size_t) override { throw readOnly(); }
+
+private:
+  bool undirected_;
+  uint64_t number_;
+
+  static std::invalid_argument readOnly() {
+    return std::invalid_argument("Invalid operation: a graph version is read-only");
+  }
+};
+
+/**
+ * Graph with snapshot isolation between one writer and many readers.
+ *
+ * The writer stages connect() and disconnect() calls into a private
+ * version, in which a vertex's linked list is copied the first time it
+ * changes (copy-on-write per vertex) while the other lists are shared
+ * with the current version. publish() then swaps the current version
+ * with one atomic store.
+ *
+ * A reader takes a Snapshot, which pins the current version until it
+ * is destroyed, and runs any algorithm on snapshot.graph(). Readers
+ * never lock and never wait for the writer.
+ *
+ * The replaced versions and lists are freed by epoch-based
+ * reclamation: a snapshot announces the global epoch in a reader slot
+ * when it is taken, and whatever is retired at epoch e is freed once
+ * every active snapshot has announced an epoch after e.
+ *
+ * The writer side (connect(), disconnect(), publish()) must be called
+ * from one thread at a time; snapshots can be taken from any No. of
+ * threads up to the No. of reader slots.
+ */
+template <class T>
+class VersionedGraph {
+private:
+  static const uint64_t kInactive = 0;
+
+  // epoch announced by a snapshot, on its own cache line so that
+  // readers do not slow each other down
+  struct alignas(64) ReaderSlot {
+    std::atomic<bool> claimed;
+    std::atomic<uint64_t> epoch;
+
+    ReaderSlot() : claimed(false), epoch(kInactive) {}
+  };
+  static_assert(sizeof(ReaderSlot) % 64 == 0, "a reader slot must fill whole cache lines");
+
+public:
+  //
+  // A pinned version, which stays valid until the snapshot is destroyed
+  //
+  class Snapshot {
+  public:
+    Snapshot(Snapshot&& other) noexcept
+        : slot_(other.slot_), version_(other.version_) {
+      other.slot_ = nullptr;
+      other.version_ = nullptr;
+    }
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    Snapshot& operator=(Snapshot&&) = delete;
+
+    ~Snapshot() {
+      if (slot_ != nullptr) {
+        slot_->epoch.store(kInactive);
+        slot_->claimed.store(false, std::memory_order_release);
+      }
+    }
+
+    const GraphVersion<T>& graph() const { return *version_; }
+
+  private:
+    friend class VersionedGraph<T>;
+
+    Snapshot(ReaderSlot* slot, const GraphVersion<T>* version)
+        : slot_(slot), version_(version) {}
+
+    ReaderSlot* slot_;
+    const GraphVersion<T>* version_;
+  };
+
+  /**
+   * constructor
+   *
+   * @param size: No. of vertices
+   * @param undirected: whether connect() and disconnect() change both
+   *                    directions
+   * @param n_reader_slots: max No. of snapshots alive at the same time
+   */
+  explicit VersionedGraph(size_t size, bool undirected=false, size_t n_reader_slots=64)
+      : slot_buffer_(new char[n_reader_slots*sizeof(ReaderSlot) + alignof(ReaderSlot) - 1]),
+        slots_(nullptr), n_slots_(n_reader_slots),
+        current_(new GraphVersion<T>(size, undirected)), global_epoch_(1), staged_(nullptr) {
+    void* buffer = slot_buffer_.get();
+    size_t space = n_reader_slots*sizeof(ReaderSlot) + alignof(ReaderSlot) - 1;
+    buffer = std::align(alignof(ReaderSlot), n_reader_slots*sizeof(ReaderSlot), buffer, space);
+    slots_ = static_cast<ReaderSlot*>(buffer);
+    for (size_t i = 0; i < n_slots_; ++i) { new (slots_ + i) ReaderSlot(); }
+  }
+
+  // start with a copy of a graph
+  explicit VersionedGraph(const DirectedGraph<T>& graph, size_t n_reader_slots=64)
+      : VersionedGraph(graph.size(), false, n_reader_slots) {
+    copyLists(graph);
+  }
+
+  explicit VersionedGraph(const UndirectedGraph<T>& graph, size_t n_reader_slots=64)
+      : VersionedGraph(graph.size(), true, n_reader_slots) {
+    copyLists(graph);
+  }
+
+  VersionedGraph(const VersionedGraph&) = delete;
+  VersionedGraph& operator=(const VersionedGraph&) = delete;
+
+  // no snapshot may be alive
+  ~VersionedGraph() {
+    abort();
+    GraphVersion<T>* current = current_.load();
+    for (size_t v = 0; v < current->size(); ++v) { freeList(current->vertices_[v]); }
+    delete current;
+    for (auto& r : retired_) { freeRetired(r); }
+  }
+
+  // get No. of vertices
+  size_t size() const { return current_.load()->size(); }
+
+  /**
+   * Pin the current version
+   *
+   * @throw: std::out_of_range if all the reader slots are taken
+   */
+  Snapshot snapshot() {
+    for (size_t i = 0; i < n_slots_; ++i) {
+      ReaderSlot& slot = slots_[i];
+      bool claimed = false;
+      if (!slot.claimed.load(std::memory_order_relaxed) &&
+          slot.claimed.compare_exchange_strong(claimed, true, std::memory_order_acquire)) {
+        // announce the epoch before loading the version, so the writer
+        // either sees the announcement or has published a newer version
+        // which this load sees (both are sequentially consistent)
+        slot.epoch.store(global_epoch_.load());
+        return Snapshot(&slot, current_.load());
+      }
+    }
+    throw std::out_of_range("Out of range: no free reader slot");
+  }
+
+  // get No. of the current version
+  uint64_t version() const { return current_.load()->number(); }
+
+  /**
+   * Stage an edge (both directions for an undirected graph)
+   *
+   * @return: true if the edge(s) are added to the staged version
+   */
+  bool connect(size_t src, size_t dst, T weight=1) {
+    GraphVersion<T>* staged = stage();
+    copyOnWrite(src);
+    if (!staged->addEdge(src, dst, weight)) { return false; }
+    if (staged->undirected()) {
+      copyOnWrite(dst);
+      staged->addEdge(dst, src, weight);
+    }
+    return true;
+  }
+
+  /**
+   * Stage the removal of an edge (both directions for an undirected
+   * graph)
+   *
+   * @return: weight of the removed edge (0 if it does not exist)
+   */
+  T disconnect(size_t src, size_t dst) {
+    GraphVersion<T>* staged = stage();
+    copyOnWrite(src);
+    T weight = staged->delEdge(src, dst);
+    if (staged->undirected()) {
+      copyOnWrite(dst);
+      staged->delEdge(dst, src);
+    }
+    return weight;
+  }
+
+  /**
+   * Make the staged changes visible to the new snapshots at once, and
+   * free the versions which no snapshot can see any more
+   *
+   * @return: No. of the published version
+   */
+  uint64_t publish() {
+    if (staged_ == nullptr) { return version(); }
+
+    GraphVersion<T>* old = current_.load();
+    staged_->number_ = old->number_ + 1;
+    current_.store(staged_);
+
+    // snapshots which announce a later epoch see the new version
+    Retired retired;
+    retired.epoch = global_epoch_.fetch_add(1);
+    retired.version = old;
+    for (size_t v : copied_vertices_) { retired.lists.push_back(old->vertices_[v]); }
+    retired_.push_back(std::move(retired));
+
+    staged_ = nullptr;
+    for (size_t v : copied_vertices_) { copied_[v] = false; }
+    copied_vertices_.clear();
+
+    reclaim();
+    return version();
+  }
+
+  // drop the staged changes
+  void abort() {
+    if (staged_ == nullptr) { return; }
+    for (size_t v : copied_vertices_) {
+      freeList(staged_->vertices_[v]);
+      copied_[v] = false;
+    }
+    copied_vertices_.clear();
+    delete staged_;
+    staged_ = nullptr;
+  }
+
+  // get No. of retired versions which are not freed yet
+  size_t countRetired() const { return retired_.size(); }
+
+  /**
+   * Free the retired versions which no snapshot can see any more
+   *
+   * It is called by publish(), and can be called again after the old
+   * snapshots are gone.
+   */
+  void reclaim() {
+    uint64_t oldest = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < n_slots_; ++i) {
+      uint64_t epoch = slots_[i].epoch.load();
+      if (epoch != kInactive) { oldest = std::min(oldest, epoch); }
+    }
+
+    size_t n_kept = 0;
+    for (size_t i = 0; i < retired_.size(); ++i) {
+      if (retired_[i].epoch < oldest) {
+        freeRetired(retired_[i]);
+      } else {
+        if (n_kept != i) { retired_[n_kept] = std::move(retired_[i]); }
+        ++n_kept;
+      }
+    }
+    retired_.resize(n_kept);
+  }
+
+private:
+  // a version and the lists it does not share with the next version
+  struct Retired {
+    uint64_t epoch;
+    GraphVersion<T>* version;
+    std::vector<graph::Edge<T>*> lists;
+  };
+
+  // the slots in a buffer aligned by hand, since std::vector does not
+  // over-align its elements before C++17 (the atomics need no destructor)
+  std::unique_ptr<char[]> slot_buffer_;
+  ReaderSlot* slots_;
+  size_t n_slots_;
+  std::atomic<GraphVersion<T>*> current_;
+  std::atomic<uint64_t> global_epoch_;
+
+  // writer side
+  GraphVersion<T>* staged_;
+  std::vector<bool> copied_;  // whether a list of staged_ is a private copy
+  std::vector<size_t> copied_vertices_;
+  std::vector<Retired> retired_;
+
+  static void freeList(graph::Edge<T>* head) {
+    while (head != nullptr) {
+      graph::Edge<T>* next = head->next;
+      delete head;
+      head = next;
+    }
+  }
+
+  static graph::Edge<T>* copyList(const graph::Edge<T>* head) {
+    graph::Edge<T>* copy = nullptr;
+    graph::Edge<T>** link = &copy;
+    for ( ; head != nullptr; head = head->next) {
+      *link = new graph::Edge<T>(*head);
+      link = &(*link)->next;
+    }
+    *link = nullptr;
+    return copy;
+  }
+
+  static void freeRetired(Retired& retired) {
+    for (auto head : retired.lists) { freeList(head); }
+    delete retired.version;
+    retired.version = nullptr;
+    retired.lists.clear();
+  }
+
+  // the version which collects the changes until publish()
+  GraphVersion<T>* stage() {
+    if (staged_ == nullptr) {
+      const GraphVersion<T>* current = current_.load();
+      staged_ = new GraphVersion<T>(current->size(), current->undirected());
+      staged_->vertices_ = current->vertices_;
+      copied_.assign(current->size(), false);
+    }
+    return staged_;
+  }
+
+  void copyOnWrite(size_t v) {
+    if (v >= staged_->size()) { throw std::out_of_range("Out of range: vertex"); }
+    if (copied_[v]) { return; }
+    staged_->vertices_[v] = copyList(staged_->vertices_[v]);
+    copied_[v] = true;
+    copied_vertices_.push_back(v);
+  }
+
+  void copyLists(const Graph<T>& graph) {
+    GraphVersion<T>* current = current_.load();
+    for (size_t v = 0; v < graph.size(); ++v) {
+      current->vertices_[v] = copyList(graph.getList(v));
+    }
+  }
+};
+
+template <class T>
+const uint64_t VersionedGraph<T>::kInactive;
+
+
+#endif //GRAPH_VERSIONED_GRAPH_H